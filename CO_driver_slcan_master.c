@@ -117,6 +117,11 @@ CO_CANmodule_init(CO_CANmodule_t* CANmodule, void* CANptr, CO_CANrx_t rxArray[],
     CANmodule->firstCANtxMessage = true;
     CANmodule->CANtxCount = 0U;
     CANmodule->errOld = 0U;
+    CANmodule->listenOnly = false;
+    CANmodule->rxTapObject = NULL;
+    CANmodule->pCANrxTap = NULL;
+    CANmodule->txTapObject = NULL;
+    CANmodule->pCANtxTap = NULL;
 
     for (i = 0U; i < rxSize; i++) {
         rxArray[i].ident = 0U;
@@ -211,6 +216,41 @@ CO_CANmodule_init(CO_CANmodule_t* CANmodule, void* CANptr, CO_CANrx_t rxArray[],
     return CO_ERROR_NO;
 }
 
+void
+CO_CANsetRxTap(CO_CANmodule_t* CANmodule, void* object,
+               void (*CANrxTap)(void* object, const CO_CANrxMsg_t* message)) {
+    if (CANmodule == NULL) return;
+
+    CANmodule->rxTapObject = object;
+    CANmodule->pCANrxTap = CANrxTap;
+}
+
+void
+CO_CANsetTxTap(CO_CANmodule_t* CANmodule, void* object,
+               void (*CANtxTap)(void* object, const CO_CANtx_t* message)) {
+    if (CANmodule == NULL) return;
+
+    CANmodule->txTapObject = object;
+    CANmodule->pCANtxTap = CANtxTap;
+}
+
+void
+CO_CANsetListenOnly(CO_CANmodule_t* CANmodule, bool_t listenOnly) {
+    if (CANmodule == NULL) return;
+
+    CO_LOCK_CAN_SEND(CANmodule);
+    CANmodule->listenOnly = listenOnly;
+    /* drop pending messages */
+    if (listenOnly && CANmodule->CANtxCount != 0U) {
+        uint16_t i;
+        for (i = 0U; i < CANmodule->txSize; i++) {
+            CANmodule->txArray[i].bufferFull = false;
+        }
+        CANmodule->CANtxCount = 0U;
+    }
+    CO_UNLOCK_CAN_SEND(CANmodule);
+}
+
 void
 CO_CANmodule_disable(CO_CANmodule_t* CANmodule) {
     if (CANmodule != NULL) {
@@ -291,6 +331,11 @@ static bool can_send_msg(CO_CANmodule_t* CANmodule, CO_CANtx_t* buffer)
     slcan_err_t err = slcan_master_send_can_msg(master, &can_msg, NULL);
     if(err != E_SLCAN_NO_ERROR) return false;
 
+    /* Pass message to the tap */
+    if (CANmodule->pCANtxTap != NULL) {
+        CANmodule->pCANtxTap(CANmodule->txTapObject, buffer);
+    }
+
     return true;
 }
 
@@ -331,6 +376,11 @@ CO_ReturnError_t
 CO_CANsend(CO_CANmodule_t* CANmodule, CO_CANtx_t* buffer) {
     CO_ReturnError_t err = CO_ERROR_NO;
 
+    /* Listen only, message is dropped */
+    if (CANmodule->listenOnly) {
+        return err;
+    }
+
     /* Verify overflow */
     if (buffer->bufferFull) {
         if (!CANmodule->firstCANtxMessage) {
@@ -459,6 +509,12 @@ CO_CANinterrupt(CO_CANmodule_t* CANmodule) {
 
         rcvMsg = &rcvMsgData; /* get message from module here */
         rcvMsgIdent = rcvMsg->ident;
+
+        /* Pass message to the tap */
+        if (CANmodule->pCANrxTap != NULL) {
+            CANmodule->pCANrxTap(CANmodule->rxTapObject, rcvMsg);
+        }
+
         if (CANmodule->useCANrxFilters) {
             /* CAN module filters are used. Message with known 11-bit identifier has been received */
             index = 0; /* get index of the received message here. Or something similar */
@@ -38,8 +38,9 @@ extern "C" {
 // Disable LSS.
 #define CO_CONFIG_LSS 0
 
-// Disable HB consumer.
-#define CO_CONFIG_HB_CONS 0
+// HB consumer, node states are queried after processing.
+#define CO_CONFIG_HB_CONS (CO_CONFIG_HB_CONS_ENABLE |\
+                           CO_CONFIG_HB_CONS_QUERY_FUNCT)
 
 // HB config.
 #define FIRST_HB_TIME_MS 0
@@ -50,11 +51,17 @@ extern "C" {
 // Disable TIME prod/cons.
 #define CO_CONFIG_TIME 0
 
-// Disable SYNC.
-#define CO_CONFIG_SYNC 0
+// SYNC producer & consumer (synchronous PDOs).
+#define CO_CONFIG_SYNC (CO_CONFIG_SYNC_ENABLE |\
+                        CO_CONFIG_SYNC_PRODUCER)
 
-// Disable PDO.
-#define CO_CONFIG_PDO 0
+// TPDO setpoints, RPDO live values.
+// OD IO access - RPDO mapped objects are written via OD extension.
+#define CO_CONFIG_PDO (CO_CONFIG_RPDO_ENABLE |\
+                       CO_CONFIG_TPDO_ENABLE |\
+                       CO_CONFIG_TPDO_TIMERS_ENABLE |\
+                       CO_CONFIG_PDO_SYNC_ENABLE |\
+                       CO_CONFIG_PDO_OD_IO_ACCESS)
 
 // Enable SDO server.
 #define CO_CONFIG_SDO_SRV 0
@@ -282,8 +289,35 @@ typedef struct {
     volatile uint16_t
         CANtxCount;  /**< Number of messages in transmit buffer, which are waiting to be copied to the CAN module */
     uint32_t errOld; /**< Previous state of CAN errors */
+    volatile bool_t listenOnly; /**< Transmitted messages are dropped, from CO_CANsetListenOnly() */
+    void* rxTapObject; /**< Object for the pCANrxTap(), from CO_CANsetRxTap() */
+    void (*pCANrxTap)(void* object, const CO_CANrxMsg_t* message); /**< Called for every received message before
+                                                                        dispatching, from CO_CANsetRxTap() */
+    void* txTapObject; /**< Object for the pCANtxTap(), from CO_CANsetTxTap() */
+    void (*pCANtxTap)(void* object, const CO_CANtx_t* message); /**< Called for every message sent to the adapter,
+                                                                     from CO_CANsetTxTap() */
 } CO_CANmodule_t;
 
+/**
+ * Set receive tap. Tap is called for every received CAN message, matched or not.
+ * Must be called after CO_CANmodule_init().
+ */
+void CO_CANsetRxTap(CO_CANmodule_t* CANmodule, void* object,
+                    void (*CANrxTap)(void* object, const CO_CANrxMsg_t* message));
+
+/**
+ * Set transmit tap. Tap is called for every message sent to the adapter.
+ * Must be called after CO_CANmodule_init().
+ */
+void CO_CANsetTxTap(CO_CANmodule_t* CANmodule, void* object,
+                    void (*CANtxTap)(void* object, const CO_CANtx_t* message));
+
+/**
+ * Set listen only mode. Messages are not sent to the bus, pending ones are dropped.
+ * Must be called after CO_CANmodule_init().
+ */
+void CO_CANsetListenOnly(CO_CANmodule_t* CANmodule, bool_t listenOnly);
+
 
 /*
  * Main events handler.
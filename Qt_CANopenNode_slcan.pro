@@ -36,13 +36,25 @@ SOURCES += \
     CANopenNode/301/crc16-ccitt.c \
     CANopenNode/CANopen.c \
     CO_driver_slcan_master.c \
+    bitfieldeditdlg.cpp \
+    canbusstats.cpp \
+    canbusstatsdlg.cpp \
+    cantracebuffer.cpp \
+    cantracedlg.cpp \
+    cantracemodel.cpp \
     cockpitserializer.cpp \
     coobjectdict.cpp \
+    copdomapper.cpp \
+    covaluedemand.cpp \
     covaluesholder.cpp \
+    covaluessnapshot.cpp \
     covaluetypes.cpp \
     main.cpp \
     canopenwin.cpp \
+    pollbudget.cpp \
+    sdocache.cpp \
     sdocomm.cpp \
+    sdoobserver.cpp \
     sdovalue.cpp \
     sdovaluebar.cpp \
     sdovaluebareditdlg.cpp \
@@ -55,6 +67,7 @@ SOURCES += \
     sdovalueplot.cpp \
     sdovalueslider.cpp \
     sdovalueslidereditdlg.cpp \
+    sdowritecoalescer.cpp \
     sequentialbuffer.cpp \
     settings.cpp \
     settingsdlg.cpp \
@@ -94,14 +107,27 @@ HEADERS += \
     CANopenNode/301/crc16-ccitt.h \
     CANopenNode/CANopen.h \
     CO_driver_target.h \
+    bitfieldeditdlg.h \
     canopenwin.h \
+    canbusstats.h \
+    canbusstatsdlg.h \
+    cantracebuffer.h \
+    cantracedlg.h \
+    cantracemodel.h \
     cockpitserializer.h \
     coobjectdict.h \
+    copdomapper.h \
     cotypes.h \
+    covaluedemand.h \
     covaluesholder.h \
+    covaluessnapshot.h \
+    covaluestable.h \
     covaluetypes.h \
+    pollbudget.h \
+    sdocache.h \
     sdocomm.h \
     sdocomm_data.h \
+    sdoobserver.h \
     sdovalue.h \
     sdovaluebar.h \
     sdovaluebareditdlg.h \
@@ -114,6 +140,7 @@ HEADERS += \
     sdovalueplot.h \
     sdovalueslider.h \
     sdovalueslidereditdlg.h \
+    sdowritecoalescer.h \
     sequentialbuffer.h \
     settings.h \
     settingsdlg.h \
@@ -147,7 +174,10 @@ HEADERS += \
     trendploteditdlg.h
 
 FORMS += \
+    bitfieldeditdlg.ui \
     canopenwin.ui \
+    canbusstatsdlg.ui \
+    cantracedlg.ui \
     sdovaluebareditdlg.ui \
     sdovaluebuttoneditdlg.ui \
     sdovaluedialeditdlg.ui \
@@ -0,0 +1,77 @@
+#include "bitfieldeditdlg.h"
+#include "ui_bitfieldeditdlg.h"
+
+
+
+BitFieldEditDlg::BitFieldEditDlg(QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::BitFieldEditDlg)
+{
+    ui->setupUi(this);
+
+    ui->cbWordSize->addItem(tr("U8"), 1);
+    ui->cbWordSize->addItem(tr("U16"), 2);
+    ui->cbWordSize->addItem(tr("U32"), 4);
+
+    updateLimits();
+}
+
+BitFieldEditDlg::~BitFieldEditDlg()
+{
+    delete ui;
+}
+
+COValue::Type BitFieldEditDlg::type() const
+{
+    return COValue::bitField(wordSize(), ui->sbOffset->value(), ui->sbWidth->value());
+}
+
+void BitFieldEditDlg::setType(COValue::Type newType)
+{
+    size_t size = COValue::typeSize(newType);
+    int offset = 0;
+    int width = 1;
+
+    if(COValue::isBitField(newType)){
+        offset = COValue::bitFieldOffset(newType);
+        width = COValue::bitFieldWidth(newType);
+    }
+
+    int index = ui->cbWordSize->findData(static_cast<int>(size));
+    if(index == -1) index = 0;
+
+    ui->cbWordSize->setCurrentIndex(index);
+    ui->sbOffset->setValue(offset);
+    ui->sbWidth->setValue(width);
+}
+
+void BitFieldEditDlg::on_cbWordSize_currentIndexChanged(int index)
+{
+    Q_UNUSED(index);
+
+    updateLimits();
+}
+
+void BitFieldEditDlg::on_sbOffset_valueChanged(int value)
+{
+    Q_UNUSED(value);
+
+    updateLimits();
+}
+
+size_t BitFieldEditDlg::wordSize() const
+{
+    bool ok = false;
+    int size = ui->cbWordSize->currentData().toInt(&ok);
+    if(ok) return static_cast<size_t>(size);
+    return 1;
+}
+
+void BitFieldEditDlg::updateLimits()
+{
+    int bits = static_cast<int>(wordSize() * 8);
+
+    // the field fits the word.
+    ui->sbOffset->setMaximum(bits - 1);
+    ui->sbWidth->setMaximum(bits - ui->sbOffset->value());
+}
@@ -0,0 +1,41 @@
+#ifndef BITFIELDEDITDLG_H
+#define BITFIELDEDITDLG_H
+
+#include <QDialog>
+#include "covaluetypes.h"
+
+
+
+namespace Ui {
+class BitFieldEditDlg;
+}
+
+
+/*
+ * Bit field type selection:
+ * the word size, the offset and the width of the field.
+ */
+class BitFieldEditDlg : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit BitFieldEditDlg(QWidget *parent = nullptr);
+    ~BitFieldEditDlg();
+
+    COValue::Type type() const;
+    // plain types set the word of their size.
+    void setType(COValue::Type newType);
+
+private slots:
+    void on_cbWordSize_currentIndexChanged(int index);
+    void on_sbOffset_valueChanged(int value);
+
+private:
+    Ui::BitFieldEditDlg *ui;
+
+    size_t wordSize() const;
+    void updateLimits();
+};
+
+#endif // BITFIELDEDITDLG_H
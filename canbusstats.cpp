@@ -0,0 +1,311 @@
+#include "canbusstats.h"
+#include <algorithm>
+#include <cmath>
+
+
+// moving period mean & variance weight.
+#define CAN_BUS_STATS_PERIOD_ALPHA (1.0 / 16)
+// CRC delimiter, ACK slot & delimiter, EOF, interframe space.
+#define CAN_FRAME_TAIL_BITS (1 + 2 + 7 + 3)
+#define CAN_CRC15_POLY 0x4599
+// SLCAN transmit confirmation "z\r".
+#define SLCAN_TX_ANSWER_CHARS 2
+
+
+
+CanBusStats::CanBusStats()
+{
+    m_bitrate = 125;
+    m_serialBaud = 115200;
+    m_serialCharBits = 10;
+    m_adapterAnswers = false;
+    m_window = DEFAULT_WINDOW_MS;
+
+    reset();
+}
+
+CanBusStats::~CanBusStats()
+{
+}
+
+uint CanBusStats::bitrate() const
+{
+    return m_bitrate;
+}
+
+void CanBusStats::setBitrate(uint newBitrate)
+{
+    m_bitrate = newBitrate;
+}
+
+void CanBusStats::setSerialConf(quint32 newBaud, bool newParity, int newStopBits)
+{
+    m_serialBaud = newBaud;
+    // start + 8 data + parity + stop.
+    m_serialCharBits = 1 + 8 + (newParity ? 1 : 0) + static_cast<uint>(std::max(newStopBits, 1));
+}
+
+quint32 CanBusStats::serialBaud() const
+{
+    return m_serialBaud;
+}
+
+uint CanBusStats::serialCharBits() const
+{
+    return m_serialCharBits;
+}
+
+bool CanBusStats::adapterAnswers() const
+{
+    return m_adapterAnswers;
+}
+
+void CanBusStats::setAdapterAnswers(bool newAnswers)
+{
+    m_adapterAnswers = newAnswers;
+}
+
+int CanBusStats::window() const
+{
+    return m_window;
+}
+
+void CanBusStats::setWindow(int newWindowMs)
+{
+    m_window = std::max(newWindowMs, 1);
+}
+
+void CanBusStats::put(quint16 id, bool rtr, bool tx, quint8 dlc, const quint8* data)
+{
+    id &= IDS_COUNT - 1;
+
+    meas_clock::time_point tp = meas_clock::now();
+
+    IdEntry& e = m_entries[id];
+
+    if(!e.seen){
+        e.seen = true;
+        m_ids.append(id);
+    }else{
+        double period = std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(tp - e.lastTp).count();
+
+        if(e.rxCount + e.txCount == 1){
+            e.periodMean = period;
+            e.periodVar = 0.0;
+        }else{
+            double d = period - e.periodMean;
+            e.periodMean += CAN_BUS_STATS_PERIOD_ALPHA * d;
+            e.periodVar = (1.0 - CAN_BUS_STATS_PERIOD_ALPHA) * (e.periodVar + CAN_BUS_STATS_PERIOD_ALPHA * d * d);
+        }
+    }
+
+    e.lastTp = tp;
+    e.lastDlc = dlc;
+    e.lastTx = tx;
+    e.windowCount ++;
+    if(tx) e.txCount ++;
+    else e.rxCount ++;
+
+    uint bits = frameBits(id, rtr, dlc, data);
+    uint chars = frameSerialChars(rtr, dlc);
+
+    m_windowBits += bits;
+    m_windowFrames ++;
+    if(tx){
+        m_windowTxChars += chars;
+        if(m_adapterAnswers) m_windowRxChars += SLCAN_TX_ANSWER_CHARS;
+    }else{
+        m_windowRxChars += chars;
+    }
+
+    m_bitsCount += bits;
+    m_framesCount ++;
+}
+
+void CanBusStats::update()
+{
+    meas_clock::time_point tp = meas_clock::now();
+
+    double dt = std::chrono::duration_cast<std::chrono::duration<double>>(tp - m_windowTp).count();
+    if(dt * 1000 < m_window) return;
+
+    m_windowTp = tp;
+
+    double busBits = static_cast<double>(m_bitrate) * 1000 * dt;
+    double serialBits = static_cast<double>(m_serialBaud) * dt;
+
+    m_busLoad = (busBits > 0) ? m_windowBits / busBits : 0.0;
+    m_serialRxLoad = (serialBits > 0) ? m_windowRxChars * m_serialCharBits / serialBits : 0.0;
+    m_serialTxLoad = (serialBits > 0) ? m_windowTxChars * m_serialCharBits / serialBits : 0.0;
+    m_framesRate = m_windowFrames / dt;
+
+    m_windowBits = 0;
+    m_windowRxChars = 0;
+    m_windowTxChars = 0;
+    m_windowFrames = 0;
+
+    for(quint16 id: qAsConst(m_ids)){
+        IdEntry& e = m_entries[id];
+        e.rate = e.windowCount / dt;
+        e.windowCount = 0;
+    }
+}
+
+void CanBusStats::reset()
+{
+    for(IdEntry& e: m_entries){
+        e.rxCount = 0;
+        e.txCount = 0;
+        e.windowCount = 0;
+        e.rate = 0.0;
+        e.periodMean = 0.0;
+        e.periodVar = 0.0;
+        e.lastDlc = 0;
+        e.lastTx = false;
+        e.seen = false;
+    }
+    m_ids.clear();
+
+    m_windowTp = meas_clock::now();
+    m_windowBits = 0;
+    m_windowRxChars = 0;
+    m_windowTxChars = 0;
+    m_windowFrames = 0;
+
+    m_busLoad = 0.0;
+    m_serialRxLoad = 0.0;
+    m_serialTxLoad = 0.0;
+    m_framesRate = 0.0;
+
+    m_framesCount = 0;
+    m_bitsCount = 0;
+}
+
+double CanBusStats::busLoad() const
+{
+    return m_busLoad;
+}
+
+double CanBusStats::serialRxLoad() const
+{
+    return m_serialRxLoad;
+}
+
+double CanBusStats::serialTxLoad() const
+{
+    return m_serialTxLoad;
+}
+
+double CanBusStats::framesRate() const
+{
+    return m_framesRate;
+}
+
+quint64 CanBusStats::framesCount() const
+{
+    return m_framesCount;
+}
+
+quint64 CanBusStats::bitsCount() const
+{
+    return m_bitsCount;
+}
+
+const QVector<quint16>& CanBusStats::ids() const
+{
+    return m_ids;
+}
+
+bool CanBusStats::idStats(quint16 id, IdStats* stats) const
+{
+    if(id >= IDS_COUNT) return false;
+
+    const IdEntry& e = m_entries[id];
+    if(!e.seen) return false;
+
+    if(stats == nullptr) return true;
+
+    stats->id = id;
+    stats->rxCount = e.rxCount;
+    stats->txCount = e.txCount;
+    stats->rate = e.rate;
+    stats->periodMean = e.periodMean;
+    stats->periodJitter = std::sqrt(e.periodVar);
+    stats->lastDlc = e.lastDlc;
+    stats->lastTx = e.lastTx;
+
+    return true;
+}
+
+uint CanBusStats::frameBits(quint16 id, bool rtr, quint8 dlc, const quint8* data)
+{
+    // SOF, ID, RTR, IDE, r0, DLC, data, CRC.
+    quint8 bits[1 + 11 + 3 + 4 + 64 + 15];
+    uint n = 0;
+
+    auto push = [&bits, &n](uint value, int count){
+        for(int i = count - 1; i >= 0; i --){
+            bits[n ++] = (value >> i) & 1;
+        }
+    };
+
+    push(0, 1);
+    push(id & 0x7ff, 11);
+    push(rtr ? 1 : 0, 1);
+    push(0, 2);
+    push(dlc & 0xf, 4);
+
+    uint dataSize = (rtr || data == nullptr) ? 0 : std::min(dlc, static_cast<quint8>(8));
+    for(uint i = 0; i < dataSize; i ++){
+        push(data[i], 8);
+    }
+
+    uint crc = 0;
+    for(uint i = 0; i < n; i ++){
+        uint bit = bits[i] ^ ((crc >> 14) & 1);
+        crc = (crc << 1) & 0x7fff;
+        if(bit) crc ^= CAN_CRC15_POLY;
+    }
+    push(crc, 15);
+
+    // stuff bit after 5 equal bits, it is counted in the next run.
+    uint stuffBits = 0;
+    quint8 prev = bits[0];
+    uint run = 1;
+    for(uint i = 1; i < n; i ++){
+        if(bits[i] == prev){
+            run ++;
+        }else{
+            prev = bits[i];
+            run = 1;
+        }
+        if(run == 5){
+            stuffBits ++;
+            prev = !prev;
+            run = 1;
+        }
+    }
+
+    return n + stuffBits + CAN_FRAME_TAIL_BITS;
+}
+
+uint CanBusStats::frameMaxBits(quint8 dlc)
+{
+    uint dataBits = std::min(dlc, static_cast<quint8>(8)) * 8;
+
+    // 34 stuffed bits of the header & CRC, one stuff bit per 4 bits.
+    return 34 + dataBits + (34 + dataBits - 1) / 4 + CAN_FRAME_TAIL_BITS;
+}
+
+uint CanBusStats::txAnswerSerialChars()
+{
+    return SLCAN_TX_ANSWER_CHARS;
+}
+
+uint CanBusStats::frameSerialChars(bool rtr, quint8 dlc)
+{
+    uint dataSize = rtr ? 0 : std::min(dlc, static_cast<quint8>(8));
+
+    // type, id, dlc, data, CR.
+    return 1 + 3 + 1 + dataSize * 2 + 1;
+}
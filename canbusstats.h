@@ -0,0 +1,121 @@
+#ifndef CANBUSSTATS_H
+#define CANBUSSTATS_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <chrono>
+
+
+/*
+ * CAN traffic statistics.
+ * Per identifier statistics are updated incrementally on each frame,
+ * bus load and serial link utilization are estimated
+ * over the measurement window.
+ */
+class CanBusStats
+{
+public:
+
+    struct IdStats {
+        quint16 id;
+        quint64 rxCount;
+        quint64 txCount;
+        // frames per second over the last window.
+        double rate;
+        // moving mean and standard deviation of the period, us.
+        double periodMean;
+        double periodJitter;
+        quint8 lastDlc;
+        bool lastTx;
+    };
+
+    static const int IDS_COUNT = 2048;
+    static const int DEFAULT_WINDOW_MS = 1000;
+
+    CanBusStats();
+    ~CanBusStats();
+
+    // CAN bit rate, kbit/s.
+    uint bitrate() const;
+    void setBitrate(uint newBitrate);
+
+    // serial link: baud, parity bit & stop bits count.
+    void setSerialConf(quint32 newBaud, bool newParity, int newStopBits);
+    quint32 serialBaud() const;
+    // bits per char including start, parity & stop bits.
+    uint serialCharBits() const;
+    // the adapter confirms the sent frames.
+    bool adapterAnswers() const;
+    void setAdapterAnswers(bool newAnswers);
+
+    int window() const;
+    void setWindow(int newWindowMs);
+
+    void put(quint16 id, bool rtr, bool tx, quint8 dlc, const quint8* data);
+    // close the window if elapsed.
+    void update();
+    void reset();
+
+    // 0..1 over the last window.
+    double busLoad() const;
+    double serialRxLoad() const;
+    double serialTxLoad() const;
+    double framesRate() const;
+
+    quint64 framesCount() const;
+    quint64 bitsCount() const;
+
+    // identifiers in the order of the first reception.
+    const QVector<quint16>& ids() const;
+    bool idStats(quint16 id, IdStats* stats) const;
+
+    // bits on the bus including stuff bits & interframe space.
+    static uint frameBits(quint16 id, bool rtr, quint8 dlc, const quint8* data);
+    // worst case stuffed frame bits.
+    static uint frameMaxBits(quint8 dlc);
+    // SLCAN encoded frame chars ("tiiildd..\r").
+    static uint frameSerialChars(bool rtr, quint8 dlc);
+    // SLCAN transmit confirmation chars.
+    static uint txAnswerSerialChars();
+
+private:
+    using meas_clock = std::chrono::steady_clock;
+
+    struct IdEntry {
+        quint64 rxCount;
+        quint64 txCount;
+        quint32 windowCount;
+        double rate;
+        double periodMean;
+        double periodVar;
+        meas_clock::time_point lastTp;
+        quint8 lastDlc;
+        bool lastTx;
+        bool seen;
+    };
+
+    IdEntry m_entries[IDS_COUNT];
+    QVector<quint16> m_ids;
+
+    uint m_bitrate;
+    quint32 m_serialBaud;
+    uint m_serialCharBits;
+    bool m_adapterAnswers;
+    int m_window;
+
+    meas_clock::time_point m_windowTp;
+    quint64 m_windowBits;
+    quint64 m_windowRxChars;
+    quint64 m_windowTxChars;
+    quint64 m_windowFrames;
+
+    double m_busLoad;
+    double m_serialRxLoad;
+    double m_serialTxLoad;
+    double m_framesRate;
+
+    quint64 m_framesCount;
+    quint64 m_bitsCount;
+};
+
+#endif // CANBUSSTATS_H
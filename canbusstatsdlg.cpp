@@ -0,0 +1,166 @@
+#include "canbusstatsdlg.h"
+#include "ui_canbusstatsdlg.h"
+#include "canbusstats.h"
+#include "covaluesholder.h"
+#include "sdocache.h"
+#include <QTimer>
+#include <QHeaderView>
+#include <QTableWidgetItem>
+#include <QString>
+
+
+#define CAN_BUS_STATS_DLG_UPDATE_INTERVAL 500
+
+enum StatsColumn {
+    COL_ID = 0,
+    COL_DIR,
+    COL_COUNT,
+    COL_RATE,
+    COL_PERIOD,
+    COL_JITTER,
+    COL_DLC,
+    COLS_COUNT
+};
+
+
+
+CanBusStatsDlg::CanBusStatsDlg(QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::CanBusStatsDlg)
+{
+    ui->setupUi(this);
+
+    m_busStats = nullptr;
+    m_valsHolder = nullptr;
+    m_sdoCache = nullptr;
+
+    ui->twIds->setColumnCount(COLS_COUNT);
+    ui->twIds->setHorizontalHeaderLabels({tr("ID"), tr("Напр."), tr("Кадров"), tr("Частота, Гц"),
+                                          tr("Период, мс"), tr("Джиттер, мс"), tr("DLC")});
+    ui->twIds->verticalHeader()->hide();
+    ui->twIds->horizontalHeader()->setStretchLastSection(true);
+
+    m_updateTimer = new QTimer();
+    m_updateTimer->setInterval(CAN_BUS_STATS_DLG_UPDATE_INTERVAL);
+    m_updateTimer->setSingleShot(false);
+    connect(m_updateTimer, &QTimer::timeout, this, &CanBusStatsDlg::updateStats);
+}
+
+CanBusStatsDlg::~CanBusStatsDlg()
+{
+    delete m_updateTimer;
+    delete ui;
+}
+
+const CanBusStats* CanBusStatsDlg::busStats() const
+{
+    return m_busStats;
+}
+
+void CanBusStatsDlg::setBusStats(const CanBusStats* newBusStats)
+{
+    m_busStats = newBusStats;
+
+    updateStats();
+}
+
+const CoValuesHolder* CanBusStatsDlg::valuesHolder() const
+{
+    return m_valsHolder;
+}
+
+void CanBusStatsDlg::setValuesHolder(const CoValuesHolder* newValuesHolder)
+{
+    m_valsHolder = newValuesHolder;
+
+    updateStats();
+}
+
+const SDOCache* CanBusStatsDlg::sdoCache() const
+{
+    return m_sdoCache;
+}
+
+void CanBusStatsDlg::setSdoCache(const SDOCache* newSdoCache)
+{
+    m_sdoCache = newSdoCache;
+
+    updateStats();
+}
+
+void CanBusStatsDlg::showEvent(QShowEvent* event)
+{
+    QDialog::showEvent(event);
+
+    updateStats();
+    m_updateTimer->start();
+}
+
+void CanBusStatsDlg::hideEvent(QHideEvent* event)
+{
+    m_updateTimer->stop();
+
+    QDialog::hideEvent(event);
+}
+
+void CanBusStatsDlg::updateStats()
+{
+    if(m_valsHolder != nullptr){
+        ui->lblPollsSkipped->setText(QString::number(m_valsHolder->pollsSkipped()));
+        ui->lblRepaintsAvoided->setText(QString::number(m_valsHolder->repaintsAvoided()));
+    }
+
+    if(m_sdoCache != nullptr){
+        if(m_sdoCache->enabled()){
+            ui->lblSdoCache->setText(tr("%1 попаданий, %2 промахов")
+                                     .arg(m_sdoCache->hits())
+                                     .arg(m_sdoCache->misses()));
+        }else{
+            ui->lblSdoCache->setText(tr("Выкл."));
+        }
+    }
+
+    if(m_busStats == nullptr){
+        ui->twIds->setRowCount(0);
+        return;
+    }
+
+    ui->lblBusLoad->setText(tr("%1 % (%2 кбит/с)")
+                            .arg(m_busStats->busLoad() * 100, 0, 'f', 1)
+                            .arg(m_busStats->bitrate()));
+    ui->lblSerialRxLoad->setText(tr("%1 %").arg(m_busStats->serialRxLoad() * 100, 0, 'f', 1));
+    ui->lblSerialTxLoad->setText(tr("%1 %").arg(m_busStats->serialTxLoad() * 100, 0, 'f', 1));
+    ui->lblFramesRate->setText(tr("%1 кадр/с").arg(m_busStats->framesRate(), 0, 'f', 0));
+
+    const QVector<quint16>& ids = m_busStats->ids();
+
+    // ids are appended or cleared.
+    if(ui->twIds->rowCount() > ids.size()) ui->twIds->setRowCount(0);
+
+    int oldRows = ui->twIds->rowCount();
+    if(oldRows != ids.size()){
+        ui->twIds->setRowCount(ids.size());
+        for(int row = oldRows; row < ids.size(); row ++){
+            for(int col = 0; col < COLS_COUNT; col ++){
+                ui->twIds->setItem(row, col, new QTableWidgetItem());
+            }
+        }
+    }
+
+    CanBusStats::IdStats stats;
+    for(int row = 0; row < ids.size(); row ++){
+        if(!m_busStats->idStats(ids[row], &stats)) continue;
+
+        QString dir;
+        if(stats.rxCount != 0) dir = QStringLiteral("Rx");
+        if(stats.txCount != 0) dir += dir.isEmpty() ? QStringLiteral("Tx") : QStringLiteral("/Tx");
+
+        ui->twIds->item(row, COL_ID)->setText(QString("%1").arg(stats.id, 3, 16, QChar('0')).toUpper());
+        ui->twIds->item(row, COL_DIR)->setText(dir);
+        ui->twIds->item(row, COL_COUNT)->setText(QString::number(stats.rxCount + stats.txCount));
+        ui->twIds->item(row, COL_RATE)->setText(QString::number(stats.rate, 'f', 1));
+        ui->twIds->item(row, COL_PERIOD)->setText(QString::number(stats.periodMean / 1000, 'f', 2));
+        ui->twIds->item(row, COL_JITTER)->setText(QString::number(stats.periodJitter / 1000, 'f', 2));
+        ui->twIds->item(row, COL_DLC)->setText(QString::number(stats.lastDlc));
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef CANBUSSTATSDLG_H
+#define CANBUSSTATSDLG_H
+
+#include <QDialog>
+
+
+class QTimer;
+class CanBusStats;
+class CoValuesHolder;
+class SDOCache;
+
+
+namespace Ui {
+class CanBusStatsDlg;
+}
+
+class CanBusStatsDlg : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit CanBusStatsDlg(QWidget *parent = nullptr);
+    ~CanBusStatsDlg();
+
+    const CanBusStats* busStats() const;
+    void setBusStats(const CanBusStats* newBusStats);
+
+    const CoValuesHolder* valuesHolder() const;
+    void setValuesHolder(const CoValuesHolder* newValuesHolder);
+
+    const SDOCache* sdoCache() const;
+    void setSdoCache(const SDOCache* newSdoCache);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private slots:
+    void updateStats();
+
+private:
+    Ui::CanBusStatsDlg *ui;
+
+    const CanBusStats* m_busStats;
+    const CoValuesHolder* m_valsHolder;
+    const SDOCache* m_sdoCache;
+    QTimer* m_updateTimer;
+};
+
+#endif // CANBUSSTATSDLG_H
@@ -2,6 +2,7 @@
 #include "ui_canopenwin.h"
 #include "slcanopennode.h"
 #include "covaluesholder.h"
+#include "copdomapper.h"
 #include "covaluetypes.h"
 #include "sdovalueplot.h"
 #include "sdovaluedial.h"
@@ -19,6 +20,8 @@
 #include "sdovaluebareditdlg.h"
 #include "sdovaluebuttoneditdlg.h"
 #include "sdovalueindicatoreditdlg.h"
+#include "cantracedlg.h"
+#include "canbusstatsdlg.h"
 #include <QTimer>
 #include <QString>
 #include <QStringList>
@@ -90,6 +93,9 @@ CanOpenWin::CanOpenWin(QWidget *parent)
     connect(m_slcon, &SLCanOpenNode::connected, m_valsHolder, &CoValuesHolder::enableUpdating);
     connect(m_slcon, &SLCanOpenNode::disconnected, m_valsHolder, &CoValuesHolder::disableUpdating);
 
+    m_pdoMapper = new COPdoMapper(m_slcon, m_valsHolder);
+    connect(m_pdoMapper, &COPdoMapper::finished, this, &CanOpenWin::pdoMapper_finished);
+
     m_settingsDlg = new SettingsDlg();
 
     m_signalCurveEditDlg = new SignalCurveEditDlg();
@@ -106,6 +112,14 @@ CanOpenWin::CanOpenWin(QWidget *parent)
 
     m_indicatorDlg = new SDOValueIndicatorEditDlg();
 
+    m_canTraceDlg = new CanTraceDlg();
+    m_canTraceDlg->setTraceBuffer(m_slcon->canTrace());
+
+    m_busStatsDlg = new CanBusStatsDlg();
+    m_busStatsDlg->setBusStats(m_slcon->busStats());
+    m_busStatsDlg->setValuesHolder(m_valsHolder);
+    m_busStatsDlg->setSdoCache(m_slcon->sdoCache());
+
     applySettings();
 
     //auto svi = new SDOValueIndicator();
@@ -115,9 +129,13 @@ CanOpenWin::CanOpenWin(QWidget *parent)
 
 CanOpenWin::~CanOpenWin()
 {
+    delete m_pdoMapper;
+
     m_slcon->destroyCO();
     m_slcon->closePort();
 
+    delete m_busStatsDlg;
+    delete m_canTraceDlg;
     delete m_indicatorDlg;
 
     delete m_buttonDlg;
@@ -205,7 +223,7 @@ void CanOpenWin::on_actSaveCockpit_triggered(bool checked)
 
     auto widgets = collectCockpitWidgets();
 
-    bool isOk = ser.serialize(&file, widgets);
+    bool isOk = ser.serialize(&file, widgets, m_valsHolder->compoundReads());
 
     if(!isOk){
         QMessageBox::critical(this, tr("Ошибка!"), tr("Невозможно сохранить файл: %1").arg(fileName));
@@ -235,7 +253,8 @@ void CanOpenWin::on_actOpenCockpit_triggered(bool checked)
     ser.setSdoValuesHolder(m_valsHolder);
 
     bool isOk = false;
-    auto widgets = ser.deserialize(&file, &isOk);
+    CockpitSerializer::CockpitCompounds compounds;
+    auto widgets = ser.deserialize(&file, &isOk, &compounds);
 
     if(!isOk){
         QMessageBox::critical(this, tr("Ошибка!"), tr("Невозможно загрузить файл: %1").arg(fileName));
@@ -246,6 +265,8 @@ void CanOpenWin::on_actOpenCockpit_triggered(bool checked)
     file.close();
 
     clearCockpitWidgets();
+    clearCockpitCompounds();
+    appendCockpitCompounds(compounds);
     appendCockpitWidgets(widgets);
 }
 
@@ -261,17 +282,24 @@ void CanOpenWin::on_actSettings_triggered(bool checked)
     m_settingsDlg->setChinaAdapter(m_settings->conn.chinaAdapter);
     m_settingsDlg->setCanBitrate(m_settings->conn.canBitrate);
     m_settingsDlg->setProcessInterval(m_settings->conn.processInterval);
+    m_settingsDlg->setBusLoadTarget(m_settings->conn.busLoadTarget);
+    m_settingsDlg->setSerialLoadTarget(m_settings->conn.serialLoadTarget);
     m_settingsDlg->setNodeId(m_settings->co.nodeId);
     m_settingsDlg->setClientNodeId(m_settings->co.clientId);
     m_settingsDlg->setCobidCliToSrv(m_settings->co.cobidCliToSrv);
     m_settingsDlg->setCobidSrvToCli(m_settings->co.cobidSrvToCli);
     m_settingsDlg->setUseSdoBlockTransfer(m_settings->co.useSdoBlockTransfer);
+    m_settingsDlg->setUseSdoCache(m_settings->co.useSdoCache);
     m_settingsDlg->setClientTimeout(m_settings->co.cliTimeout);
     m_settingsDlg->setServerTimeout(m_settings->co.srvTimeout);
     m_settingsDlg->setSdoTimeout(m_settings->co.sdoTimeout);
     m_settingsDlg->setHbFirstTime(m_settings->co.hbFirstTime);
     m_settingsDlg->setHbPeriod(m_settings->co.hbPeriod);
+    m_settingsDlg->setSyncPeriod(m_settings->co.syncPeriod);
+    m_settingsDlg->setSyncCntOverflow(m_settings->co.syncCntOverflow);
+    m_settingsDlg->setHbConsTime(m_settings->co.hbConsTime);
     m_settingsDlg->setWindowColor(m_settings->appear.windowColor);
+    m_settingsDlg->setTpdos(m_settings->tpdo);
     //m_settingsDlg->set(m_settings->);
 
     if(m_settingsDlg->exec()){
@@ -283,17 +311,24 @@ void CanOpenWin::on_actSettings_triggered(bool checked)
         m_settings->conn.chinaAdapter = m_settingsDlg->chinaAdapter();
         m_settings->conn.canBitrate = m_settingsDlg->canBitrate();
         m_settings->conn.processInterval = m_settingsDlg->processInterval();
+        m_settings->conn.busLoadTarget = m_settingsDlg->busLoadTarget();
+        m_settings->conn.serialLoadTarget = m_settingsDlg->serialLoadTarget();
         m_settings->co.nodeId = m_settingsDlg->nodeId();
         m_settings->co.clientId = m_settingsDlg->clientNodeId();
         m_settings->co.cobidCliToSrv = m_settingsDlg->cobidCliToSrv();
         m_settings->co.cobidSrvToCli = m_settingsDlg->cobidSrvToCli();
         m_settings->co.useSdoBlockTransfer = m_settingsDlg->useSdoBlockTransfer();
+        m_settings->co.useSdoCache = m_settingsDlg->useSdoCache();
         m_settings->co.cliTimeout = m_settingsDlg->clientTimeout();
         m_settings->co.srvTimeout = m_settingsDlg->serverTimeout();
         m_settings->co.sdoTimeout = m_settingsDlg->sdoTimeout();
         m_settings->co.hbFirstTime = m_settingsDlg->hbFirstTime();
         m_settings->co.hbPeriod = m_settingsDlg->hbPeriod();
+        m_settings->co.syncPeriod = m_settingsDlg->syncPeriod();
+        m_settings->co.syncCntOverflow = m_settingsDlg->syncCntOverflow();
+        m_settings->co.hbConsTime = m_settingsDlg->hbConsTime();
         m_settings->appear.windowColor = m_settingsDlg->windowColor();
+        m_settings->tpdo = m_settingsDlg->tpdos();
 
         applySettings();
     }
@@ -312,6 +347,14 @@ void CanOpenWin::on_actConnect_triggered(bool checked)
     if(is_open){
         qDebug() << "Port opened!";
 
+        // monitor nodes of the current values.
+        m_slcon->resetHbConsumers();
+        if(m_settings->co.hbConsTime != 0){
+            for(auto nodeId: m_valsHolder->nodeIds()){
+                m_slcon->addHbConsumer(nodeId, m_settings->co.hbConsTime);
+            }
+        }
+
         bool co_created = m_slcon->createCO(m_settings->conn.canBitrate);
         if(co_created){
             qDebug() << "Connected!";
@@ -344,6 +387,100 @@ void CanOpenWin::on_actDisconnect_triggered(bool checked)
     qDebug() << "Disconnected!";
 }
 
+void CanOpenWin::on_actListenOnly_triggered(bool checked)
+{
+    m_settings->conn.listenOnly = checked;
+    m_settings->save();
+
+    m_slcon->setListenOnly(checked);
+}
+
+void CanOpenWin::on_actPdoAutoMapping_triggered(bool checked)
+{
+    Q_UNUSED(checked)
+
+    if(!m_slcon->isConnected()){
+        QMessageBox::warning(this, tr("PDO"), tr("Нет соединения!"));
+        return;
+    }
+
+    if(m_pdoMapper->running()) return;
+
+    if(m_slcon->listenOnly()){
+        QMessageBox::warning(this, tr("PDO"), tr("Включен режим только прослушивания!"));
+        return;
+    }
+
+    if(!m_pdoMapper->plan()){
+        QMessageBox::information(this, tr("PDO"), tr("Нет значений для отображения в PDO."));
+        return;
+    }
+
+    auto res = QMessageBox::question(this, tr("PDO"),
+                                     m_pdoMapper->report() + "\n\n" +
+                                     tr("Записать отображение TPDO в узлы?"));
+    if(res != QMessageBox::Yes) return;
+
+    if(!m_pdoMapper->apply()){
+        QMessageBox::critical(this, tr("Ошибка!"), tr("Невозможно начать запись отображения PDO!"));
+    }
+}
+
+void CanOpenWin::on_actCanTrace_triggered(bool checked)
+{
+    Q_UNUSED(checked)
+
+    m_canTraceDlg->show();
+    m_canTraceDlg->raise();
+    m_canTraceDlg->activateWindow();
+}
+
+void CanOpenWin::on_actBusStats_triggered(bool checked)
+{
+    Q_UNUSED(checked)
+
+    m_busStatsDlg->show();
+    m_busStatsDlg->raise();
+    m_busStatsDlg->activateWindow();
+}
+
+void CanOpenWin::pdoMapper_finished(bool ok)
+{
+    // keep local RPDOs in the settings.
+    m_settings->rpdo.clear();
+
+    uint rpdoNum = 0;
+    for(const auto& pdo: m_pdoMapper->pdos()){
+        if(!pdo.applied) continue;
+
+        Settings::Pdo spdo;
+        spdo.num = rpdoNum ++;
+        spdo.cobid = pdo.cobid;
+        spdo.transType = 254;
+        spdo.inhibitTime = 0;
+        spdo.eventTimer = 0;
+
+        for(const auto& obj: pdo.objects){
+            Settings::PdoMapping m;
+            m.nodeId = obj.nodeId;
+            m.index = obj.index;
+            m.subIndex = obj.subIndex;
+            m.dataSize = obj.dataSize;
+            spdo.mapping.append(m);
+        }
+
+        m_settings->rpdo.append(spdo);
+    }
+
+    m_settings->save();
+
+    if(ok){
+        QMessageBox::information(this, tr("PDO"), m_pdoMapper->report());
+    }else{
+        QMessageBox::warning(this, tr("PDO"), tr("Отображение PDO записано не во все узлы.") + "\n\n" + m_pdoMapper->report());
+    }
+}
+
 void CanOpenWin::on_actAddPlot_triggered(bool checked)
 {
     Q_UNUSED(checked)
@@ -361,6 +498,7 @@ void CanOpenWin::on_actAddPlot_triggered(bool checked)
         plt->setBackground(m_trendDlg->backColor());
         plt->setTextColor(m_trendDlg->textColor());
         plt->setLegendItemEnabled(m_trendDlg->legendEnabled());
+        plt->setCompactStorage(m_trendDlg->compactStorage());
 
         int transp = m_trendDlg->defaultAlpha();
         plt->setDefaultAlpha( (transp > 0) ? static_cast<qreal>(transp) / 100 : -1.0);
@@ -368,12 +506,16 @@ void CanOpenWin::on_actAddPlot_triggered(bool checked)
         for(int i = 0; i < m_trendDlg->signalsCount(); i ++){
             auto& sig = m_trendDlg->signalCurveProp(i);
 
-            bool added = plt->addSDOValue(sig.nodeId, sig.index, sig.subIndex, sig.type, sig.name);
+            bool added = (sig.samples > 0) ?
+                        plt->addSDOWaveform(sig.nodeId, sig.index, sig.subIndex, sig.type, sig.samples, sig.samplePeriod, sig.name) :
+                        plt->addSDOValue(sig.nodeId, sig.index, sig.subIndex, sig.type, sig.name);
             if(!added){
                 QMessageBox::warning(this, tr("Ошибка добавления сигнала!"), tr("Невозможно добавить сигнал: \"%1\"").arg(sig.name));
                 continue;
             }
 
+            plt->setSDOValuePollPeriod(i, sig.pollPeriod);
+
             QPen pen;
             pen.setStyle(sig.penStyle);
             pen.setColor(sig.penColor);
@@ -430,6 +572,7 @@ void CanOpenWin::on_actEditPlot_triggered(bool checked)
     m_trendDlg->setTextColor(plt->textColor());
     m_trendDlg->setDefaultAlpha(static_cast<int>(plt->defaultAlpha() * 100));
     m_trendDlg->setLegendEnabled(plt->legendItemEnabled());
+    m_trendDlg->setCompactStorage(plt->compactStorage());
     m_trendDlg->setSamplesCount(static_cast<int>(plt->bufferSize()));
 
     m_trendDlg->setSignalsCount(plt->SDOValuesCount());
@@ -442,6 +585,9 @@ void CanOpenWin::on_actEditPlot_triggered(bool checked)
         sig.index = sdoval->index();
         sig.subIndex = sdoval->subIndex();
         sig.type = plt->SDOValueType(i);
+        sig.samples = plt->SDOValueSamples(i);
+        sig.samplePeriod = plt->SDOValueSamplePeriod(i);
+        sig.pollPeriod = plt->SDOValuePollPeriod(i);
 
         sig.name = plt->signalName(i);
         sig.penColor = plt->pen(i).color();
@@ -465,6 +611,7 @@ void CanOpenWin::on_actEditPlot_triggered(bool checked)
         plt->setBackground(m_trendDlg->backColor());
         plt->setTextColor(m_trendDlg->textColor());
         plt->setLegendItemEnabled(m_trendDlg->legendEnabled());
+        plt->setCompactStorage(m_trendDlg->compactStorage());
 
         int transp = m_trendDlg->defaultAlpha();
         plt->setDefaultAlpha( (transp > 0) ? static_cast<qreal>(transp) / 100 : -1.0);
@@ -472,12 +619,16 @@ void CanOpenWin::on_actEditPlot_triggered(bool checked)
         for(int i = 0; i < m_trendDlg->signalsCount(); i ++){
             auto& sig = m_trendDlg->signalCurveProp(i);
 
-            bool added = plt->addSDOValue(sig.nodeId, sig.index, sig.subIndex, sig.type, sig.name);
+            bool added = (sig.samples > 0) ?
+                        plt->addSDOWaveform(sig.nodeId, sig.index, sig.subIndex, sig.type, sig.samples, sig.samplePeriod, sig.name) :
+                        plt->addSDOValue(sig.nodeId, sig.index, sig.subIndex, sig.type, sig.name);
             if(!added){
                 QMessageBox::warning(this, tr("Ошибка добавления сигнала!"), tr("Невозможно добавить сигнал: \"%1\"").arg(sig.name));
                 continue;
             }
 
+            plt->setSDOValuePollPeriod(i, sig.pollPeriod);
+
             QPen pen;
             pen.setStyle(sig.penStyle);
             pen.setColor(sig.penColor);
@@ -534,6 +685,7 @@ void CanOpenWin::on_actAddDial_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка добавления показометра!"), tr("Невозможно добавить показометр: \"%1\"").arg(m_dialDlg->name()));
             return;
         }
+        dial->setPollPeriod(m_dialDlg->pollPeriod());
 
         dial->setName(m_dialDlg->name());
         dial->setInsideBackColor(m_dialDlg->insideBackColor());
@@ -543,6 +695,7 @@ void CanOpenWin::on_actAddDial_triggered(bool checked)
         dial->setNeedleColor(m_dialDlg->needleColor());
         dial->setPenWidth(m_dialDlg->penWidth());
         dial->setPrecision(m_dialDlg->precision());
+        dial->setDeadband(m_dialDlg->deadband(), m_dialDlg->deadbandMode());
 
         dial->setContextMenuPolicy(Qt::CustomContextMenu);
         connect(dial, &SDOValueDial::customContextMenuRequested, this, &CanOpenWin::showDialsContextMenu);
@@ -591,6 +744,8 @@ void CanOpenWin::on_actEditDial_triggered(bool checked)
 
     m_dialDlg->setRangeMin(dial->rangeMin());
     m_dialDlg->setRangeMax(dial->rangeMax());
+    m_dialDlg->setDeadband(dial->deadband());
+    m_dialDlg->setDeadbandMode(dial->deadbandMode());
 
     auto sdoval = dial->getSDOValue();
 
@@ -598,6 +753,7 @@ void CanOpenWin::on_actEditDial_triggered(bool checked)
     m_dialDlg->setIndex(sdoval->index());
     m_dialDlg->setSubIndex(sdoval->subIndex());
     m_dialDlg->setType(dial->SDOValueType());
+    m_dialDlg->setPollPeriod(dial->pollPeriod());
 
     if(m_dialDlg->exec()){
         dial->resetSDOValue();
@@ -607,6 +763,7 @@ void CanOpenWin::on_actEditDial_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка изменения показометра!"), tr("Невозможно изменить показометр: \"%1\"").arg(m_dialDlg->name()));
             return;
         }
+        dial->setPollPeriod(m_dialDlg->pollPeriod());
 
         dial->setName(m_dialDlg->name());
         dial->setInsideBackColor(m_dialDlg->insideBackColor());
@@ -616,6 +773,7 @@ void CanOpenWin::on_actEditDial_triggered(bool checked)
         dial->setNeedleColor(m_dialDlg->needleColor());
         dial->setPenWidth(m_dialDlg->penWidth());
         dial->setPrecision(m_dialDlg->precision());
+        dial->setDeadband(m_dialDlg->deadband(), m_dialDlg->deadbandMode());
 
         m_layout->takeAt(dialLayIndex);
         m_layout->addWidget(dial, m_dialDlg->posRow(), m_dialDlg->posColumn(), m_dialDlg->sizeRows(), m_dialDlg->sizeColumns());
@@ -657,6 +815,7 @@ void CanOpenWin::on_actAddSlider_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка добавления слайдера!"), tr("Невозможно добавить слайдер: \"%1\"").arg(m_sliderDlg->name()));
             return;
         }
+        slider->setPollPeriod(m_sliderDlg->pollPeriod());
 
         slider->setName(m_sliderDlg->name());
         slider->setTroughColor(m_sliderDlg->troughColor());
@@ -727,6 +886,7 @@ void CanOpenWin::on_actEditSlider_triggered(bool checked)
     m_sliderDlg->setIndex(sdoval->index());
     m_sliderDlg->setSubIndex(sdoval->subIndex());
     m_sliderDlg->setType(slider->SDOValueType());
+    m_sliderDlg->setPollPeriod(slider->pollPeriod());
 
     if(m_sliderDlg->exec()){
         slider->resetSDOValue();
@@ -736,6 +896,7 @@ void CanOpenWin::on_actEditSlider_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка изменения слайдера!"), tr("Невозможно изменить слайдер: \"%1\"").arg(m_sliderDlg->name()));
             return;
         }
+        slider->setPollPeriod(m_sliderDlg->pollPeriod());
 
         slider->setName(m_sliderDlg->name());
         slider->setTroughColor(m_sliderDlg->troughColor());
@@ -789,6 +950,7 @@ void CanOpenWin::on_actAddBar_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка добавления бара!"), tr("Невозможно добавить бар: \"%1\"").arg(m_barDlg->name()));
             return;
         }
+        bar->setPollPeriod(m_barDlg->pollPeriod());
 
         bar->setName(m_barDlg->name());
         bar->setBarBackColor(m_barDlg->barBackColor());
@@ -803,6 +965,7 @@ void CanOpenWin::on_actAddBar_triggered(bool checked)
         bar->setAlarmEnabled(m_barDlg->alarmEnabled());
         bar->setScalePosition(m_barDlg->scalePosition());
         bar->setOrientation(m_barDlg->orientation());
+        bar->setDeadband(m_barDlg->deadband(), m_barDlg->deadbandMode());
 
         bar->setContextMenuPolicy(Qt::CustomContextMenu);
         connect(bar, &SDOValueBar::customContextMenuRequested, this, &CanOpenWin::showBarsContextMenu);
@@ -856,6 +1019,8 @@ void CanOpenWin::on_actEditBar_triggered(bool checked)
 
     m_barDlg->setRangeMin(bar->rangeMin());
     m_barDlg->setRangeMax(bar->rangeMax());
+    m_barDlg->setDeadband(bar->deadband());
+    m_barDlg->setDeadbandMode(bar->deadbandMode());
 
     auto sdoval = bar->getSDOValue();
 
@@ -863,6 +1028,7 @@ void CanOpenWin::on_actEditBar_triggered(bool checked)
     m_barDlg->setIndex(sdoval->index());
     m_barDlg->setSubIndex(sdoval->subIndex());
     m_barDlg->setType(bar->SDOValueType());
+    m_barDlg->setPollPeriod(bar->pollPeriod());
 
     if(m_barDlg->exec()){
         bar->resetSDOValue();
@@ -872,6 +1038,7 @@ void CanOpenWin::on_actEditBar_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка изменения бара!"), tr("Невозможно изменить бар: \"%1\"").arg(m_barDlg->name()));
             return;
         }
+        bar->setPollPeriod(m_barDlg->pollPeriod());
 
         bar->setName(m_barDlg->name());
         bar->setBarBackColor(m_barDlg->barBackColor());
@@ -886,6 +1053,7 @@ void CanOpenWin::on_actEditBar_triggered(bool checked)
         bar->setAlarmEnabled(m_barDlg->alarmEnabled());
         bar->setScalePosition(m_barDlg->scalePosition());
         bar->setOrientation(m_barDlg->orientation());
+        bar->setDeadband(m_barDlg->deadband(), m_barDlg->deadbandMode());
 
         //qDebug() << m_barDlg->alarmEnabled() << bar->alarmEnabled();
 
@@ -929,6 +1097,7 @@ void CanOpenWin::on_actAddButton_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка добавления кнопки!"), tr("Невозможно добавить кнопку: \"%1\"").arg(m_buttonDlg->text()));
             return;
         }
+        button->setPollPeriod(m_buttonDlg->pollPeriod());
 
         button->setText(m_buttonDlg->text());
         button->setButtonColor(m_buttonDlg->buttonColor());
@@ -1004,6 +1173,7 @@ void CanOpenWin::on_actEditButton_triggered(bool checked)
     m_buttonDlg->setIndex(sdoval->index());
     m_buttonDlg->setSubIndex(sdoval->subIndex());
     m_buttonDlg->setType(button->SDOValueType());
+    m_buttonDlg->setPollPeriod(button->pollPeriod());
 
     if(m_buttonDlg->exec()){
         button->resetSDOValue();
@@ -1013,6 +1183,7 @@ void CanOpenWin::on_actEditButton_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка изменения кнопки!"), tr("Невозможно изменить кнопку: \"%1\"").arg(m_buttonDlg->text()));
             return;
         }
+        button->setPollPeriod(m_buttonDlg->pollPeriod());
 
         button->setText(m_buttonDlg->text());
         button->setButtonColor(m_buttonDlg->buttonColor());
@@ -1072,6 +1243,7 @@ void CanOpenWin::on_actAddIndicator_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка добавления индикатора!"), tr("Невозможно добавить индикатор: \"%1\"").arg(m_indicatorDlg->text()));
             return;
         }
+        indicator->setPollPeriod(m_indicatorDlg->pollPeriod());
 
         indicator->setText(m_indicatorDlg->text());
         indicator->setBackColor(m_indicatorDlg->backColor());
@@ -1141,6 +1313,7 @@ void CanOpenWin::on_actEditIndicator_triggered(bool checked)
     m_indicatorDlg->setIndex(sdoval->index());
     m_indicatorDlg->setSubIndex(sdoval->subIndex());
     m_indicatorDlg->setType(indicator->SDOValueType());
+    m_indicatorDlg->setPollPeriod(indicator->pollPeriod());
 
     if(m_indicatorDlg->exec()){
         indicator->resetSDOValue();
@@ -1150,6 +1323,7 @@ void CanOpenWin::on_actEditIndicator_triggered(bool checked)
             QMessageBox::critical(this, tr("Ошибка изменения индикатора!"), tr("Невозможно изменить индикатор: \"%1\"").arg(m_indicatorDlg->text()));
             return;
         }
+        indicator->setPollPeriod(m_indicatorDlg->pollPeriod());
 
         indicator->setText(m_indicatorDlg->text());
         indicator->setBackColor(m_indicatorDlg->backColor());
@@ -1205,17 +1379,41 @@ void CanOpenWin::CANopen_disconnected()
 void CanOpenWin::applySettings()
 {
     m_valsHolder->setUpdateInterval(m_settings->general.updatePeriod);
+    m_valsHolder->setBusLoadTarget(static_cast<qreal>(m_settings->conn.busLoadTarget) / 100);
+    m_valsHolder->setSerialLoadTarget(static_cast<qreal>(m_settings->conn.serialLoadTarget) / 100);
     m_slcon->setAdapterNoAnswers(m_settings->conn.chinaAdapter);
     m_slcon->setCoTimerInterval(m_settings->conn.processInterval);
+    m_slcon->setListenOnly(m_settings->conn.listenOnly);
+    ui->actListenOnly->setChecked(m_settings->conn.listenOnly);
     m_slcon->setFirstHBTime(m_settings->co.hbFirstTime);
     m_slcon->setHeartbeatTime(m_settings->co.hbPeriod);
+    // SYNC is applied on the next connection.
+    m_slcon->setSyncPeriod(m_settings->co.syncPeriod);
+    m_slcon->setSyncCounterOverflow(m_settings->co.syncCntOverflow);
     m_slcon->setSDOserverTimeout(m_settings->co.srvTimeout);
     m_slcon->setSDOclientTimeout(m_settings->co.cliTimeout);
     m_slcon->setDefaultTimeout(m_settings->co.sdoTimeout);
     m_slcon->setCobidClientToServer(m_settings->co.cobidCliToSrv);
     m_slcon->setCobidServerToClient(m_settings->co.cobidSrvToCli);
     m_slcon->setSDOclientBlockTransfer(m_settings->co.useSdoBlockTransfer);
+    m_slcon->setSdoCacheEnabled(m_settings->co.useSdoCache);
     m_slcon->setNodeId(m_settings->co.clientId);
+
+    // PDOs are applied on the next connection.
+    m_slcon->resetTpdos();
+    for(const auto& pdo: m_settings->tpdo){
+        if(!m_slcon->setTpdo(pdo.num, pdo.cobid, pdo.transType, pdo.inhibitTime, pdo.eventTimer)) continue;
+        for(const auto& m: pdo.mapping){
+            m_slcon->addTpdoMapping(pdo.num, m.nodeId, m.index, m.subIndex, m.dataSize);
+        }
+    }
+    m_slcon->resetRpdos();
+    for(const auto& pdo: m_settings->rpdo){
+        if(!m_slcon->setRpdo(pdo.num, pdo.cobid, pdo.transType)) continue;
+        for(const auto& m: pdo.mapping){
+            m_slcon->addRpdoMapping(pdo.num, m.nodeId, m.index, m.subIndex, m.dataSize);
+        }
+    }
     //m_->set(m_settings->);
 
     m_signalCurveEditDlg->setNodeId(m_settings->co.nodeId);
@@ -1285,6 +1483,26 @@ void CanOpenWin::appendCockpitWidgets(const CockpitSerializer::CockpitWidgets& w
     }
 }
 
+void CanOpenWin::clearCockpitCompounds()
+{
+    for(const auto& compound: m_valsHolder->compoundReads()){
+        m_valsHolder->delCompoundRead(compound.nodeId, compound.index, compound.subIndex);
+    }
+}
+
+void CanOpenWin::appendCockpitCompounds(const CockpitSerializer::CockpitCompounds& compounds)
+{
+    for(const auto& compound: compounds){
+        bool added = m_valsHolder->addCompoundRead(compound.nodeId, compound.index, compound.subIndex, compound.dataSize,
+                                                   compound.fields, 0, compound.period);
+        if(!added){
+            QMessageBox::warning(this, tr("Ошибка добавления составного чтения!"),
+                                 tr("Невозможно добавить составное чтение: 0x%1:%2")
+                                 .arg(compound.index, 4, 16, QChar('0')).arg(compound.subIndex));
+        }
+    }
+}
+
 void CanOpenWin::showPlotsContextMenu(const QPoint& pos)
 {
     auto plt = qobject_cast<SDOValuePlot*>(sender());
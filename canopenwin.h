@@ -17,6 +17,9 @@ class Settings;
 class SettingsDlg;
 class SLCanOpenNode;
 class CoValuesHolder;
+class COPdoMapper;
+class CanTraceDlg;
+class CanBusStatsDlg;
 class SDOValue;
 class SDOValuePlot;
 class TrendPlotEditDlg;
@@ -44,6 +47,10 @@ private slots:
     void on_actSettings_triggered(bool checked);
     void on_actConnect_triggered(bool checked);
     void on_actDisconnect_triggered(bool checked);
+    void on_actListenOnly_triggered(bool checked);
+    void on_actPdoAutoMapping_triggered(bool checked);
+    void on_actCanTrace_triggered(bool checked);
+    void on_actBusStats_triggered(bool checked);
     void on_actAddPlot_triggered(bool checked);
     void on_actEditPlot_triggered(bool checked);
     void on_actDelPlot_triggered(bool checked);
@@ -65,11 +72,13 @@ private slots:
 
     void CANopen_connected();
     void CANopen_disconnected();
+    void pdoMapper_finished(bool ok);
 private:
     Ui::CanOpenWin *ui;
     //SDOValuePlot* m_plot;
     SLCanOpenNode* m_slcon;
     CoValuesHolder* m_valsHolder;
+    COPdoMapper* m_pdoMapper;
     QGridLayout* m_layout;
     QMenu* m_cockpitMenu;
     QMenu* m_plotsMenu;
@@ -88,11 +97,16 @@ private:
     SDOValueBarEditDlg* m_barDlg;
     SDOValueButtonEditDlg* m_buttonDlg;
     SDOValueIndicatorEditDlg* m_indicatorDlg;
+    CanTraceDlg* m_canTraceDlg;
+    CanBusStatsDlg* m_busStatsDlg;
 
     void applySettings();
     void clearCockpitWidgets();
     CockpitSerializer::CockpitWidgets collectCockpitWidgets();
     void appendCockpitWidgets(const CockpitSerializer::CockpitWidgets& widgets);
+    // compound reads of the cockpit are registered on the values holder.
+    void clearCockpitCompounds();
+    void appendCockpitCompounds(const CockpitSerializer::CockpitCompounds& compounds);
 
     template <typename WidgetType>
     WidgetType* findWidgetTypeAt(const QPoint& pos);
@@ -0,0 +1,137 @@
+#include "cantracebuffer.h"
+#include <new>
+#include <string.h>
+
+
+#define CAN_TRACE_TIMESTAMP_MASK 0xffffffffffULL
+#define CAN_TRACE_ID_SHIFT 40
+#define CAN_TRACE_ID_MASK 0x7ff
+#define CAN_TRACE_RTR_SHIFT 51
+#define CAN_TRACE_TX_SHIFT 52
+#define CAN_TRACE_DLC_SHIFT 53
+#define CAN_TRACE_DLC_MASK 0xf
+
+
+
+CanTraceBuffer::CanTraceBuffer(size_t newCapacity)
+{
+    m_capacity = std::max(newCapacity, static_cast<size_t>(1));
+    m_enabled = false;
+    m_firstSeq = 0;
+    m_endSeq = 0;
+    m_startTp = meas_clock::now();
+}
+
+CanTraceBuffer::~CanTraceBuffer()
+{
+}
+
+bool CanTraceBuffer::enabled() const
+{
+    return m_enabled;
+}
+
+void CanTraceBuffer::setEnabled(bool newEnabled)
+{
+    if(m_enabled == newEnabled) return;
+
+    if(newEnabled){
+        m_records.reset(new (std::nothrow) Record[m_capacity]);
+        if(m_records == nullptr) return;
+    }else{
+        m_records.reset();
+    }
+
+    m_enabled = newEnabled;
+
+    clear();
+}
+
+size_t CanTraceBuffer::capacity() const
+{
+    return m_capacity;
+}
+
+void CanTraceBuffer::setCapacity(size_t newCapacity)
+{
+    bool wasEnabled = m_enabled;
+
+    setEnabled(false);
+
+    m_capacity = std::max(newCapacity, static_cast<size_t>(1));
+
+    setEnabled(wasEnabled);
+}
+
+void CanTraceBuffer::put(quint16 id, bool rtr, bool tx, quint8 dlc, const quint8* data)
+{
+    if(!m_enabled) return;
+
+    quint64 seq = m_endSeq;
+
+    // the oldest record is overwritten.
+    if(seq - m_firstSeq >= m_capacity){
+        m_firstSeq = seq - m_capacity + 1;
+    }
+
+    quint64 ts = std::chrono::duration_cast<std::chrono::microseconds>(meas_clock::now() - m_startTp).count();
+
+    dlc = std::min(dlc, static_cast<quint8>(8));
+
+    Record& rec = m_records[seq % m_capacity];
+
+    rec.header = (ts & CAN_TRACE_TIMESTAMP_MASK) |
+                 (static_cast<quint64>(id & CAN_TRACE_ID_MASK) << CAN_TRACE_ID_SHIFT) |
+                 (static_cast<quint64>(rtr) << CAN_TRACE_RTR_SHIFT) |
+                 (static_cast<quint64>(tx) << CAN_TRACE_TX_SHIFT) |
+                 (static_cast<quint64>(dlc & CAN_TRACE_DLC_MASK) << CAN_TRACE_DLC_SHIFT);
+
+    memset(rec.data, 0x0, sizeof(rec.data));
+    if(!rtr && data != nullptr) memcpy(rec.data, data, dlc);
+
+    m_endSeq = seq + 1;
+}
+
+void CanTraceBuffer::clear()
+{
+    m_firstSeq = m_endSeq;
+    m_startTp = meas_clock::now();
+}
+
+quint64 CanTraceBuffer::firstSeq() const
+{
+    return m_firstSeq;
+}
+
+quint64 CanTraceBuffer::endSeq() const
+{
+    return m_endSeq;
+}
+
+quint64 CanTraceBuffer::count() const
+{
+    return endSeq() - firstSeq();
+}
+
+bool CanTraceBuffer::get(quint64 seq, Frame* frame) const
+{
+    if(frame == nullptr) return false;
+    if(!m_enabled) return false;
+
+    if(seq < firstSeq() || seq >= endSeq()) return false;
+
+    unpack(m_records[seq % m_capacity], seq, frame);
+
+    return true;
+}
+
+void CanTraceBuffer::unpack(const Record& rec, quint64 seq, Frame* frame) const
+{
+    frame->seq = seq;
+    frame->timestamp = rec.header & CAN_TRACE_TIMESTAMP_MASK;
+    frame->id = (rec.header >> CAN_TRACE_ID_SHIFT) & CAN_TRACE_ID_MASK;
+    frame->rtr = (rec.header >> CAN_TRACE_RTR_SHIFT) & 0x1;
+    frame->tx = (rec.header >> CAN_TRACE_TX_SHIFT) & 0x1;
+    frame->dlc = (rec.header >> CAN_TRACE_DLC_SHIFT) & CAN_TRACE_DLC_MASK;
+    memcpy(frame->data, rec.data, sizeof(frame->data));
+}
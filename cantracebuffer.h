@@ -0,0 +1,116 @@
+#ifndef CANTRACEBUFFER_H
+#define CANTRACEBUFFER_H
+
+#include <QtGlobal>
+#include <stddef.h>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+
+
+/*
+ * Raw CAN frames ring buffer.
+ * Frames are packed to 16 byte records,
+ * the oldest frames are overwritten.
+ * Frames are addressed by the sequence number,
+ * the writer and the readers are in the GUI thread.
+ */
+class CanTraceBuffer
+{
+public:
+
+    struct Frame {
+        quint64 seq;
+        // us from the buffer clear.
+        quint64 timestamp;
+        quint16 id;
+        bool rtr;
+        bool tx;
+        quint8 dlc;
+        quint8 data[8];
+    };
+
+    static const size_t DEFAULT_CAPACITY = 10000000;
+
+    explicit CanTraceBuffer(size_t newCapacity = DEFAULT_CAPACITY);
+    ~CanTraceBuffer();
+
+    // memory is allocated on enabling.
+    bool enabled() const;
+    void setEnabled(bool newEnabled);
+
+    size_t capacity() const;
+    // clear the buffer.
+    void setCapacity(size_t newCapacity);
+
+    void put(quint16 id, bool rtr, bool tx, quint8 dlc, const quint8* data);
+    void clear();
+
+    // sequence numbers of the frames in the buffer: [firstSeq, endSeq).
+    quint64 firstSeq() const;
+    quint64 endSeq() const;
+    quint64 count() const;
+
+    bool get(quint64 seq, Frame* frame) const;
+
+    // first frame in [fromSeq, toSeq) or
+    // last frame in [toSeq, fromSeq) if toSeq < fromSeq matched by pred.
+    template <typename Pred>
+    bool find(quint64 fromSeq, quint64 toSeq, Pred pred, quint64* foundSeq) const;
+
+private:
+    // timestamp:40 | id:11 | rtr:1 | tx:1 | dlc:4.
+    struct Record {
+        quint64 header;
+        quint8 data[8];
+    };
+
+    static_assert(sizeof(Record) == 16, "Invalid trace record size!");
+
+    using meas_clock = std::chrono::steady_clock;
+
+    std::unique_ptr<Record[]> m_records;
+    size_t m_capacity;
+    bool m_enabled;
+
+    quint64 m_firstSeq;
+    quint64 m_endSeq;
+
+    meas_clock::time_point m_startTp;
+
+    void unpack(const Record& rec, quint64 seq, Frame* frame) const;
+};
+
+template <typename Pred>
+bool CanTraceBuffer::find(quint64 fromSeq, quint64 toSeq, Pred pred, quint64* foundSeq) const
+{
+    Frame frame;
+
+    if(fromSeq <= toSeq){
+        for(quint64 seq = std::max(fromSeq, firstSeq()); seq < toSeq; seq ++){
+            if(!get(seq, &frame)){
+                if(seq >= endSeq()) break;
+                continue;
+            }
+            if(pred(frame)){
+                if(foundSeq) *foundSeq = seq;
+                return true;
+            }
+        }
+    }else{
+        for(quint64 seq = std::min(fromSeq, endSeq()); seq > toSeq; seq --){
+            if(!get(seq - 1, &frame)){
+                if(seq - 1 < firstSeq()) break;
+                continue;
+            }
+            if(pred(frame)){
+                if(foundSeq) *foundSeq = seq - 1;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+#endif // CANTRACEBUFFER_H
@@ -0,0 +1,228 @@
+#include "cantracedlg.h"
+#include "ui_cantracedlg.h"
+#include "cantracebuffer.h"
+#include "cantracemodel.h"
+#include <QTimer>
+#include <QHeaderView>
+#include <QFontDatabase>
+#include <QStringList>
+
+
+#define CAN_TRACE_DLG_UPDATE_INTERVAL 100
+
+
+
+CanTraceDlg::CanTraceDlg(QWidget *parent) :
+    QDialog(parent),
+    ui(new Ui::CanTraceDlg)
+{
+    ui->setupUi(this);
+
+    m_traceBuffer = nullptr;
+
+    m_model = new CanTraceModel();
+    ui->tvFrames->setModel(m_model);
+
+    // fixed rows height - the view does not measure rows.
+    ui->tvFrames->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    ui->tvFrames->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->tvFrames->verticalHeader()->setDefaultSectionSize(ui->tvFrames->fontMetrics().height() + 4);
+    ui->tvFrames->verticalHeader()->hide();
+    ui->tvFrames->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    ui->tvFrames->horizontalHeader()->setStretchLastSection(true);
+
+    m_updateTimer = new QTimer();
+    m_updateTimer->setInterval(CAN_TRACE_DLG_UPDATE_INTERVAL);
+    m_updateTimer->setSingleShot(false);
+    connect(m_updateTimer, &QTimer::timeout, this, &CanTraceDlg::updateTrace);
+}
+
+CanTraceDlg::~CanTraceDlg()
+{
+    delete m_updateTimer;
+    delete m_model;
+    delete ui;
+}
+
+CanTraceBuffer* CanTraceDlg::traceBuffer() const
+{
+    return m_traceBuffer;
+}
+
+void CanTraceDlg::setTraceBuffer(CanTraceBuffer* newTraceBuffer)
+{
+    m_traceBuffer = newTraceBuffer;
+    m_model->setBuffer(m_traceBuffer);
+
+    ui->cbTraceEnabled->blockSignals(true);
+    ui->cbTraceEnabled->setChecked(m_traceBuffer != nullptr && m_traceBuffer->enabled());
+    ui->cbTraceEnabled->blockSignals(false);
+
+    updateTrace();
+}
+
+void CanTraceDlg::showEvent(QShowEvent* event)
+{
+    QDialog::showEvent(event);
+
+    updateTrace();
+    m_updateTimer->start();
+}
+
+void CanTraceDlg::hideEvent(QHideEvent* event)
+{
+    m_updateTimer->stop();
+
+    QDialog::hideEvent(event);
+}
+
+void CanTraceDlg::updateTrace()
+{
+    m_model->update();
+
+    if(ui->cbAutoScroll->isChecked()){
+        ui->tvFrames->scrollToBottom();
+    }
+
+    quint64 count = (m_traceBuffer != nullptr) ? m_traceBuffer->count() : 0;
+    ui->lblFramesCount->setText(tr("Кадров: %1 / %2").arg(m_model->rowCount()).arg(count));
+}
+
+void CanTraceDlg::on_cbTraceEnabled_toggled(bool checked)
+{
+    if(m_traceBuffer == nullptr) return;
+
+    m_traceBuffer->setEnabled(checked);
+
+    if(m_traceBuffer->enabled() != checked){
+        ui->cbTraceEnabled->blockSignals(true);
+        ui->cbTraceEnabled->setChecked(m_traceBuffer->enabled());
+        ui->cbTraceEnabled->blockSignals(false);
+    }
+
+    updateTrace();
+}
+
+void CanTraceDlg::on_pbClear_clicked(bool checked)
+{
+    Q_UNUSED(checked)
+
+    if(m_traceBuffer == nullptr) return;
+
+    m_traceBuffer->clear();
+
+    updateTrace();
+}
+
+void CanTraceDlg::on_cbFilter_toggled(bool checked)
+{
+    Q_UNUSED(checked)
+
+    applyFilter();
+}
+
+void CanTraceDlg::on_sbFilterId_valueChanged(int value)
+{
+    Q_UNUSED(value)
+
+    if(ui->cbFilter->isChecked()) applyFilter();
+}
+
+void CanTraceDlg::on_sbFilterMask_valueChanged(int value)
+{
+    Q_UNUSED(value)
+
+    if(ui->cbFilter->isChecked()) applyFilter();
+}
+
+void CanTraceDlg::on_leSearch_returnPressed()
+{
+    findFrame(true);
+}
+
+void CanTraceDlg::on_pbFindNext_clicked(bool checked)
+{
+    Q_UNUSED(checked)
+
+    findFrame(true);
+}
+
+void CanTraceDlg::on_pbFindPrev_clicked(bool checked)
+{
+    Q_UNUSED(checked)
+
+    findFrame(false);
+}
+
+void CanTraceDlg::applyFilter()
+{
+    m_model->setFilter(ui->cbFilter->isChecked(),
+                       static_cast<quint16>(ui->sbFilterId->value()),
+                       static_cast<quint16>(ui->sbFilterMask->value()));
+
+    updateTrace();
+}
+
+bool CanTraceDlg::parseSearch(quint16* id, quint16* idMask, QByteArray* dataPrefix) const
+{
+    QStringList parts = ui->leSearch->text().trimmed().split('#');
+    if(parts.size() > 2) return false;
+
+    QString idStr = parts[0].trimmed();
+    if(idStr.isEmpty()){
+        *id = 0;
+        *idMask = 0;
+    }else{
+        bool ok = false;
+        uint val = idStr.toUInt(&ok, 16);
+        if(!ok || val > 0x7ff) return false;
+        *id = static_cast<quint16>(val);
+        *idMask = 0x7ff;
+    }
+
+    dataPrefix->clear();
+    if(parts.size() == 2){
+        QString dataStr = parts[1];
+        dataStr.remove(' ');
+        if(dataStr.size() % 2 != 0 || dataStr.size() > 16) return false;
+
+        for(int i = 0; i < dataStr.size(); i += 2){
+            bool ok = false;
+            uint val = dataStr.mid(i, 2).toUInt(&ok, 16);
+            if(!ok) return false;
+            dataPrefix->append(static_cast<char>(val));
+        }
+    }
+
+    return true;
+}
+
+void CanTraceDlg::findFrame(bool forward)
+{
+    quint16 id = 0;
+    quint16 idMask = 0;
+    QByteArray dataPrefix;
+
+    if(!parseSearch(&id, &idMask, &dataPrefix)){
+        ui->lblSearchStatus->setText(tr("Неверный шаблон!"));
+        return;
+    }
+
+    // stop following new frames.
+    ui->cbAutoScroll->setChecked(false);
+
+    QModelIndex cur = ui->tvFrames->currentIndex();
+    int fromRow = cur.isValid() ? cur.row() : -1;
+
+    int row = m_model->find(fromRow, forward, id, idMask, dataPrefix);
+    if(row < 0){
+        ui->lblSearchStatus->setText(tr("Не найдено."));
+        return;
+    }
+
+    ui->lblSearchStatus->clear();
+
+    QModelIndex mi = m_model->index(row, CanTraceModel::COL_ID);
+    ui->tvFrames->setCurrentIndex(mi);
+    ui->tvFrames->scrollTo(mi, QAbstractItemView::PositionAtCenter);
+}
@@ -0,0 +1,56 @@
+#ifndef CANTRACEDLG_H
+#define CANTRACEDLG_H
+
+#include <QDialog>
+#include <QByteArray>
+
+
+class QTimer;
+class CanTraceBuffer;
+class CanTraceModel;
+
+
+namespace Ui {
+class CanTraceDlg;
+}
+
+class CanTraceDlg : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit CanTraceDlg(QWidget *parent = nullptr);
+    ~CanTraceDlg();
+
+    CanTraceBuffer* traceBuffer() const;
+    void setTraceBuffer(CanTraceBuffer* newTraceBuffer);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+
+private slots:
+    void updateTrace();
+    void on_cbTraceEnabled_toggled(bool checked);
+    void on_pbClear_clicked(bool checked = false);
+    void on_cbFilter_toggled(bool checked);
+    void on_sbFilterId_valueChanged(int value);
+    void on_sbFilterMask_valueChanged(int value);
+    void on_leSearch_returnPressed();
+    void on_pbFindNext_clicked(bool checked = false);
+    void on_pbFindPrev_clicked(bool checked = false);
+
+private:
+    Ui::CanTraceDlg *ui;
+
+    CanTraceBuffer* m_traceBuffer;
+    CanTraceModel* m_model;
+    QTimer* m_updateTimer;
+
+    void applyFilter();
+    // "ID[#DATA]" in hex.
+    bool parseSearch(quint16* id, quint16* idMask, QByteArray* dataPrefix) const;
+    void findFrame(bool forward);
+};
+
+#endif // CANTRACEDLG_H
@@ -0,0 +1,354 @@
+#include "cantracemodel.h"
+#include <QString>
+#include <QStringList>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <string.h>
+
+
+
+CanTraceModel::CanTraceModel(CanTraceBuffer* buffer, QObject *parent)
+    : QAbstractTableModel(parent)
+{
+    m_buffer = buffer;
+    m_firstSeq = 0;
+    m_endSeq = 0;
+    m_filterEnabled = false;
+    m_filterId = 0;
+    m_filterMask = 0;
+    m_firstBlock = 0;
+    m_firstRow = 0;
+    m_endRow = 0;
+
+    rebuild();
+    update();
+}
+
+CanTraceModel::~CanTraceModel()
+{
+}
+
+CanTraceBuffer* CanTraceModel::buffer() const
+{
+    return m_buffer;
+}
+
+void CanTraceModel::setBuffer(CanTraceBuffer* newBuffer)
+{
+    m_buffer = newBuffer;
+
+    rebuild();
+    update();
+}
+
+bool CanTraceModel::filterEnabled() const
+{
+    return m_filterEnabled;
+}
+
+void CanTraceModel::setFilter(bool newEnabled, quint16 newId, quint16 newMask)
+{
+    m_filterEnabled = newEnabled;
+    m_filterId = newId;
+    m_filterMask = newMask;
+
+    rebuild();
+    update();
+}
+
+quint64 CanTraceModel::rowSeq(int row) const
+{
+    if(!m_filterEnabled) return m_firstSeq + row;
+
+    quint64 absRow = m_firstRow + row;
+
+    // last block started before the row.
+    auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), absRow,
+                               [](quint64 r, const Block& block){ return r < block.startRow; });
+    if(it == m_blocks.begin()) return m_endSeq;
+    -- it;
+
+    quint64 n = absRow - it->startRow;
+    if(n >= it->rows) return m_endSeq;
+
+    quint64 blockSeq = (m_firstBlock + std::distance(m_blocks.begin(), it)) * BLOCK_SIZE;
+
+    for(size_t i = 0; i < it->bits.size(); i ++){
+        quint64 word = it->bits[i];
+        uint wordRows = qPopulationCount(word);
+
+        if(n < wordRows){
+            for(; n > 0; n --) word &= word - 1;
+            return blockSeq + i * 64 + qCountTrailingZeroBits(word);
+        }
+
+        n -= wordRows;
+    }
+
+    return m_endSeq;
+}
+
+int CanTraceModel::seqRow(quint64 seq) const
+{
+    if(seq < m_firstSeq || seq >= m_endSeq) return -1;
+
+    if(!m_filterEnabled) return static_cast<int>(seq - m_firstSeq);
+
+    const Block& block = m_blocks[seq / BLOCK_SIZE - m_firstBlock];
+    quint64 offset = seq % BLOCK_SIZE;
+
+    if(block.bits.empty() || (block.bits[offset / 64] & (1ULL << (offset % 64))) == 0) return -1;
+
+    return static_cast<int>(absRow(seq) - m_firstRow);
+}
+
+int CanTraceModel::find(int fromRow, bool forward, quint16 id, quint16 idMask, const QByteArray& dataPrefix) const
+{
+    if(m_buffer == nullptr) return -1;
+
+    int rows = rowCount();
+    if(rows == 0) return -1;
+
+    // search on the buffer, not on the rows.
+    auto pred = [this, id, idMask, &dataPrefix](const CanTraceBuffer::Frame& frame){
+        if(((frame.id ^ id) & idMask) != 0) return false;
+        if(!filterMatch(frame)) return false;
+        if(dataPrefix.size() > frame.dlc) return false;
+        return memcmp(frame.data, dataPrefix.constData(), dataPrefix.size()) == 0;
+    };
+
+    quint64 seq = 0;
+    bool found = false;
+
+    if(forward){
+        quint64 fromSeq = (fromRow < 0) ? m_firstSeq : rowSeq(std::min(fromRow, rows - 1)) + 1;
+        found = m_buffer->find(fromSeq, m_endSeq, pred, &seq);
+    }else{
+        quint64 fromSeq = (fromRow < 0 || fromRow >= rows) ? m_endSeq : rowSeq(fromRow);
+        found = m_buffer->find(fromSeq, m_firstSeq, pred, &seq);
+    }
+
+    if(!found) return -1;
+
+    return seqRow(seq);
+}
+
+int CanTraceModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    if(m_filterEnabled) return static_cast<int>(m_endRow - m_firstRow);
+
+    return static_cast<int>(m_endSeq - m_firstSeq);
+}
+
+int CanTraceModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return COL_COUNT;
+}
+
+QVariant CanTraceModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid())
+        return QVariant();
+
+    if(role != Qt::DisplayRole)
+        return QVariant();
+
+    if(m_buffer == nullptr) return QVariant();
+    if(index.row() >= rowCount()) return QVariant();
+
+    CanTraceBuffer::Frame frame;
+    if(!m_buffer->get(rowSeq(index.row()), &frame)) return QVariant();
+
+    switch(index.column()){
+    case COL_TIME:
+        return QString::number(static_cast<double>(frame.timestamp) / 1000000, 'f', 6);
+    case COL_DIR:
+        return frame.tx ? QStringLiteral("Tx") : QStringLiteral("Rx");
+    case COL_ID:
+        return QString("%1").arg(frame.id, 3, 16, QChar('0')).toUpper();
+    case COL_DLC:
+        return frame.dlc;
+    case COL_DATA:{
+        if(frame.rtr) return QStringLiteral("RTR");
+
+        QStringList bytes;
+        for(int i = 0; i < frame.dlc; i ++){
+            bytes.append(QString("%1").arg(frame.data[i], 2, 16, QChar('0')).toUpper());
+        }
+        return bytes.join(' ');
+        }
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+QVariant CanTraceModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if(role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return QVariant();
+
+    switch(section){
+    case COL_TIME:
+        return tr("Время, с");
+    case COL_DIR:
+        return tr("Напр.");
+    case COL_ID:
+        return tr("ID");
+    case COL_DLC:
+        return tr("DLC");
+    case COL_DATA:
+        return tr("Данные");
+    default:
+        break;
+    }
+
+    return QVariant();
+}
+
+void CanTraceModel::update()
+{
+    if(m_buffer == nullptr) return;
+
+    quint64 first = m_buffer->firstSeq();
+    quint64 end = m_buffer->endSeq();
+
+    // unscanned frames are overwritten or the buffer is cleared.
+    if(first > m_endSeq || end < m_endSeq){
+        rebuild();
+    }
+
+    // drop overwritten or cleared rows.
+    if(first > m_firstSeq){
+        if(m_filterEnabled){
+            dropRows(first);
+        }else{
+            beginRemoveRows(QModelIndex(), 0, static_cast<int>(first - m_firstSeq) - 1);
+            m_firstSeq = first;
+            endRemoveRows();
+        }
+    }
+
+    if(end == m_endSeq) return;
+
+    // append new rows.
+    if(m_filterEnabled){
+        // large buffer is scanned in the several updates.
+        quint64 scanEnd = std::min(end, m_endSeq + SCAN_FRAMES_MAX);
+        quint64 endRow = scanRows(scanEnd);
+
+        if(endRow != m_endRow){
+            int rows = rowCount();
+            beginInsertRows(QModelIndex(), rows, rows + static_cast<int>(endRow - m_endRow) - 1);
+            m_endRow = endRow;
+            m_endSeq = scanEnd;
+            endInsertRows();
+        }else{
+            m_endSeq = scanEnd;
+        }
+    }else{
+        int rows = rowCount();
+        beginInsertRows(QModelIndex(), rows, rows + static_cast<int>(end - m_endSeq) - 1);
+        m_endSeq = end;
+        endInsertRows();
+    }
+}
+
+bool CanTraceModel::filterMatch(const CanTraceBuffer::Frame& frame) const
+{
+    if(!m_filterEnabled) return true;
+
+    return ((frame.id ^ m_filterId) & m_filterMask) == 0;
+}
+
+quint64 CanTraceModel::absRow(quint64 seq) const
+{
+    if(seq >= m_endSeq) return m_endRow;
+
+    const Block& block = m_blocks[seq / BLOCK_SIZE - m_firstBlock];
+    quint64 offset = seq % BLOCK_SIZE;
+    quint64 row = block.startRow;
+
+    if(block.bits.empty()) return row;
+
+    for(size_t i = 0; i < offset / 64; i ++){
+        row += qPopulationCount(block.bits[i]);
+    }
+    if(offset % 64 != 0){
+        row += qPopulationCount(block.bits[offset / 64] & ((1ULL << (offset % 64)) - 1));
+    }
+
+    return row;
+}
+
+void CanTraceModel::dropRows(quint64 first)
+{
+    quint64 firstRow = absRow(first);
+
+    // the first block may remain partially overwritten.
+    while(!m_blocks.empty() && (m_firstBlock + 1) * BLOCK_SIZE <= first){
+        m_blocks.pop_front();
+        m_firstBlock ++;
+    }
+
+    if(firstRow > m_firstRow){
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(firstRow - m_firstRow) - 1);
+        m_firstRow = firstRow;
+        m_firstSeq = first;
+        endRemoveRows();
+    }else{
+        m_firstSeq = first;
+    }
+}
+
+quint64 CanTraceModel::scanRows(quint64 end)
+{
+    quint64 row = m_endRow;
+
+    if(m_blocks.empty()) m_firstBlock = m_endSeq / BLOCK_SIZE;
+
+    CanTraceBuffer::Frame frame;
+    for(quint64 seq = m_endSeq; seq < end; seq ++){
+        quint64 blockIndex = seq / BLOCK_SIZE - m_firstBlock;
+
+        if(blockIndex == m_blocks.size()){
+            m_blocks.push_back(Block{row, 0, std::vector<quint64>()});
+        }
+
+        if(!m_buffer->get(seq, &frame) || !filterMatch(frame)) continue;
+
+        Block& block = m_blocks[blockIndex];
+        quint64 offset = seq % BLOCK_SIZE;
+
+        if(block.bits.empty()) block.bits.resize(BLOCK_SIZE / 64, 0);
+        block.bits[offset / 64] |= 1ULL << (offset % 64);
+        block.rows ++;
+
+        row ++;
+    }
+
+    return row;
+}
+
+void CanTraceModel::rebuild()
+{
+    beginResetModel();
+
+    m_blocks.clear();
+    m_firstRow = 0;
+    m_endRow = 0;
+
+    // frames are scanned on update.
+    m_firstSeq = (m_buffer != nullptr) ? m_buffer->firstSeq() : 0;
+    m_endSeq = m_firstSeq;
+    m_firstBlock = m_firstSeq / BLOCK_SIZE;
+
+    endResetModel();
+}
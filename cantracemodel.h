@@ -0,0 +1,99 @@
+#ifndef CANTRACEMODEL_H
+#define CANTRACEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QByteArray>
+#include <deque>
+#include <vector>
+#include "cantracebuffer.h"
+
+
+/*
+ * Virtual table of the trace buffer frames.
+ * Rows are not stored, filtered frames are indexed
+ * by the match bitmaps of the frames blocks,
+ * the buffer is scanned incrementally on update.
+ */
+class CanTraceModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+
+    enum Column {
+        COL_TIME = 0,
+        COL_DIR,
+        COL_ID,
+        COL_DLC,
+        COL_DATA,
+        COL_COUNT
+    };
+
+    explicit CanTraceModel(CanTraceBuffer* buffer = nullptr, QObject *parent = nullptr);
+    ~CanTraceModel();
+
+    CanTraceBuffer* buffer() const;
+    void setBuffer(CanTraceBuffer* newBuffer);
+
+    // show frames with (frame.id & mask) == (id & mask).
+    bool filterEnabled() const;
+    void setFilter(bool newEnabled, quint16 newId, quint16 newMask);
+
+    quint64 rowSeq(int row) const;
+    // -1 if the frame is not shown.
+    int seqRow(quint64 seq) const;
+
+    // find the frame with the id and data prefix after or before the row,
+    // -1 if not found.
+    int find(int fromRow, bool forward, quint16 id, quint16 idMask, const QByteArray& dataPrefix) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public slots:
+    // sync rows with the buffer.
+    void update();
+
+private:
+    // frames matched the filter in the block of the BLOCK_SIZE frames.
+    struct Block {
+        // absolute row of the first matched frame.
+        quint64 startRow;
+        quint32 rows;
+        // empty if nothing matched.
+        std::vector<quint64> bits;
+    };
+
+    static const quint64 BLOCK_SIZE = 4096;
+    // frames scanned per update.
+    static const quint64 SCAN_FRAMES_MAX = 1048576;
+
+    CanTraceBuffer* m_buffer;
+
+    // scanned frames: [m_firstSeq, m_endSeq).
+    quint64 m_firstSeq;
+    quint64 m_endSeq;
+
+    bool m_filterEnabled;
+    quint16 m_filterId;
+    quint16 m_filterMask;
+
+    // blocks from the m_firstBlock with the scanned frames.
+    std::deque<Block> m_blocks;
+    quint64 m_firstBlock;
+    // absolute rows: [m_firstRow, m_endRow).
+    quint64 m_firstRow;
+    quint64 m_endRow;
+
+    bool filterMatch(const CanTraceBuffer::Frame& frame) const;
+    // absolute row of the first matched frame since the seq.
+    quint64 absRow(quint64 seq) const;
+    void dropRows(quint64 first);
+    // scan frames up to the end, returns the end row.
+    quint64 scanRows(quint64 end);
+    void rebuild();
+};
+
+#endif // CANTRACEMODEL_H
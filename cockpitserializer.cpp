@@ -37,7 +37,7 @@ void CockpitSerializer::setSdoValuesHolder(CoValuesHolder* newSdoValuesHolder)
     m_valsHolder = newSdoValuesHolder;
 }
 
-bool CockpitSerializer::serialize(QIODevice* dev, const CockpitWidgets& widgets) const
+bool CockpitSerializer::serialize(QIODevice* dev, const CockpitWidgets& widgets, const CockpitCompounds& compounds) const
 {
     if(!dev->isWritable()) return false;
 
@@ -50,7 +50,7 @@ bool CockpitSerializer::serialize(QIODevice* dev, const CockpitWidgets& widgets)
 
     bool res = false;
 
-    res = writeCockpit(xml, widgets);
+    res = writeCockpit(xml, widgets, compounds);
 
     xml.writeEndElement();
     xml.writeEndDocument();
@@ -63,7 +63,7 @@ bool CockpitSerializer::serialize(QIODevice* dev, const CockpitWidgets& widgets)
     return true;
 }
 
-CockpitSerializer::CockpitWidgets CockpitSerializer::deserialize(QIODevice* dev, bool* isOk) const
+CockpitSerializer::CockpitWidgets CockpitSerializer::deserialize(QIODevice* dev, bool* isOk, CockpitCompounds* compounds) const
 {
     CockpitWidgets widgets;
 
@@ -78,7 +78,7 @@ CockpitSerializer::CockpitWidgets CockpitSerializer::deserialize(QIODevice* dev,
         xml.readNextStartElement();
     }
 
-    widgets = readCockpit(xml, isOk);
+    widgets = readCockpit(xml, isOk, compounds);
 
     return widgets;
 }
@@ -131,9 +131,10 @@ double CockpitSerializer::realValue(const QString& str, double defVal) const
     return defVal;
 }
 
-CockpitSerializer::CockpitWidgets CockpitSerializer::readCockpit(QXmlStreamReader& xml, bool* isOk) const
+CockpitSerializer::CockpitWidgets CockpitSerializer::readCockpit(QXmlStreamReader& xml, bool* isOk, CockpitCompounds* compounds) const
 {
     CockpitWidgets widgets;
+    CockpitCompounds readCompounds;
 
     if(!xml.isStartElement() || xml.name() != "cockpit"){
         if(isOk) *isOk = false;
@@ -161,6 +162,17 @@ CockpitSerializer::CockpitWidgets CockpitSerializer::readCockpit(QXmlStreamReade
             done = true;
             break;
         case QXmlStreamReader::StartElement:{
+                if(xml.name() == "compoundRead"){
+                    CoValuesHolder::CompoundRead compound;
+                    if(!readCompoundRead(xml, &compound)){
+                        res = false;
+                        done = true;
+                        break;
+                    }
+                    readCompounds.append(compound);
+                    break;
+                }
+
                 QRect r = readPosAttribs(xml);
 
                 if(auto rdw = readSDOValuePlot(xml)){
@@ -224,16 +236,25 @@ CockpitSerializer::CockpitWidgets CockpitSerializer::readCockpit(QXmlStreamReade
             delete p.first;
         }
         widgets.clear();
+        readCompounds.clear();
     }
 
+    if(compounds) *compounds = readCompounds;
+
     if(isOk) *isOk = res;
     return widgets;
 }
 
-bool CockpitSerializer::writeCockpit(QXmlStreamWriter& xml, const CockpitWidgets& widgets) const
+bool CockpitSerializer::writeCockpit(QXmlStreamWriter& xml, const CockpitWidgets& widgets, const CockpitCompounds& compounds) const
 {
     bool res = true;
 
+    // compound reads are registered before the widgets.
+    for(const auto& compound: compounds){
+        res = writeCompoundRead(xml, compound);
+        if(res == false) return res;
+    }
+
     for(const auto& p: widgets){
         QWidget* w = p.first;
         const QRect& pos = p.second;
@@ -298,7 +319,7 @@ void CockpitSerializer::writePosAttribs(QXmlStreamWriter& xml, const QRect& pos)
     xml.writeAttribute("colSpan", QString::number(pos.height()));
 }
 
-std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> CockpitSerializer::readCoAttribs(QXmlStreamReader& xml) const
+bool CockpitSerializer::readCoAttribs(QXmlStreamReader& xml, std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type>* co) const
 {
     auto attrs = xml.attributes();
     CO::NodeId nodeId = intValue(attrs.value("nodeId"), 0);
@@ -306,7 +327,11 @@ std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> CockpitSerializer
     CO::SubIndex subIndex = intValue(attrs.value("subIndex"), 0);
     COValue::Type type = static_cast<COValue::Type>(intValue(attrs.value("type"), 0));
 
-    return std::make_tuple(nodeId, index, subIndex, type);
+    if(!COValue::isValid(type)) return false;
+
+    *co = std::make_tuple(nodeId, index, subIndex, type);
+
+    return true;
 }
 
 void CockpitSerializer::writeCoAttribs(QXmlStreamWriter& xml, CO::NodeId nid, CO::Index idx, CO::SubIndex sidx, COValue::Type valtype) const
@@ -317,6 +342,106 @@ void CockpitSerializer::writeCoAttribs(QXmlStreamWriter& xml, CO::NodeId nid, CO
     xml.writeAttribute("type", QString::number(valtype));
 }
 
+bool CockpitSerializer::writeCompoundRead(QXmlStreamWriter& xml, const CoValuesHolder::CompoundRead& compound) const
+{
+    xml.writeStartElement("compoundRead");
+    xml.writeAttribute("nodeId", QString::number(compound.nodeId));
+    xml.writeAttribute("index", QString::number(compound.index));
+    xml.writeAttribute("subIndex", QString::number(compound.subIndex));
+    xml.writeAttribute("dataSize", QString::number(compound.dataSize));
+    xml.writeAttribute("period", QString::number(compound.period));
+
+    for(const auto& field: compound.fields){
+        xml.writeEmptyElement("field");
+        xml.writeAttribute("index", QString::number(field.index));
+        xml.writeAttribute("subIndex", QString::number(field.subIndex));
+        xml.writeAttribute("type", QString::number(field.type));
+        xml.writeAttribute("offset", QString::number(field.offset));
+    }
+
+    xml.writeEndElement();
+
+    return true;
+}
+
+bool CockpitSerializer::readCompoundRead(QXmlStreamReader& xml, CoValuesHolder::CompoundRead* compound) const
+{
+    if(!xml.isStartElement()) return false;
+    if(xml.name() != "compoundRead") return false;
+
+    auto attrs = xml.attributes();
+    compound->nodeId = intValue(attrs.value("nodeId"), 0);
+    compound->index = intValue(attrs.value("index"), 0);
+    compound->subIndex = intValue(attrs.value("subIndex"), 0);
+    compound->dataSize = uintValue(attrs.value("dataSize"), 0);
+    compound->period = intValue(attrs.value("period"), 0);
+    compound->fields.clear();
+
+    if(compound->dataSize == 0) return false;
+
+    bool done = false;
+    bool res = true;
+
+    while(!xml.atEnd() && !done){
+        auto token = xml.readNext();
+
+        switch(token){
+        case QXmlStreamReader::NoToken:
+        case QXmlStreamReader::Invalid:
+        case QXmlStreamReader::StartDocument:
+        case QXmlStreamReader::EndDocument:
+            res = false;
+            done = true;
+            break;
+        case QXmlStreamReader::StartElement:{
+            auto name = xml.name();
+            if(name == "field"){
+                auto fieldAttrs = xml.attributes();
+                CoValuesHolder::CompoundField field;
+                field.index = intValue(fieldAttrs.value("index"), 0);
+                field.subIndex = intValue(fieldAttrs.value("subIndex"), 0);
+                field.type = static_cast<COValue::Type>(intValue(fieldAttrs.value("type"), 0));
+                field.offset = uintValue(fieldAttrs.value("offset"), 0);
+
+                if(!COValue::isValid(field.type)){
+                    res = false;
+                    done = true;
+                    break;
+                }
+
+                compound->fields.append(field);
+                xml.skipCurrentElement();
+            }
+            else{
+#if defined(CS_ABORT_ON_UNKNOWN_ELEMENT) && CS_ABORT_ON_UNKNOWN_ELEMENT == 1
+                res = false;
+                done = true;
+#else
+                xml.skipCurrentElement();
+#endif
+            }
+        }break;
+        case QXmlStreamReader::EndElement:
+            done = true;
+            break;
+        case QXmlStreamReader::Characters:
+            if(!xml.isWhitespace()){
+                res = false;
+                done = true;
+            }
+            break;
+        case QXmlStreamReader::Comment:
+            break;
+        case QXmlStreamReader::DTD:
+        case QXmlStreamReader::EntityReference:
+        case QXmlStreamReader::ProcessingInstruction:
+            break;
+        }
+    }
+
+    return res && !compound->fields.isEmpty();
+}
+
 bool CockpitSerializer::writeSDOValuePlot(QXmlStreamWriter& xml, const SDOValuePlot* plt, const QRect& pos) const
 {
     xml.writeStartElement("SDOValuePlot");
@@ -329,6 +454,7 @@ bool CockpitSerializer::writeSDOValuePlot(QXmlStreamWriter& xml, const SDOValueP
     xml.writeTextElement("backgroundStyle", QString::number(plt->background().style()));
     xml.writeTextElement("textColor", QString::number(plt->textColor().rgb()));
     xml.writeTextElement("legendEnabled", QString::number(plt->legendItemEnabled()));
+    xml.writeTextElement("compactStorage", QString::number(plt->compactStorage()));
     xml.writeTextElement("signalsCount", QString::number(plt->signalsCount()));
     //xml.writeTextElement("period", QString::number(plt->period()));
     //xml.writeTextElement("", QString::number(plt->));
@@ -341,6 +467,10 @@ bool CockpitSerializer::writeSDOValuePlot(QXmlStreamWriter& xml, const SDOValueP
             writeCoAttribs(xml, sdoval->nodeId(), sdoval->index(),
                            sdoval->subIndex(), plt->SDOValueType(i));
         }
+        if(plt->SDOValueSamples(i) > 0){
+            xml.writeAttribute("samples", QString::number(plt->SDOValueSamples(i)));
+            xml.writeAttribute("samplePeriod", QString::number(plt->SDOValueSamplePeriod(i)));
+        }
 
         xml.writeTextElement("name", plt->signalName(i));
         xml.writeTextElement("z", QString::number(plt->z(i)));
@@ -350,6 +480,7 @@ bool CockpitSerializer::writeSDOValuePlot(QXmlStreamWriter& xml, const SDOValueP
         xml.writeTextElement("curveBrushColor", QString::number(plt->brush(i).color().rgba()));
         xml.writeTextElement("curveBrushStyle", QString::number(plt->brush(i).style()));
         xml.writeTextElement("baseLine", QString::number(plt->baseLine(i)));
+        xml.writeTextElement("pollPeriod", QString::number(plt->SDOValuePollPeriod(i)));
         xml.writeEndElement();
     }
 
@@ -410,6 +541,9 @@ SDOValuePlot* CockpitSerializer::readSDOValuePlot(QXmlStreamReader& xml) const
             else if(name == "legendEnabled"){
                 plt->setLegendItemEnabled(uintValue(xml.readElementText(), 0));
             }
+            else if(name == "compactStorage"){
+                plt->setCompactStorage(uintValue(xml.readElementText(), 0));
+            }
             else if(name == "signalsCount"){
                 countOfSignals = intValue(xml.readElementText(), 0);
             }
@@ -417,10 +551,21 @@ SDOValuePlot* CockpitSerializer::readSDOValuePlot(QXmlStreamReader& xml) const
                 plt->setPeriod(realValue(xml.readElementText(), 0));
             }*/
             else if(name == "signalCurve"){
-                auto co = readCoAttribs(xml);
-
-                bool added = plt->addSDOValue(std::get<0>(co), std::get<1>(co),
-                                              std::get<2>(co), std::get<3>(co));
+                std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> co;
+                if(!readCoAttribs(xml, &co)){
+                    res = false;
+                    done = true;
+                    break;
+                }
+                auto attrs = xml.attributes();
+                int samples = intValue(attrs.value("samples"), 0);
+                qreal samplePeriod = realValue(attrs.value("samplePeriod"), 0);
+
+                bool added = (samples > 0) ?
+                            plt->addSDOWaveform(std::get<0>(co), std::get<1>(co),
+                                                std::get<2>(co), std::get<3>(co), samples, samplePeriod) :
+                            plt->addSDOValue(std::get<0>(co), std::get<1>(co),
+                                             std::get<2>(co), std::get<3>(co));
                 if(!added){
                     res = false;
                     done = true;
@@ -497,6 +642,9 @@ bool CockpitSerializer::readSDOValuePlotSignalCurve(QXmlStreamReader& xml, SDOVa
             else if(name == "z"){
                 plt->setZ(signum, realValue(xml.readElementText(), 0));
             }
+            else if(name == "pollPeriod"){
+                plt->setSDOValuePollPeriod(signum, intValue(xml.readElementText(), 0));
+            }
             else if(name == "curveStyle"){
                 auto cs = static_cast<QwtPlotCurve::CurveStyle>(uintValue(xml.readElementText(), 0));
                 plt->setCurveStyle(signum, cs);
@@ -574,6 +722,9 @@ bool CockpitSerializer::writeSDOValueDial(QXmlStreamWriter& xml, const SDOValueD
     xml.writeTextElement("precision", QString::number(dl->precision()));
     xml.writeTextElement("rangeMin", QString::number(dl->rangeMin()));
     xml.writeTextElement("rangeMax", QString::number(dl->rangeMax()));
+    xml.writeTextElement("deadband", QString::number(dl->deadband()));
+    xml.writeTextElement("deadbandMode", QString::number(dl->deadbandMode()));
+    xml.writeTextElement("pollPeriod", QString::number(dl->pollPeriod()));
 
     xml.writeEndElement();
 
@@ -589,9 +740,9 @@ SDOValueDial* CockpitSerializer::readSDOValueDial(QXmlStreamReader& xml) const
 
     SDOValueDial* dl = new SDOValueDial(m_valsHolder);
 
-    auto co = readCoAttribs(xml);
+    std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> co;
 
-    if(!dl->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
+    if(!readCoAttribs(xml, &co) || !dl->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
         delete dl;
         return nullptr;
     }
@@ -615,6 +766,9 @@ SDOValueDial* CockpitSerializer::readSDOValueDial(QXmlStreamReader& xml) const
             if(name == "name"){
                 dl->setName(xml.readElementText());
             }
+            else if(name == "pollPeriod"){
+                dl->setPollPeriod(intValue(xml.readElementText(), 0));
+            }
             else if(name == "outsideBackColor"){
                 dl->setOutsideBackColor(QColor::fromRgb(uintValue(xml.readElementText(), 0)));
             }
@@ -642,6 +796,12 @@ SDOValueDial* CockpitSerializer::readSDOValueDial(QXmlStreamReader& xml) const
             else if(name == "rangeMax"){
                 dl->setRangeMax(realValue(xml.readElementText(), 0));
             }
+            else if(name == "deadband"){
+                dl->setDeadband(realValue(xml.readElementText(), 0), dl->deadbandMode());
+            }
+            else if(name == "deadbandMode"){
+                dl->setDeadband(dl->deadband(), static_cast<CoValuesHolder::DeadbandMode>(uintValue(xml.readElementText(), 0)));
+            }
             else{
 #if defined(CS_ABORT_ON_UNKNOWN_ELEMENT) && CS_ABORT_ON_UNKNOWN_ELEMENT == 1
                 res = false;
@@ -700,6 +860,7 @@ bool CockpitSerializer::writeSDOValueSlider(QXmlStreamWriter& xml, const SDOValu
     xml.writeTextElement("orientation", QString::number(sl->orientation()));
     xml.writeTextElement("rangeMin", QString::number(sl->rangeMin()));
     xml.writeTextElement("rangeMax", QString::number(sl->rangeMax()));
+    xml.writeTextElement("pollPeriod", QString::number(sl->pollPeriod()));
 
     xml.writeEndElement();
 
@@ -715,9 +876,9 @@ SDOValueSlider* CockpitSerializer::readSDOValueSlider(QXmlStreamReader& xml) con
 
     SDOValueSlider* sl = new SDOValueSlider(m_valsHolder);
 
-    auto co = readCoAttribs(xml);
+    std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> co;
 
-    if(!sl->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
+    if(!readCoAttribs(xml, &co) || !sl->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
         delete sl;
         return nullptr;
     }
@@ -743,6 +904,9 @@ SDOValueSlider* CockpitSerializer::readSDOValueSlider(QXmlStreamReader& xml) con
             if(name == "name"){
                 sl->setName(xml.readElementText());
             }
+            else if(name == "pollPeriod"){
+                sl->setPollPeriod(intValue(xml.readElementText(), 0));
+            }
             else if(name == "troughColor"){
                 sl->setTroughColor(QColor::fromRgb(uintValue(xml.readElementText(), 0)));
             }
@@ -839,6 +1003,9 @@ bool CockpitSerializer::writeSDOValueBar(QXmlStreamWriter& xml, const SDOValueBa
     xml.writeTextElement("alarmEnabled", QString::number(br->alarmEnabled()));
     xml.writeTextElement("rangeMin", QString::number(br->rangeMin()));
     xml.writeTextElement("rangeMax", QString::number(br->rangeMax()));
+    xml.writeTextElement("deadband", QString::number(br->deadband()));
+    xml.writeTextElement("deadbandMode", QString::number(br->deadbandMode()));
+    xml.writeTextElement("pollPeriod", QString::number(br->pollPeriod()));
 
     xml.writeEndElement();
 
@@ -854,9 +1021,9 @@ SDOValueBar* CockpitSerializer::readSDOValueBar(QXmlStreamReader& xml) const
 
     SDOValueBar* br = new SDOValueBar(m_valsHolder);
 
-    auto co = readCoAttribs(xml);
+    std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> co;
 
-    if(!br->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
+    if(!readCoAttribs(xml, &co) || !br->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
         delete br;
         return nullptr;
     }
@@ -882,6 +1049,9 @@ SDOValueBar* CockpitSerializer::readSDOValueBar(QXmlStreamReader& xml) const
             if(name == "name"){
                 br->setName(xml.readElementText());
             }
+            else if(name == "pollPeriod"){
+                br->setPollPeriod(intValue(xml.readElementText(), 0));
+            }
             else if(name == "barBackColor"){
                 br->setBarBackColor(QColor::fromRgb(uintValue(xml.readElementText(), 0)));
             }
@@ -924,6 +1094,12 @@ SDOValueBar* CockpitSerializer::readSDOValueBar(QXmlStreamReader& xml) const
             else if(name == "rangeMax"){
                 br->setRangeMax(realValue(xml.readElementText(), 0));
             }
+            else if(name == "deadband"){
+                br->setDeadband(realValue(xml.readElementText(), 0), br->deadbandMode());
+            }
+            else if(name == "deadbandMode"){
+                br->setDeadband(br->deadband(), static_cast<CoValuesHolder::DeadbandMode>(uintValue(xml.readElementText(), 0)));
+            }
             else{
 #if defined(CS_ABORT_ON_UNKNOWN_ELEMENT) && CS_ABORT_ON_UNKNOWN_ELEMENT == 1
                 res = false;
@@ -984,6 +1160,7 @@ bool CockpitSerializer::writeSDOValueButton(QXmlStreamWriter& xml, const SDOValu
     xml.writeTextElement("indicatorCompare", QString::number(btn->indicatorCompare()));
     xml.writeTextElement("indicatorValue", QString::number(btn->indicatorValue()));
     xml.writeTextElement("activateValue", QString::number(btn->activateValue()));
+    xml.writeTextElement("pollPeriod", QString::number(btn->pollPeriod()));
 
     xml.writeEndElement();
 
@@ -999,9 +1176,9 @@ SDOValueButton* CockpitSerializer::readSDOValueButton(QXmlStreamReader& xml) con
 
     SDOValueButton* btn = new SDOValueButton(m_valsHolder);
 
-    auto co = readCoAttribs(xml);
+    std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> co;
 
-    if(!btn->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
+    if(!readCoAttribs(xml, &co) || !btn->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
         delete btn;
         return nullptr;
     }
@@ -1027,6 +1204,9 @@ SDOValueButton* CockpitSerializer::readSDOValueButton(QXmlStreamReader& xml) con
             if(name == "text"){
                 btn->setText(xml.readElementText());
             }
+            else if(name == "pollPeriod"){
+                btn->setPollPeriod(intValue(xml.readElementText(), 0));
+            }
             else if(name == "buttonColor"){
                 btn->setButtonColor(QColor::fromRgb(uintValue(xml.readElementText(), 0)));
             }
@@ -1126,6 +1306,7 @@ bool CockpitSerializer::writeSDOValueIndicator(QXmlStreamWriter& xml, const SDOV
     xml.writeTextElement("fontBold", QString::number(ind->fontBold()));
     xml.writeTextElement("indicatorCompare", QString::number(ind->indicatorCompare()));
     xml.writeTextElement("indicatorValue", QString::number(ind->indicatorValue()));
+    xml.writeTextElement("pollPeriod", QString::number(ind->pollPeriod()));
 
     xml.writeEndElement();
 
@@ -1141,9 +1322,9 @@ SDOValueIndicator* CockpitSerializer::readSDOValueIndicator(QXmlStreamReader& xm
 
     SDOValueIndicator* ind = new SDOValueIndicator(m_valsHolder);
 
-    auto co = readCoAttribs(xml);
+    std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> co;
 
-    if(!ind->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
+    if(!readCoAttribs(xml, &co) || !ind->setSDOValue(std::get<0>(co), std::get<1>(co), std::get<2>(co), std::get<3>(co))){
         delete ind;
         return nullptr;
     }
@@ -1169,6 +1350,9 @@ SDOValueIndicator* CockpitSerializer::readSDOValueIndicator(QXmlStreamReader& xm
             if(name == "text"){
                 ind->setText(xml.readElementText());
             }
+            else if(name == "pollPeriod"){
+                ind->setPollPeriod(intValue(xml.readElementText(), 0));
+            }
             else if(name == "backColor"){
                 ind->setBackColor(QColor::fromRgb(uintValue(xml.readElementText(), 0)));
             }
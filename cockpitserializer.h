@@ -7,6 +7,7 @@
 #include <tuple>
 #include "cotypes.h"
 #include "covaluetypes.h"
+#include "covaluesholder.h"
 
 class QIODevice;
 class QString;
@@ -19,13 +20,13 @@ class SDOValueButton;
 class SDOValueIndicator;
 class QXmlStreamWriter;
 class QXmlStreamReader;
-class CoValuesHolder;
 
 class CockpitSerializer
 {
 public:
 
     using CockpitWidgets = QList<QPair<QWidget*, QRect>>;
+    using CockpitCompounds = QList<CoValuesHolder::CompoundRead>;
 
     CockpitSerializer();
     ~CockpitSerializer();
@@ -33,8 +34,9 @@ public:
     CoValuesHolder* sdoValuesHolder() const;
     void setSdoValuesHolder(CoValuesHolder* newSdoValuesHolder);
 
-    bool serialize(QIODevice* dev, const CockpitWidgets& widgets) const;
-    CockpitWidgets deserialize(QIODevice* dev, bool* isOk = nullptr) const;
+    bool serialize(QIODevice* dev, const CockpitWidgets& widgets,
+                   const CockpitCompounds& compounds = CockpitCompounds()) const;
+    CockpitWidgets deserialize(QIODevice* dev, bool* isOk = nullptr, CockpitCompounds* compounds = nullptr) const;
 
 protected:
 
@@ -45,15 +47,19 @@ protected:
     double realValue(const QStringRef& str, double defVal = 0) const;
     double realValue(const QString& str, double defVal = 0) const;
 
-    CockpitWidgets readCockpit(QXmlStreamReader& xml, bool* isOk = nullptr) const;
-    bool writeCockpit(QXmlStreamWriter& xml, const CockpitWidgets& widgets) const;
+    CockpitWidgets readCockpit(QXmlStreamReader& xml, bool* isOk = nullptr, CockpitCompounds* compounds = nullptr) const;
+    bool writeCockpit(QXmlStreamWriter& xml, const CockpitWidgets& widgets, const CockpitCompounds& compounds) const;
 
     QRect readPosAttribs(QXmlStreamReader& xml) const;
     void writePosAttribs(QXmlStreamWriter& xml, const QRect& pos) const;
 
-    std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type> readCoAttribs(QXmlStreamReader& xml) const;
+    // false if the type is not valid.
+    bool readCoAttribs(QXmlStreamReader& xml, std::tuple<CO::NodeId, CO::Index, CO::SubIndex, COValue::Type>* co) const;
     void writeCoAttribs(QXmlStreamWriter& xml, CO::NodeId nid, CO::Index idx, CO::SubIndex sidx, COValue::Type valtype) const;
 
+    bool writeCompoundRead(QXmlStreamWriter& xml, const CoValuesHolder::CompoundRead& compound) const;
+    bool readCompoundRead(QXmlStreamReader& xml, CoValuesHolder::CompoundRead* compound) const;
+
     bool writeSDOValuePlot(QXmlStreamWriter& xml, const SDOValuePlot* plt, const QRect& pos) const;
     SDOValuePlot* readSDOValuePlot(QXmlStreamReader& xml) const;
     bool readSDOValuePlotSignalCurve(QXmlStreamReader& xml, SDOValuePlot* plt, int signum) const;
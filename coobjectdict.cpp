@@ -182,6 +182,17 @@ COObjectDict::Entry COObjectDict::entryByIndex(CO::Index entryIndex)
     return Entry(it);
 }
 
+COObjectDict::Entry COObjectDict::addVarEntry(CO::Index entryIndex, OD_size_t dataLength, OD_attr_t attr)
+{
+    Entry e = addEntry();
+    e.setIndex(entryIndex);
+    e.setObjType(VAR);
+    e.setSubEntriesCount(1);
+    e.setAttribute(attr);
+    e.setDataLength(dataLength);
+    return e;
+}
+
 COObjectDict::Entry COObjectDict::add_H1000_DevType()
 {
     Entry e = addEntry();
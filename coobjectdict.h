@@ -218,6 +218,9 @@ public:
     Entry entryAt(int i);
     Entry entryByIndex(CO::Index entryIndex);
 
+    // Application variable (manufacturer / profile area).
+    Entry addVarEntry(CO::Index entryIndex, OD_size_t dataLength, OD_attr_t attr);
+
     Entry add_H1000_DevType();
     Entry add_H1001_ErrReg();
     Entry add_H1002_ManufStatusReg();
@@ -0,0 +1,454 @@
+#include "copdomapper.h"
+#include "slcanopennode.h"
+#include "covaluesholder.h"
+#include "sdovalue.h"
+#include "sdocomm.h"
+#include "canbusstats.h"
+#include <QMap>
+#include <QTimer>
+#include <algorithm>
+
+
+#define PDO_MAX_SIZE 8
+#define PDO_MAX_OBJECTS 8
+#define PDO_DEFAULT_EVENT_TIMER 100
+// SDO expedited transfer: request & response.
+#define SDO_FRAMES_PER_VALUE 2
+#define SDO_FRAME_DLC 8
+
+
+
+COPdoMapper::COPdoMapper(SLCanOpenNode* slcon, CoValuesHolder* valsHolder, QObject *parent)
+    : QObject{parent}
+{
+    m_slcon = slcon;
+    m_valsHolder = valsHolder;
+
+    m_maxPdosPerNode = 4;
+    m_eventTimer = 0;
+    m_valuesCount = 0;
+    m_curStep = -1;
+
+    m_sdoc = new SDOComm();
+    connect(m_sdoc, &SDOComm::finished, this, &COPdoMapper::sdocommFinished);
+}
+
+COPdoMapper::~COPdoMapper()
+{
+    cancel();
+
+    if(!m_sdoc->running()){
+        delete m_sdoc;
+    }else{
+        // keep steps data until the comm finished.
+        m_sdoc->disconnect();
+        auto stepsToDelete = m_steps;
+        SDOComm* sdoc = m_sdoc;
+        connect(sdoc, &SDOComm::finished, sdoc, [sdoc, stepsToDelete](){ sdoc->deleteLater(); });
+    }
+}
+
+SLCanOpenNode* COPdoMapper::getSLCanOpenNode()
+{
+    return m_slcon;
+}
+
+void COPdoMapper::setSLCanOpenNode(SLCanOpenNode* slcon)
+{
+    if(running()) cancel();
+
+    m_slcon = slcon;
+}
+
+CoValuesHolder* COPdoMapper::valuesHolder()
+{
+    return m_valsHolder;
+}
+
+void COPdoMapper::setValuesHolder(CoValuesHolder* valsHolder)
+{
+    m_valsHolder = valsHolder;
+}
+
+int COPdoMapper::maxPdosPerNode() const
+{
+    return m_maxPdosPerNode;
+}
+
+void COPdoMapper::setMaxPdosPerNode(int newMaxPdosPerNode)
+{
+    m_maxPdosPerNode = qBound(1, newMaxPdosPerNode, 512);
+}
+
+int COPdoMapper::eventTimer() const
+{
+    return m_eventTimer;
+}
+
+void COPdoMapper::setEventTimer(int newEventTimer)
+{
+    m_eventTimer = qBound(0, newEventTimer, 65535);
+}
+
+bool COPdoMapper::plan()
+{
+    if(running()) return false;
+
+    m_pdos.clear();
+    m_notMapped.clear();
+    m_failed.clear();
+    m_failedWrites.clear();
+    m_valuesCount = 0;
+
+    if(m_valsHolder == nullptr) return false;
+
+    QMap<CO::NodeId, QVector<Object>> nodesObjects;
+
+    for(auto sdoval: m_valsHolder->sdoValues()){
+        Object obj;
+        obj.nodeId = sdoval->nodeId();
+        obj.index = sdoval->index();
+        obj.subIndex = sdoval->subIndex();
+        obj.dataSize = sdoval->transferSize();
+
+        m_valuesCount ++;
+
+        if(obj.dataSize == 0 || obj.dataSize > PDO_MAX_SIZE){
+            m_notMapped.append(obj);
+            continue;
+        }
+
+        nodesObjects[obj.nodeId].append(obj);
+    }
+
+    QVector<Pdo> pdos;
+
+    // first fit decreasing.
+    for(auto it = nodesObjects.begin(); it != nodesObjects.end(); ++ it){
+        QVector<Object>& objects = it.value();
+
+        std::stable_sort(objects.begin(), objects.end(), [](const Object& lo, const Object& ro){
+            return lo.dataSize > ro.dataSize;
+        });
+
+        QVector<Pdo> nodePdos;
+
+        for(const auto& obj: objects){
+            auto pdoIt = std::find_if(nodePdos.begin(), nodePdos.end(), [&obj](const Pdo& pdo){
+                return pdo.dataSize + obj.dataSize <= PDO_MAX_SIZE && pdo.objects.size() < PDO_MAX_OBJECTS;
+            });
+
+            if(pdoIt != nodePdos.end()){
+                pdoIt->objects.append(obj);
+                pdoIt->dataSize += obj.dataSize;
+                continue;
+            }
+
+            if(nodePdos.size() >= m_maxPdosPerNode){
+                m_notMapped.append(obj);
+                continue;
+            }
+
+            Pdo pdo;
+            pdo.nodeId = obj.nodeId;
+            pdo.remoteTpdo = 0;
+            pdo.cobid = 0;
+            pdo.dataSize = obj.dataSize;
+            pdo.objects.append(obj);
+            pdo.applied = true;
+
+            nodePdos.append(pdo);
+        }
+
+        pdos.append(nodePdos);
+    }
+
+    // local RPDOs count is limited,
+    // PDOs with more values save more.
+    std::stable_sort(pdos.begin(), pdos.end(), [](const Pdo& lp, const Pdo& rp){
+        return lp.objects.size() > rp.objects.size();
+    });
+
+    QMap<CO::NodeId, int> nodesTpdos;
+
+    for(int i = 0; i < pdos.size(); i ++){
+        Pdo& pdo = pdos[i];
+
+        if(i >= SLCanOpenNode::RPDOS_COUNT){
+            m_notMapped.append(pdo.objects);
+            continue;
+        }
+
+        // predefined connection set.
+        pdo.remoteTpdo = nodesTpdos.value(pdo.nodeId, 0);
+        pdo.cobid = 0x180 + 0x100 * pdo.remoteTpdo + pdo.nodeId;
+        nodesTpdos[pdo.nodeId] = pdo.remoteTpdo + 1;
+
+        m_pdos.append(pdo);
+    }
+
+    return !m_pdos.isEmpty();
+}
+
+bool COPdoMapper::apply()
+{
+    if(running()) return false;
+    if(m_slcon == nullptr || !m_slcon->isConnected()) return false;
+    if(m_pdos.isEmpty()) return false;
+
+    m_steps.clear();
+    m_failed.clear();
+    m_failedWrites.clear();
+
+    for(int i = 0; i < m_pdos.size(); i ++){
+        m_pdos[i].applied = true;
+        appendPdoSteps(i);
+    }
+
+    m_curStep = 0;
+
+    startStep();
+
+    return true;
+}
+
+bool COPdoMapper::running() const
+{
+    return m_curStep >= 0;
+}
+
+void COPdoMapper::cancel()
+{
+    if(!running()) return;
+
+    m_curStep = -1;
+
+    if(m_slcon != nullptr && m_sdoc->running()){
+        if(m_slcon->cancel(m_sdoc)){
+            m_sdoc->finish(SDOComm::ERROR_CANCEL);
+        }
+    }
+}
+
+const QVector<COPdoMapper::Pdo>& COPdoMapper::pdos() const
+{
+    return m_pdos;
+}
+
+const QVector<COPdoMapper::Object>& COPdoMapper::notMapped() const
+{
+    return m_notMapped;
+}
+
+const QVector<COPdoMapper::Object>& COPdoMapper::failed() const
+{
+    return m_failed;
+}
+
+const QVector<COPdoMapper::Object>& COPdoMapper::failedWrites() const
+{
+    return m_failedWrites;
+}
+
+qreal COPdoMapper::sdoBitsPerSecond() const
+{
+    qreal bits = m_valuesCount * SDO_FRAMES_PER_VALUE * CanBusStats::frameMaxBits(SDO_FRAME_DLC);
+
+    return bits * 1000.0 / eventTimerValue();
+}
+
+qreal COPdoMapper::pdoBitsPerSecond() const
+{
+    qreal bits = 0.0;
+    int mappedCount = 0;
+
+    for(const auto& pdo: m_pdos){
+        if(!pdo.applied) continue;
+
+        bits += CanBusStats::frameMaxBits(static_cast<quint8>(pdo.dataSize));
+        mappedCount += pdo.objects.size();
+    }
+
+    bits += (m_valuesCount - mappedCount) * SDO_FRAMES_PER_VALUE * CanBusStats::frameMaxBits(SDO_FRAME_DLC);
+
+    return bits * 1000.0 / eventTimerValue();
+}
+
+QString COPdoMapper::report() const
+{
+    int pdosCount = 0;
+    int mappedCount = 0;
+
+    for(const auto& pdo: m_pdos){
+        if(!pdo.applied) continue;
+
+        pdosCount ++;
+        mappedCount += pdo.objects.size();
+    }
+
+    qreal sdoBps = sdoBitsPerSecond();
+    qreal pdoBps = pdoBitsPerSecond();
+    qreal savedBps = sdoBps - pdoBps;
+    qreal savedPercent = (sdoBps > 0.0) ? (savedBps * 100.0 / sdoBps) : 0.0;
+
+    QString res = tr("PDO: %1, значений в PDO: %2 из %3, период %4 мс.\n"
+                     "Загрузка шины: SDO %5 бит/с, PDO %6 бит/с, экономия %7 бит/с (%8%).")
+            .arg(pdosCount).arg(mappedCount).arg(m_valuesCount).arg(eventTimerValue())
+            .arg(sdoBps, 0, 'f', 0).arg(pdoBps, 0, 'f', 0)
+            .arg(savedBps, 0, 'f', 0).arg(savedPercent, 0, 'f', 1);
+
+    for(const auto& obj: m_failedWrites){
+        res += "\n" + tr("Ошибка записи: узел %1, 0x%2:%3.").arg(obj.nodeId)
+                .arg(obj.index, 4, 16, QChar('0')).arg(obj.subIndex);
+    }
+
+    if(!m_failed.isEmpty()){
+        res += "\n" + tr("Не удалось отобразить (опрашиваются по SDO):");
+        for(const auto& obj: m_failed){
+            res += "\n" + tr("узел %1, 0x%2:%3").arg(obj.nodeId)
+                    .arg(obj.index, 4, 16, QChar('0')).arg(obj.subIndex);
+        }
+    }
+
+    return res;
+}
+
+void COPdoMapper::sdocommFinished()
+{
+    if(!running()) return;
+    if(m_curStep >= m_steps.size()) return;
+
+    if(m_sdoc->error() != SDOComm::ERROR_NONE){
+        failStep();
+    }
+
+    m_curStep ++;
+
+    startStep();
+}
+
+int COPdoMapper::eventTimerValue() const
+{
+    int res = m_eventTimer;
+
+    if(res == 0 && m_valsHolder != nullptr) res = m_valsHolder->updateInterval();
+    if(res <= 0) res = PDO_DEFAULT_EVENT_TIMER;
+
+    return qBound(1, res, 65535);
+}
+
+void COPdoMapper::appendPdoSteps(int pdoNum)
+{
+    const Pdo& pdo = m_pdos[pdoNum];
+
+    CO::Index commIndex = 0x1800 + pdo.remoteTpdo;
+    CO::Index mapIndex = 0x1A00 + pdo.remoteTpdo;
+
+    // disable PDO & mapping.
+    appendStep<uint32_t>(pdoNum, commIndex, 1, 0x80000000 | pdo.cobid);
+    appendStep<uint8_t>(pdoNum, mapIndex, 0, 0);
+
+    for(int i = 0; i < pdo.objects.size(); i ++){
+        const Object& obj = pdo.objects[i];
+        uint32_t map = (static_cast<uint32_t>(obj.index) << 16) |
+                       (static_cast<uint32_t>(obj.subIndex) << 8) |
+                       static_cast<uint32_t>(obj.dataSize * 8);
+        appendStep<uint32_t>(pdoNum, mapIndex, i + 1, map);
+    }
+
+    appendStep<uint8_t>(pdoNum, mapIndex, 0, pdo.objects.size());
+    // event driven, sent by the event timer.
+    appendStep<uint8_t>(pdoNum, commIndex, 2, 254);
+    appendStep<uint16_t>(pdoNum, commIndex, 5, eventTimerValue());
+
+    // enable PDO.
+    appendStep<uint32_t>(pdoNum, commIndex, 1, pdo.cobid);
+}
+
+template <typename T>
+void COPdoMapper::appendStep(int pdoNum, CO::Index index, CO::SubIndex subIndex, const T& value)
+{
+    Step step;
+    step.pdo = pdoNum;
+    step.index = index;
+    step.subIndex = subIndex;
+    step.data = QByteArray(reinterpret_cast<const char*>(&value), sizeof(T));
+
+    m_steps.append(step);
+}
+
+void COPdoMapper::startStep()
+{
+    while(m_curStep >= 0 && m_curStep < m_steps.size()){
+        const Step& step = m_steps[m_curStep];
+        Pdo& pdo = m_pdos[step.pdo];
+
+        // skip failed PDO.
+        if(pdo.applied){
+            if(m_slcon != nullptr && m_slcon->write(pdo.nodeId, step.index, step.subIndex,
+                                                    step.data.constData(), step.data.size(), m_sdoc) != nullptr){
+                return;
+            }
+
+            failStep();
+        }
+
+        m_curStep ++;
+    }
+
+    // re-create CO outside of the CO processing.
+    QTimer::singleShot(0, this, &COPdoMapper::finishApply);
+}
+
+void COPdoMapper::failStep()
+{
+    const Step& step = m_steps[m_curStep];
+    Pdo& pdo = m_pdos[step.pdo];
+
+    m_failedWrites.append({pdo.nodeId, step.index, step.subIndex, static_cast<size_t>(step.data.size())});
+
+    // the whole PDO falls back to SDO.
+    if(pdo.applied){
+        pdo.applied = false;
+        m_failed.append(pdo.objects);
+    }
+}
+
+void COPdoMapper::finishApply()
+{
+    if(!running()) return;
+    if(m_slcon == nullptr){
+        m_curStep = -1;
+        emit finished(false);
+        return;
+    }
+
+    bool allApplied = true;
+    int rpdoNum = 0;
+
+    m_slcon->resetRpdos();
+
+    for(const auto& pdo: m_pdos){
+        if(!pdo.applied){
+            allApplied = false;
+            continue;
+        }
+
+        if(!m_slcon->setRpdo(rpdoNum, pdo.cobid, 254)) continue;
+
+        for(const auto& obj: pdo.objects){
+            m_slcon->addRpdoMapping(rpdoNum, obj.nodeId, obj.index, obj.subIndex, obj.dataSize);
+        }
+
+        rpdoNum ++;
+    }
+
+    m_steps.clear();
+    m_curStep = -1;
+
+    if(m_slcon->isConnected()){
+        m_slcon->restartCO();
+    }
+
+    emit finished(allApplied && rpdoNum > 0);
+}
@@ -0,0 +1,120 @@
+#ifndef COPDOMAPPER_H
+#define COPDOMAPPER_H
+
+#include <QObject>
+#include <QVector>
+#include <QByteArray>
+#include <QString>
+#include <stddef.h>
+#include "cotypes.h"
+
+
+class SLCanOpenNode;
+class CoValuesHolder;
+class SDOComm;
+
+
+/*
+ * Maps values of the values holder to the remote TPDOs.
+ * Values are packed into as few PDOs per node as possible,
+ * remote 0x1800/0x1A00 are written by SDO,
+ * local RPDOs are configured to receive them.
+ * Not mapped values are polled by SDO.
+ */
+class COPdoMapper : public QObject
+{
+    Q_OBJECT
+public:
+
+    struct Object {
+        CO::NodeId nodeId;
+        CO::Index index;
+        CO::SubIndex subIndex;
+        size_t dataSize;
+    };
+
+    struct Pdo {
+        CO::NodeId nodeId;
+        int remoteTpdo;
+        uint32_t cobid;
+        size_t dataSize;
+        QVector<Object> objects;
+        bool applied;
+    };
+
+    explicit COPdoMapper(SLCanOpenNode* slcon = nullptr, CoValuesHolder* valsHolder = nullptr, QObject *parent = nullptr);
+    ~COPdoMapper();
+
+    SLCanOpenNode* getSLCanOpenNode();
+    void setSLCanOpenNode(SLCanOpenNode* slcon);
+
+    CoValuesHolder* valuesHolder();
+    void setValuesHolder(CoValuesHolder* valsHolder);
+
+    // Remote TPDOs per node.
+    int maxPdosPerNode() const;
+    void setMaxPdosPerNode(int newMaxPdosPerNode);
+
+    // Remote TPDO event timer in ms, 0 - values holder update interval.
+    int eventTimer() const;
+    void setEventTimer(int newEventTimer);
+
+    // make the mapping plan from the held values.
+    bool plan();
+    // write the plan to the remote nodes and configure local RPDOs.
+    bool apply();
+    bool running() const;
+    void cancel();
+
+    const QVector<Pdo>& pdos() const;
+    const QVector<Object>& notMapped() const;
+    // objects of the PDOs not written to the remote nodes.
+    const QVector<Object>& failed() const;
+    // remote PDO parameters which writes failed.
+    const QVector<Object>& failedWrites() const;
+
+    // Bus load in bits per second at the event timer period.
+    qreal sdoBitsPerSecond() const;
+    qreal pdoBitsPerSecond() const;
+    QString report() const;
+
+signals:
+    void finished(bool ok);
+
+private slots:
+    void sdocommFinished();
+
+private:
+    struct Step {
+        int pdo;
+        CO::Index index;
+        CO::SubIndex subIndex;
+        QByteArray data;
+    };
+
+    SLCanOpenNode* m_slcon;
+    CoValuesHolder* m_valsHolder;
+    SDOComm* m_sdoc;
+
+    int m_maxPdosPerNode;
+    int m_eventTimer;
+
+    QVector<Pdo> m_pdos;
+    QVector<Object> m_notMapped;
+    QVector<Object> m_failed;
+    QVector<Object> m_failedWrites;
+    int m_valuesCount;
+
+    QVector<Step> m_steps;
+    int m_curStep;
+
+    int eventTimerValue() const;
+    void appendPdoSteps(int pdoNum);
+    template <typename T>
+    void appendStep(int pdoNum, CO::Index index, CO::SubIndex subIndex, const T& value);
+    void startStep();
+    void failStep();
+    void finishApply();
+};
+
+#endif // COPDOMAPPER_H
@@ -0,0 +1,133 @@
+#include "covaluedemand.h"
+#include <QWidget>
+#include <QEvent>
+
+
+
+CoValueDemand::CoValueDemand(QWidget* widget, CoValuesHolder* valsHolder, QObject *parent)
+    : QObject{parent}
+{
+    m_widget = widget;
+    m_valsHolder = valsHolder;
+    m_active = false;
+
+    if(m_widget != nullptr){
+        m_widget->installEventFilter(this);
+    }
+
+    updateWindow();
+    updateActive();
+}
+
+CoValueDemand::~CoValueDemand()
+{
+    removeAllValues();
+
+    if(m_window != nullptr && m_window != m_widget){
+        m_window->removeEventFilter(this);
+    }
+    if(m_widget != nullptr){
+        m_widget->removeEventFilter(this);
+    }
+}
+
+CoValuesHolder* CoValueDemand::valuesHolder() const
+{
+    return m_valsHolder;
+}
+
+void CoValueDemand::setValuesHolder(CoValuesHolder* newValuesHolder)
+{
+    removeAllValues();
+
+    m_valsHolder = newValuesHolder;
+}
+
+void CoValueDemand::addValue(CoValuesHolder::HoldedSDOValuePtr sdoVal)
+{
+    if(sdoVal == nullptr) return;
+
+    m_values.append(sdoVal);
+
+    // the value is demanded by its holder from the addition.
+    if(!m_active && m_valsHolder != nullptr) m_valsHolder->releaseValueDemand(sdoVal);
+}
+
+void CoValueDemand::removeValue(CoValuesHolder::HoldedSDOValuePtr sdoVal)
+{
+    if(!m_values.removeOne(sdoVal)) return;
+
+    // the holder demand is released on the deletion.
+    if(!m_active && m_valsHolder != nullptr) m_valsHolder->addValueDemand(sdoVal);
+}
+
+void CoValueDemand::removeAllValues()
+{
+    while(!m_values.isEmpty()){
+        removeValue(m_values.last());
+    }
+}
+
+bool CoValueDemand::active() const
+{
+    return m_active;
+}
+
+bool CoValueDemand::eventFilter(QObject* watched, QEvent* event)
+{
+    switch(event->type()){
+    case QEvent::Show:
+    case QEvent::Hide:
+    case QEvent::ParentChange:
+        if(watched == m_widget){
+            updateWindow();
+            updateActive();
+        }
+        break;
+    case QEvent::WindowStateChange:
+        if(watched == m_window){
+            updateActive();
+        }
+        break;
+    default:
+        break;
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+void CoValueDemand::updateWindow()
+{
+    QWidget* window = (m_widget != nullptr) ? m_widget->window() : nullptr;
+
+    if(window == m_window) return;
+
+    if(m_window != nullptr && m_window != m_widget){
+        m_window->removeEventFilter(this);
+    }
+
+    m_window = window;
+
+    if(m_window != nullptr && m_window != m_widget){
+        m_window->installEventFilter(this);
+    }
+}
+
+void CoValueDemand::updateActive()
+{
+    bool active = m_widget != nullptr && m_widget->isVisible() &&
+                  (m_window == nullptr || !m_window->isMinimized());
+
+    if(active == m_active) return;
+
+    m_active = active;
+
+    if(m_valsHolder != nullptr){
+        for(auto sdoVal: qAsConst(m_values)){
+            if(m_active) m_valsHolder->addValueDemand(sdoVal);
+            else m_valsHolder->releaseValueDemand(sdoVal);
+        }
+    }
+
+    emit activeChanged(m_active);
+}
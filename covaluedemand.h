@@ -0,0 +1,53 @@
+#ifndef COVALUEDEMAND_H
+#define COVALUEDEMAND_H
+
+#include <QObject>
+#include <QList>
+#include <QPointer>
+#include "covaluesholder.h"
+
+
+class QWidget;
+
+
+/*
+ * Demand of the widget values.
+ * The widget values are demanded from the holder
+ * while the widget is visible and its window is not minimized.
+ */
+class CoValueDemand : public QObject
+{
+    Q_OBJECT
+public:
+    explicit CoValueDemand(QWidget* widget, CoValuesHolder* valsHolder = nullptr, QObject *parent = nullptr);
+    ~CoValueDemand();
+
+    CoValuesHolder* valuesHolder() const;
+    // values are released.
+    void setValuesHolder(CoValuesHolder* newValuesHolder);
+
+    void addValue(CoValuesHolder::HoldedSDOValuePtr sdoVal);
+    void removeValue(CoValuesHolder::HoldedSDOValuePtr sdoVal);
+    void removeAllValues();
+
+    // the widget is visible.
+    bool active() const;
+
+signals:
+    void activeChanged(bool active);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    QWidget* m_widget;
+    QPointer<QWidget> m_window;
+    CoValuesHolder* m_valsHolder;
+    QList<CoValuesHolder::HoldedSDOValuePtr> m_values;
+    bool m_active;
+
+    void updateWindow();
+    void updateActive();
+};
+
+#endif // COVALUEDEMAND_H
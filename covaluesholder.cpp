@@ -1,8 +1,19 @@
 #include "covaluesholder.h"
 #include "slcanopennode.h"
+#include "sdowritecoalescer.h"
+#include "canbusstats.h"
+#include "covaluessnapshot.h"
 #include <QTimer>
+#include <algorithm>
+#include <climits>
+#include <string.h>
 
 
+// max elapsed time of the budget refill, update intervals.
+#define POLL_MAX_REFILL_INTERVALS 2
+// default target utilization.
+#define POLL_DEFAULT_LOAD_TARGET 0.8
+
 
 CoValuesHolder::CoValuesHolder(SLCanOpenNode* slcon, QObject *parent)
     : QObject{parent}
@@ -13,19 +24,48 @@ CoValuesHolder::CoValuesHolder(SLCanOpenNode* slcon, QObject *parent)
     m_updateTimer->setSingleShot(false);
     m_updatingEnabled = false;
     connect(m_updateTimer, &QTimer::timeout, this, &CoValuesHolder::update);
+
+    m_deadlineTimer = new QTimer();
+    m_deadlineTimer->setSingleShot(true);
+    m_deadlineTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_deadlineTimer, &QTimer::timeout, this, &CoValuesHolder::pollDue);
+    m_clock.start();
+    m_idlePeriod = 0;
+
+    m_publishTimer = new QTimer();
+    m_publishTimer->setSingleShot(true);
+    m_publishTimer->setInterval(0);
+    connect(m_publishTimer, &QTimer::timeout, this, &CoValuesHolder::publishUpdates);
+
+    m_snapshot = new CoValuesSnapshot();
+    m_repaintsAvoided = 0;
+
+    m_busLoadTarget = POLL_DEFAULT_LOAD_TARGET;
+    m_serialLoadTarget = POLL_DEFAULT_LOAD_TARGET;
+    m_pollsSkipped = 0;
+    resetPollBudget();
+
+    m_writeCoalescer = new SDOWriteCoalescer(m_slcon);
+
+    connectSLCanOpenNode();
 }
 
 CoValuesHolder::~CoValuesHolder()
 {
-    for(auto it = m_sdoValues.begin(); it != m_sdoValues.end(); ++ it){
-        if(it->second == 0){
-            delete it->first;
+    for(int i = m_sdoValues.begin(); i != m_sdoValues.end(); i = m_sdoValues.next(i)){
+        const HeldValue& val = m_sdoValues.value(i);
+        if(val.count == 0){
+            delete val.sdoval;
         }else{
-            it->first->deleteLater();
+            val.sdoval->deleteLater();
         }
     }
     m_sdoValues.clear();
+    delete m_publishTimer;
+    delete m_snapshot;
+    delete m_deadlineTimer;
     delete m_updateTimer;
+    delete m_writeCoalescer;
 }
 
 SLCanOpenNode* CoValuesHolder::getSLCanOpenNode()
@@ -37,7 +77,12 @@ bool CoValuesHolder::setSLCanOpenNode(SLCanOpenNode* slcon)
 {
     if(m_updateTimer->isActive()) return false;
 
+    disconnectSLCanOpenNode();
+
     m_slcon = slcon;
+    m_writeCoalescer->setSLCanOpenNode(slcon);
+
+    connectSLCanOpenNode();
 
     return true;
 }
@@ -55,7 +100,9 @@ bool CoValuesHolder::setUpdatingEnabled(bool newUpdatingEnabled)
     m_updatingEnabled = newUpdatingEnabled;
 
     if(m_updatingEnabled && !m_sdoValues.isEmpty() && !m_updateTimer->isActive()){
+        resetPollBudget();
         m_updateTimer->start();
+        schedulePoll();
     }
 
     return true;
@@ -71,17 +118,28 @@ void CoValuesHolder::setUpdateInterval(int newUpdateInterval)
     m_updateTimer->setInterval(newUpdateInterval);
 }
 
-CoValuesHolder::HoldedSDOValuePtr CoValuesHolder::addSdoValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, size_t dataSize, int timeout)
+CoValuesHolder::HoldedSDOValuePtr CoValuesHolder::addSdoValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, size_t dataSize, int timeout,
+                                                              PollPriority priority, int period)
 {
     if(m_slcon == nullptr) return nullptr;
 
     FullIndex valFullIndex = makeFullIndex(valNodeId, valIndex, valSubIndex);
 
-    auto it = m_sdoValues.find(valFullIndex);
-
-    if(it != m_sdoValues.end()){
-        it->second ++;
-        return HoldedSDOValuePtr(it->first);
+    int slot = m_sdoValues.find(valFullIndex);
+
+    if(slot >= 0){
+        HeldValue& val = m_sdoValues.value(slot);
+        val.count ++;
+        val.priority = std::max(val.priority, priority);
+        // the new holder gets the next update.
+        val.changedData.clear();
+        // each holder demands the value.
+        addDemand(valFullIndex, val);
+        addCompoundDemand(valFullIndex);
+        if(period > 0 && (val.period == 0 || period < val.period)){
+            setValuePeriod(HoldedSDOValuePtr(val.sdoval), period);
+        }
+        return HoldedSDOValuePtr(val.sdoval);
     }
 
     if(dataSize == 0) return nullptr;
@@ -93,9 +151,24 @@ CoValuesHolder::HoldedSDOValuePtr CoValuesHolder::addSdoValue(CO::NodeId valNode
     sdoval->setDataSize(dataSize);
     sdoval->setTimeout(timeout);
 
-    m_sdoValues.insert(valFullIndex, qMakePair(sdoval, 1));
+    connect(sdoval, &SDOValue::readed, this, &CoValuesHolder::sdovalueReaded);
+    connect(sdoval, &SDOValue::errorOccured, this, &CoValuesHolder::sdovalueError);
+
+    int snapshotSlot = m_snapshot->alloc(valFullIndex, dataSize);
 
-    if(m_slcon->isConnected() && m_updatingEnabled && !m_updateTimer->isActive()) m_updateTimer->start();
+    slot = m_sdoValues.insert(valFullIndex, HeldValue{sdoval, 1, priority, 0, std::max(period, 0), -1, 0, snapshotSlot, QByteArray(), QVector<ValueDeadband>(), QVector<int>()});
+
+    // each holder demands the value.
+    addDemand(valFullIndex, m_sdoValues.value(slot));
+    addCompoundDemand(valFullIndex);
+
+    if(m_slcon->isConnected() && m_updatingEnabled){
+        if(!m_updateTimer->isActive()){
+            resetPollBudget();
+            m_updateTimer->start();
+        }
+        schedulePoll();
+    }
 
     return HoldedSDOValuePtr(sdoval);
 }
@@ -106,61 +179,408 @@ void CoValuesHolder::delSdoValue(HoldedSDOValuePtr delSdoVal)
 
     FullIndex valFullIndex = makeFullIndex(delSdoVal->nodeId(), delSdoVal->index(), delSdoVal->subIndex());
 
-    auto it = m_sdoValues.find(valFullIndex);
+    int slot = m_sdoValues.find(valFullIndex);
 
-    if(it == m_sdoValues.end()) return;
+    if(slot < 0) return;
 
-    SDOValue* sdoval = it->first;
+    HeldValue& val = m_sdoValues.value(slot);
+    SDOValue* sdoval = val.sdoval;
 
     if(sdoval != delSdoVal) return;
 
-    if(it->second) it->second --;
-    if(it->second == 0){
+    // demand of the holder.
+    if(val.demand){
+        val.demand --;
+        releaseCompoundDemand(valFullIndex);
+    }
+
+    if(val.count) val.count --;
+    if(val.count == 0){
         if(!sdoval->running()){
-            m_sdoValues.erase(it);
-            delete sdoval;
+            deleteValue(val);
+            m_sdoValues.erase(slot);
         }
     }
 
-    if(m_sdoValues.isEmpty()) m_updateTimer->stop();
+    if(m_sdoValues.isEmpty()) stopPolling();
 }
 
 CoValuesHolder::HoldedSDOValuePtr CoValuesHolder::getSDOValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex) const
 {
     FullIndex valFullIndex = makeFullIndex(valNodeId, valIndex, valSubIndex);
 
-    auto it = m_sdoValues.find(valFullIndex);
+    int slot = m_sdoValues.find(valFullIndex);
 
-    if(it == m_sdoValues.end()) return HoldedSDOValuePtr(nullptr);
+    if(slot < 0) return HoldedSDOValuePtr(nullptr);
 
-    return HoldedSDOValuePtr(it->first);
+    return HoldedSDOValuePtr(m_sdoValues.value(slot).sdoval);
 }
 
-void CoValuesHolder::update()
+QList<CoValuesHolder::HoldedSDOValuePtr> CoValuesHolder::sdoValues() const
 {
-    emit updateBegin();
+    QVector<QPair<FullIndex, HoldedSDOValuePtr>> vals;
 
-    for(auto it = m_sdoValues.begin(); it != m_sdoValues.end(); ){
-        SDOValue* sdoval = it->first;
-        uint count = it->second;
+    for(int i = m_sdoValues.begin(); i != m_sdoValues.end(); i = m_sdoValues.next(i)){
+        const HeldValue& val = m_sdoValues.value(i);
+        if(val.count == 0) continue;
 
-        if(sdoval->running()){
-            ++ it;
-            continue;
+        vals.append(qMakePair(m_sdoValues.key(i), HoldedSDOValuePtr(val.sdoval)));
+    }
+
+    // values are sorted by the full index.
+    std::sort(vals.begin(), vals.end());
+
+    QList<HoldedSDOValuePtr> res;
+    res.reserve(vals.size());
+
+    for(const auto& val: qAsConst(vals)){
+        res.append(val.second);
+    }
+
+    return res;
+}
+
+int CoValuesHolder::valuePeriod(HoldedSDOValuePtr sdoVal) const
+{
+    if(sdoVal == nullptr) return 0;
+
+    int slot = m_sdoValues.find(makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex()));
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return 0;
+
+    return m_sdoValues.value(slot).period;
+}
+
+bool CoValuesHolder::setValuePeriod(HoldedSDOValuePtr sdoVal, int newPeriod)
+{
+    if(sdoVal == nullptr) return false;
+    if(newPeriod < 0) return false;
+
+    FullIndex valFullIndex = makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex());
+
+    int slot = m_sdoValues.find(valFullIndex);
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return false;
+
+    HeldValue& val = m_sdoValues.value(slot);
+    val.period = newPeriod;
+
+    reschedule(valFullIndex, val);
+
+    return true;
+}
+
+bool CoValuesHolder::addValuePeriod(HoldedSDOValuePtr sdoVal, int period)
+{
+    if(sdoVal == nullptr) return false;
+    if(period <= 0) return false;
+
+    FullIndex valFullIndex = makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex());
+
+    int slot = m_sdoValues.find(valFullIndex);
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return false;
+
+    HeldValue& val = m_sdoValues.value(slot);
+    val.periods.append(period);
+
+    reschedule(valFullIndex, val);
+
+    return true;
+}
+
+void CoValuesHolder::releaseValuePeriod(HoldedSDOValuePtr sdoVal, int period)
+{
+    if(sdoVal == nullptr) return;
+
+    FullIndex valFullIndex = makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex());
+
+    int slot = m_sdoValues.find(valFullIndex);
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return;
+
+    HeldValue& val = m_sdoValues.value(slot);
+    if(!val.periods.removeOne(period)) return;
+
+    reschedule(valFullIndex, val);
+}
+
+void CoValuesHolder::addValueDemand(HoldedSDOValuePtr sdoVal)
+{
+    if(sdoVal == nullptr) return;
+
+    FullIndex valFullIndex = makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex());
+
+    int slot = m_sdoValues.find(valFullIndex);
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return;
+
+    addDemand(valFullIndex, m_sdoValues.value(slot));
+    addCompoundDemand(valFullIndex);
+}
+
+void CoValuesHolder::releaseValueDemand(HoldedSDOValuePtr sdoVal)
+{
+    if(sdoVal == nullptr) return;
+
+    int slot = m_sdoValues.find(makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex()));
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return;
+
+    HeldValue& val = m_sdoValues.value(slot);
+
+    // the idle period is applied on the next deadline.
+    if(val.demand){
+        val.demand --;
+        releaseCompoundDemand(m_sdoValues.key(slot));
+    }
+}
+
+uint CoValuesHolder::valueDemand(HoldedSDOValuePtr sdoVal) const
+{
+    if(sdoVal == nullptr) return 0;
+
+    int slot = m_sdoValues.find(makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex()));
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return 0;
+
+    return m_sdoValues.value(slot).demand;
+}
+
+bool CoValuesHolder::addCompoundRead(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, size_t dataSize,
+                                     const QVector<CompoundField>& fields, int timeout, int period)
+{
+    if(fields.isEmpty()) return false;
+
+    FullIndex valFullIndex = makeFullIndex(valNodeId, valIndex, valSubIndex);
+    if(m_compounds.contains(valFullIndex)) return false;
+
+    for(const CompoundField& field: fields){
+        size_t fieldSize = COValue::typeSize(field.type);
+        if(fieldSize == 0 || field.offset + fieldSize > dataSize) return false;
+
+        FullIndex fieldFullIndex = makeFullIndex(valNodeId, field.index, field.subIndex);
+        if(fieldFullIndex == valFullIndex || m_compoundFields.contains(fieldFullIndex)) return false;
+    }
+
+    HoldedSDOValuePtr sdoval = addSdoValue(valNodeId, valIndex, valSubIndex, dataSize, timeout, POLL_PRIORITY_NORMAL, period);
+    if(sdoval == nullptr) return false;
+
+    m_compounds.insert(valFullIndex, Compound{sdoval, fields});
+
+    // the compound is demanded by the fields only.
+    HeldValue& compoundVal = m_sdoValues.value(m_sdoValues.find(valFullIndex));
+    if(compoundVal.demand) compoundVal.demand --;
+
+    for(const CompoundField& field: fields){
+        FullIndex fieldFullIndex = makeFullIndex(valNodeId, field.index, field.subIndex);
+        m_compoundFields.insert(fieldFullIndex, valFullIndex);
+
+        // demand of the already shown fields.
+        int slot = m_sdoValues.find(fieldFullIndex);
+        if(slot < 0) continue;
+
+        for(uint i = 0; i < m_sdoValues.value(slot).demand; i ++){
+            addCompoundDemand(fieldFullIndex);
         }
+    }
 
-        if(count == 0){
-            it = m_sdoValues.erase(it);
-            delete sdoval;
-            continue;
+    return true;
+}
+
+void CoValuesHolder::delCompoundRead(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex)
+{
+    FullIndex valFullIndex = makeFullIndex(valNodeId, valIndex, valSubIndex);
+
+    auto it = m_compounds.find(valFullIndex);
+    if(it == m_compounds.end()) return;
+
+    for(const CompoundField& field: qAsConst(it->fields)){
+        m_compoundFields.remove(makeFullIndex(valNodeId, field.index, field.subIndex));
+    }
+
+    HoldedSDOValuePtr sdoval = it->sdoval;
+
+    m_compounds.erase(it);
+
+    // the holder demand is released on the deletion.
+    int slot = m_sdoValues.find(valFullIndex);
+    if(slot >= 0) m_sdoValues.value(slot).demand ++;
+
+    delSdoValue(sdoval);
+}
+
+QList<CoValuesHolder::CompoundRead> CoValuesHolder::compoundReads() const
+{
+    QList<FullIndex> keys = m_compounds.keys();
+    std::sort(keys.begin(), keys.end());
+
+    QList<CompoundRead> res;
+    res.reserve(keys.size());
+
+    for(FullIndex key: qAsConst(keys)){
+        const Compound compound = m_compounds.value(key);
+        HoldedSDOValuePtr sdoval = compound.sdoval;
+
+        res.append(CompoundRead{sdoval->nodeId(), sdoval->index(), sdoval->subIndex(),
+                                sdoval->dataSize(), valuePeriod(sdoval), compound.fields});
+    }
+
+    return res;
+}
+
+int CoValuesHolder::idlePeriod() const
+{
+    return m_idlePeriod;
+}
+
+void CoValuesHolder::setIdlePeriod(int newIdlePeriod)
+{
+    m_idlePeriod = std::max(newIdlePeriod, 0);
+
+    for(int i = m_sdoValues.begin(); i != m_sdoValues.end(); i = m_sdoValues.next(i)){
+        HeldValue& val = m_sdoValues.value(i);
+        if(val.demand == 0) reschedule(m_sdoValues.key(i), val);
+    }
+}
+
+QList<CO::NodeId> CoValuesHolder::nodeIds() const
+{
+    // node id is the high byte of the full index.
+    bool nodes[256] = {false};
+
+    for(int i = m_sdoValues.begin(); i != m_sdoValues.end(); i = m_sdoValues.next(i)){
+        if(m_sdoValues.value(i).count == 0) continue;
+
+        nodes[m_sdoValues.key(i) >> 24] = true;
+    }
+
+    QList<CO::NodeId> res;
+
+    for(int nodeId = 0; nodeId < 256; nodeId ++){
+        if(nodes[nodeId]) res.append(static_cast<CO::NodeId>(nodeId));
+    }
+
+    return res;
+}
+
+qreal CoValuesHolder::busLoadTarget() const
+{
+    return m_busLoadTarget;
+}
+
+void CoValuesHolder::setBusLoadTarget(qreal newBusLoadTarget)
+{
+    m_busLoadTarget = qBound(0.0, newBusLoadTarget, 1.0);
+}
+
+qreal CoValuesHolder::serialLoadTarget() const
+{
+    return m_serialLoadTarget;
+}
+
+void CoValuesHolder::setSerialLoadTarget(qreal newSerialLoadTarget)
+{
+    m_serialLoadTarget = qBound(0.0, newSerialLoadTarget, 1.0);
+}
+
+quint64 CoValuesHolder::pollsSkipped() const
+{
+    return m_pollsSkipped;
+}
+
+bool CoValuesHolder::valueUpdated(HoldedSDOValuePtr sdoVal) const
+{
+    return m_publishedFlags.contains(sdoVal);
+}
+
+bool CoValuesHolder::valueChanged(HoldedSDOValuePtr sdoVal) const
+{
+    return m_publishedFlags.value(sdoVal, false);
+}
+
+bool CoValuesHolder::addValueDeadband(HoldedSDOValuePtr sdoVal, COValue::Type type, qreal deadband, DeadbandMode mode)
+{
+    if(sdoVal == nullptr) return false;
+    if(deadband < 0.0) return false;
+
+    size_t typeSize = COValue::typeSize(type);
+    if(typeSize == 0 || typeSize > sdoVal->dataSize()) return false;
+
+    int slot = m_sdoValues.find(makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex()));
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return false;
+
+    m_sdoValues.value(slot).deadbands.append(ValueDeadband{type, mode, deadband});
+
+    return true;
+}
+
+void CoValuesHolder::releaseValueDeadband(HoldedSDOValuePtr sdoVal, COValue::Type type, qreal deadband, DeadbandMode mode)
+{
+    if(sdoVal == nullptr) return;
+
+    int slot = m_sdoValues.find(makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex()));
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return;
+
+    QVector<ValueDeadband>& deadbands = m_sdoValues.value(slot).deadbands;
+
+    for(int i = 0; i < deadbands.size(); i ++){
+        const ValueDeadband& db = deadbands[i];
+        if(db.type == type && db.mode == mode && qFuzzyCompare(db.deadband + 1.0, deadband + 1.0)){
+            deadbands.removeAt(i);
+            break;
         }
+    }
+}
+
+quint64 CoValuesHolder::repaintsAvoided() const
+{
+    return m_repaintsAvoided;
+}
 
-        if(m_updatingEnabled) sdoval->read();
+const CoValuesSnapshot* CoValuesHolder::snapshot() const
+{
+    return m_snapshot;
+}
+
+int CoValuesHolder::snapshotSlot(HoldedSDOValuePtr sdoVal) const
+{
+    if(sdoVal == nullptr) return -1;
+
+    int slot = m_sdoValues.find(makeFullIndex(sdoVal->nodeId(), sdoVal->index(), sdoVal->subIndex()));
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoVal) return -1;
 
-        ++ it;
+    return m_sdoValues.value(slot).slot;
+}
+
+SDOWriteCoalescer* CoValuesHolder::writeCoalescer()
+{
+    return m_writeCoalescer;
+}
+
+bool CoValuesHolder::writeValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, const void* data, size_t dataSize, int timeout)
+{
+    // TPDO mapped setpoints are sent as a single unconfirmed frame.
+    if(m_slcon != nullptr && m_slcon->hasTpdoMapping(valNodeId, valIndex, valSubIndex)){
+        if(m_slcon->writeTpdo(valNodeId, valIndex, valSubIndex, data, dataSize)) return true;
     }
 
-    if(m_sdoValues.isEmpty() || !m_updatingEnabled) m_updateTimer->stop();
+    return m_writeCoalescer->write(valNodeId, valIndex, valSubIndex, data, dataSize, timeout);
+}
+
+void CoValuesHolder::update()
+{
+    emit updateBegin();
+
+    // remove released values.
+    for(int i = m_sdoValues.begin(); i != m_sdoValues.end(); i = m_sdoValues.next(i)){
+        const HeldValue& val = m_sdoValues.value(i);
+
+        if(val.count == 0 && !val.sdoval->running()){
+            deleteValue(val);
+            m_sdoValues.erase(i);
+        }
+    }
+
+    if(m_sdoValues.isEmpty() || !m_updatingEnabled){
+        stopPolling();
+        return;
+    }
+
+    pollDue();
 }
 
 void CoValuesHolder::enableUpdating()
@@ -173,6 +593,410 @@ void CoValuesHolder::disableUpdating()
     setUpdatingEnabled(false);
 }
 
+void CoValuesHolder::valueReceived(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, const QByteArray& data)
+{
+    int slot = m_sdoValues.find(makeFullIndex(valNodeId, valIndex, valSubIndex));
+    if(slot < 0) return;
+
+    const HeldValue& val = m_sdoValues.value(slot);
+    SDOValue* sdoval = val.sdoval;
+    if(val.count == 0) return;
+
+    sdoval->updateData(data.constData(), static_cast<size_t>(data.size()));
+}
+
+void CoValuesHolder::pollDue()
+{
+    qint64 now = m_clock.elapsed();
+
+    QVector<HeldValue*> values;
+    QVector<PollDeadline> next;
+
+    while(!m_deadlines.isEmpty() && m_deadlines.first().deadline <= now){
+        std::pop_heap(m_deadlines.begin(), m_deadlines.end(), &CoValuesHolder::deadlineLater);
+        PollDeadline pd = m_deadlines.takeLast();
+
+        int slot = m_sdoValues.find(pd.key);
+        if(slot < 0) continue;
+
+        HeldValue& val = m_sdoValues.value(slot);
+        if(val.count == 0 || val.deadline != pd.deadline) continue;
+
+        qint64 period = effectivePeriod(val);
+
+        // value without demand is not polled.
+        if(period < 0){
+            val.deadline = -1;
+            continue;
+        }
+
+        // missed periods are not caught up.
+        val.deadline = pd.deadline + period;
+        if(val.deadline <= now) val.deadline = now + period;
+
+        next.append({val.deadline, pd.key});
+
+        if(pollable(val)) values.append(&val);
+    }
+
+    for(const PollDeadline& pd: qAsConst(next)){
+        pushDeadline(pd.deadline, pd.key);
+    }
+
+    pollValues(values);
+
+    schedulePoll();
+}
+
+void CoValuesHolder::sdovalueReaded()
+{
+    auto sdoval = qobject_cast<HoldedSDOValuePtr>(sender());
+    if(sdoval == nullptr) return;
+
+    int slot = m_sdoValues.find(makeFullIndex(sdoval->nodeId(), sdoval->index(), sdoval->subIndex()));
+    if(slot < 0 || m_sdoValues.value(slot).sdoval != sdoval) return;
+
+    HeldValue& val = m_sdoValues.value(slot);
+
+    // the transfer is finished, the data is consistent.
+    m_snapshot->publish(val.slot, sdoval->data(), sdoval->dataSize());
+
+    bool changed = detectChange(val);
+
+    auto compound = m_compounds.constFind(m_sdoValues.key(slot));
+    if(compound != m_compounds.constEnd()){
+        splitCompound(compound.value());
+    }
+
+    auto it = m_updatedFlags.find(sdoval);
+    if(it != m_updatedFlags.end()){
+        if(changed) it.value() = true;
+        return;
+    }
+
+    m_updatedFlags.insert(sdoval, changed);
+    m_updatedValues.append(sdoval);
+
+    if(!m_publishTimer->isActive()) m_publishTimer->start();
+}
+
+void CoValuesHolder::sdovalueError()
+{
+    auto sdoval = qobject_cast<HoldedSDOValuePtr>(sender());
+    if(sdoval == nullptr) return;
+
+    m_snapshot->setQuality(snapshotSlot(sdoval), CoValuesSnapshot::QUALITY_ERROR);
+}
+
+void CoValuesHolder::publishUpdates()
+{
+    if(m_updatedValues.isEmpty()) return;
+
+    // values read during the emit (nested event loops of the receivers)
+    // start the new batch published on the next cycle.
+    UpdatedValues values;
+    values.swap(m_updatedValues);
+    QHash<HoldedSDOValuePtr, bool> flags;
+    flags.swap(m_updatedFlags);
+
+    for(auto sdoval: qAsConst(values)){
+        if(!flags.value(sdoval)) m_repaintsAvoided ++;
+    }
+
+    // the batch of the outer publishing is restored after the nested one.
+    m_publishedFlags.swap(flags);
+
+    emit valuesUpdated(values);
+
+    m_publishedFlags.swap(flags);
+}
+
+void CoValuesHolder::deleteValue(const HeldValue& val)
+{
+    SDOValue* sdoval = val.sdoval;
+
+    m_snapshot->release(val.slot);
+
+    if(m_updatedFlags.remove(sdoval)){
+        m_updatedValues.removeOne(sdoval);
+    }
+    m_publishedFlags.remove(sdoval);
+
+    delete sdoval;
+}
+
+bool CoValuesHolder::detectChange(HeldValue& val)
+{
+    const char* data = static_cast<const char*>(val.sdoval->data());
+    int dataSize = static_cast<int>(val.sdoval->dataSize());
+
+    if(data == nullptr || dataSize == 0) return true;
+
+    if(val.changedData.size() == dataSize){
+        if(memcmp(val.changedData.constData(), data, static_cast<size_t>(dataSize)) == 0) return false;
+
+        // the deadband is applied if all holders set it.
+        if(!val.deadbands.isEmpty() && static_cast<size_t>(val.deadbands.size()) >= val.count){
+            const ValueDeadband& first = val.deadbands.first();
+            qreal deadband = first.deadband;
+            bool same = first.mode != DEADBAND_NONE;
+
+            for(const ValueDeadband& db: qAsConst(val.deadbands)){
+                if(db.mode != first.mode || db.type != first.type){
+                    same = false;
+                    break;
+                }
+                deadband = std::min(deadband, db.deadband);
+            }
+
+            if(same && deadband > 0.0){
+                qreal ref = COValue::valueFrom<qreal>(val.changedData.constData(), first.type, 0.0);
+                qreal cur = COValue::valueFrom<qreal>(data, first.type, 0.0);
+
+                if(first.mode == DEADBAND_PERCENT) deadband = qAbs(ref) * deadband / 100;
+
+                if(qAbs(cur - ref) <= deadband) return false;
+            }
+        }
+    }
+
+    val.changedData.resize(dataSize);
+    memcpy(val.changedData.data(), data, static_cast<size_t>(dataSize));
+
+    return true;
+}
+
+qint64 CoValuesHolder::effectivePeriod(const HeldValue& val) const
+{
+    int shortest = val.period;
+    for(int holderPeriod: val.periods){
+        if(shortest == 0 || holderPeriod < shortest) shortest = holderPeriod;
+    }
+
+    qint64 period = (shortest > 0) ? shortest : m_updateTimer->interval();
+
+    if(val.demand == 0){
+        if(m_idlePeriod == 0) return -1;
+        period = std::max(period, static_cast<qint64>(m_idlePeriod));
+    }
+
+    return period;
+}
+
+void CoValuesHolder::reschedule(FullIndex key, HeldValue& val)
+{
+    qint64 period = effectivePeriod(val);
+    if(period < 0) return;
+
+    // the shorter period is applied immediately.
+    qint64 deadline = m_clock.elapsed() + period;
+    if(val.deadline < 0 || deadline < val.deadline){
+        val.deadline = deadline;
+        pushDeadline(deadline, key);
+        schedulePoll();
+    }
+}
+
+void CoValuesHolder::addDemand(FullIndex key, HeldValue& val)
+{
+    val.demand ++;
+
+    // shown value is read immediately.
+    if(val.demand == 1){
+        qint64 now = m_clock.elapsed();
+        if(val.deadline < 0 || val.deadline > now){
+            val.deadline = now;
+            pushDeadline(now, key);
+            schedulePoll();
+        }
+    }
+}
+
+void CoValuesHolder::addCompoundDemand(FullIndex fieldKey)
+{
+    auto it = m_compoundFields.constFind(fieldKey);
+    if(it == m_compoundFields.constEnd()) return;
+
+    int slot = m_sdoValues.find(it.value());
+    if(slot < 0) return;
+
+    addDemand(it.value(), m_sdoValues.value(slot));
+}
+
+void CoValuesHolder::releaseCompoundDemand(FullIndex fieldKey)
+{
+    auto it = m_compoundFields.constFind(fieldKey);
+    if(it == m_compoundFields.constEnd()) return;
+
+    int slot = m_sdoValues.find(it.value());
+    if(slot < 0) return;
+
+    HeldValue& val = m_sdoValues.value(slot);
+    if(val.demand) val.demand --;
+}
+
+void CoValuesHolder::splitCompound(const Compound& compound)
+{
+    const SDOValue* sdoval = compound.sdoval;
+    const quint8* data = static_cast<const quint8*>(sdoval->data());
+    if(data == nullptr) return;
+
+    // DOMAIN may be shorter than the buffer.
+    size_t dataSize = sdoval->transferedDataSize();
+    if(dataSize == 0 || dataSize > sdoval->dataSize()) dataSize = sdoval->dataSize();
+
+    for(const CompoundField& field: compound.fields){
+        size_t fieldSize = COValue::typeSize(field.type);
+        if(field.offset + fieldSize > dataSize) continue;
+
+        int slot = m_sdoValues.find(makeFullIndex(sdoval->nodeId(), field.index, field.subIndex));
+        if(slot < 0) continue;
+
+        const HeldValue& val = m_sdoValues.value(slot);
+        if(val.count == 0 || val.sdoval->running()) continue;
+
+        // emits readed(), the field is published in the same batch.
+        val.sdoval->updateData(data + field.offset, fieldSize);
+    }
+}
+
+bool CoValuesHolder::pollable(const HeldValue& val) const
+{
+    const SDOValue* sdoval = val.sdoval;
+
+    if(!m_updatingEnabled || sdoval->running()) return false;
+
+    // values of the compound reads are updated by the compound.
+    if(m_compoundFields.contains(makeFullIndex(sdoval->nodeId(), sdoval->index(), sdoval->subIndex()))) return false;
+
+    // RPDO mapped values and values of the missing or stopped nodes are not polled,
+    // in the listen only mode values are updated from the bus traffic.
+    return !m_slcon->listenOnly() && m_slcon->nodeAvailable(sdoval->nodeId()) &&
+           !m_slcon->hasRpdoMapping(sdoval->nodeId(), sdoval->index(), sdoval->subIndex());
+}
+
+void CoValuesHolder::pushDeadline(qint64 deadline, FullIndex key)
+{
+    m_deadlines.append({deadline, key});
+    std::push_heap(m_deadlines.begin(), m_deadlines.end(), &CoValuesHolder::deadlineLater);
+}
+
+bool CoValuesHolder::deadlineLater(const PollDeadline& a, const PollDeadline& b)
+{
+    return a.deadline > b.deadline;
+}
+
+void CoValuesHolder::schedulePoll()
+{
+    if(!m_updatingEnabled || !m_updateTimer->isActive() || m_deadlines.isEmpty()){
+        m_deadlineTimer->stop();
+        return;
+    }
+
+    qint64 delay = std::max(m_deadlines.first().deadline - m_clock.elapsed(), static_cast<qint64>(0));
+
+    m_deadlineTimer->start(static_cast<int>(std::min(delay, static_cast<qint64>(INT_MAX))));
+}
+
+void CoValuesHolder::stopPolling()
+{
+    m_updateTimer->stop();
+    m_deadlineTimer->stop();
+}
+
+void CoValuesHolder::pollValues(QVector<HeldValue*>& values)
+{
+    if(values.isEmpty()) return;
+
+    const CanBusStats* stats = m_slcon->busStats();
+
+    if((m_busLoadTarget <= 0.0 && m_serialLoadTarget <= 0.0) || stats == nullptr){
+        for(HeldValue* val: qAsConst(values)){
+            val->sdoval->read();
+        }
+        return;
+    }
+
+    refillPollBudget();
+
+    // high priority first, then the longest skipped.
+    std::stable_sort(values.begin(), values.end(), [](const HeldValue* a, const HeldValue* b){
+        if(a->priority != b->priority) return a->priority > b->priority;
+        return a->skipped > b->skipped;
+    });
+
+    bool busLimited = m_busLoadTarget > 0.0;
+    bool serialLimited = m_serialLoadTarget > 0.0;
+
+    for(HeldValue* val: qAsConst(values)){
+        PollBudget::Cost cost = pollCost(val->sdoval->dataSize());
+
+        bool fits = (!busLimited || m_busBudget.fits(cost.busBits)) &&
+                    (!serialLimited || (m_serialTxBudget.fits(cost.serialTxChars) &&
+                                        m_serialRxBudget.fits(cost.serialRxChars)));
+
+        if(!fits || !val->sdoval->read()){
+            val->skipped ++;
+            if(!fits) m_pollsSkipped ++;
+            continue;
+        }
+
+        val->skipped = 0;
+
+        m_busBudget.spend(cost.busBits);
+        m_serialTxBudget.spend(cost.serialTxChars);
+        m_serialRxBudget.spend(cost.serialRxChars);
+    }
+}
+
+void CoValuesHolder::resetPollBudget()
+{
+    m_busBudget.reset();
+    m_serialTxBudget.reset();
+    m_serialRxBudget.reset();
+    m_pollTimer.invalidate();
+}
+
+void CoValuesHolder::refillPollBudget()
+{
+    const CanBusStats* stats = m_slcon->busStats();
+
+    qreal interval = static_cast<qreal>(std::max(m_updateTimer->interval(), 1)) / 1000;
+    qreal dt = m_pollTimer.isValid() ? static_cast<qreal>(m_pollTimer.restart()) / 1000 : interval;
+    if(!m_pollTimer.isValid()) m_pollTimer.start();
+    dt = qBound(0.001, dt, interval * POLL_MAX_REFILL_INTERVALS);
+
+    qreal busBitsPerSec = static_cast<qreal>(stats->bitrate()) * 1000;
+    qreal serialCharsPerSec = static_cast<qreal>(stats->serialBaud()) / std::max(stats->serialCharBits(), 1U);
+
+    m_busBudget.refill(m_busLoadTarget, stats->busLoad(), busBitsPerSec * dt, busBitsPerSec * interval);
+    m_serialTxBudget.refill(m_serialLoadTarget, stats->serialTxLoad(), serialCharsPerSec * dt, serialCharsPerSec * interval);
+    m_serialRxBudget.refill(m_serialLoadTarget, stats->serialRxLoad(), serialCharsPerSec * dt, serialCharsPerSec * interval);
+}
+
+PollBudget::Cost CoValuesHolder::pollCost(size_t dataSize) const
+{
+    return PollBudget::sdoUploadCost(dataSize, m_slcon->busStats()->adapterAnswers());
+}
+
+void CoValuesHolder::connectSLCanOpenNode()
+{
+    if(m_slcon == nullptr) return;
+
+    connect(m_slcon, &SLCanOpenNode::rpdoReceived, this, &CoValuesHolder::valueReceived);
+    connect(m_slcon, &SLCanOpenNode::valueObserved, this, &CoValuesHolder::valueReceived);
+    connect(m_slcon, &SLCanOpenNode::syncSampled, this, &CoValuesHolder::syncSampled);
+}
+
+void CoValuesHolder::disconnectSLCanOpenNode()
+{
+    if(m_slcon == nullptr) return;
+
+    disconnect(m_slcon, &SLCanOpenNode::rpdoReceived, this, &CoValuesHolder::valueReceived);
+    disconnect(m_slcon, &SLCanOpenNode::valueObserved, this, &CoValuesHolder::valueReceived);
+    disconnect(m_slcon, &SLCanOpenNode::syncSampled, this, &CoValuesHolder::syncSampled);
+}
+
 CoValuesHolder::FullIndex CoValuesHolder::makeFullIndex(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex) const
 {
     FullIndex valFullIndex = 0;
@@ -4,13 +4,23 @@
 #include <QObject>
 #include <stddef.h>
 #include "cotypes.h"
+#include "covaluetypes.h"
 #include "sdovalue.h"
+#include "covaluestable.h"
+#include "pollbudget.h"
 #include <QMap>
 #include <QPair>
+#include <QList>
+#include <QByteArray>
+#include <QVector>
+#include <QHash>
+#include <QElapsedTimer>
 
 
 class QTimer;
 class SLCanOpenNode;
+class CoValuesSnapshot;
+class SDOWriteCoalescer;
 
 
 class CoValuesHolder : public QObject
@@ -19,6 +29,24 @@ class CoValuesHolder : public QObject
 public:
 
     using HoldedSDOValuePtr = const SDOValue*;
+    using UpdatedValues = QVector<HoldedSDOValuePtr>;
+
+    // Polling priority, the lowest priority values are skipped first
+    // when the bus or serial link budget is exceeded.
+    enum PollPriority {
+        POLL_PRIORITY_LOW = 0,
+        POLL_PRIORITY_NORMAL,
+        POLL_PRIORITY_HIGH
+    };
+
+    // Deadband of the value changes.
+    enum DeadbandMode {
+        DEADBAND_NONE = 0,
+        // change in the value units.
+        DEADBAND_ABSOLUTE,
+        // change relative to the last changed value, %.
+        DEADBAND_PERCENT
+    };
 
     explicit CoValuesHolder(SLCanOpenNode* slcon = nullptr, QObject *parent = nullptr);
     ~CoValuesHolder();
@@ -32,30 +60,239 @@ public:
     int updateInterval() const;
     void setUpdateInterval(int newUpdateInterval);
 
-    HoldedSDOValuePtr addSdoValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, size_t dataSize, int timeout = 0);
+    // the value priority is the highest priority of the holders,
+    // the value period is the shortest period of the holders, ms (0 - update interval).
+    HoldedSDOValuePtr addSdoValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, size_t dataSize, int timeout = 0,
+                                  PollPriority priority = POLL_PRIORITY_NORMAL, int period = 0);
     void delSdoValue(HoldedSDOValuePtr delSdoVal);
     HoldedSDOValuePtr getSDOValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex) const;
+    QList<HoldedSDOValuePtr> sdoValues() const;
+
+    // poll period of the value, ms (0 - update interval).
+    int valuePeriod(HoldedSDOValuePtr sdoVal) const;
+    bool setValuePeriod(HoldedSDOValuePtr sdoVal, int newPeriod);
+    // periods of the holders (reference counted), the shortest one is applied.
+    bool addValuePeriod(HoldedSDOValuePtr sdoVal, int period);
+    void releaseValuePeriod(HoldedSDOValuePtr sdoVal, int period);
+
+    /*
+     * Demand of the value (reference counted).
+     * Each holder of the value demands it from addSdoValue() to delSdoValue(),
+     * consumers polling only while shown (CoValueDemand) release it while hidden.
+     * Values without demand are polled with the idle period.
+     */
+    void addValueDemand(HoldedSDOValuePtr sdoVal);
+    void releaseValueDemand(HoldedSDOValuePtr sdoVal);
+    // holders and consumers demanding the value.
+    uint valueDemand(HoldedSDOValuePtr sdoVal) const;
+
+    /*
+     * Compound read.
+     * The whole record or DOMAIN is uploaded in one transfer
+     * and split by the fields descriptors into the held values of the node.
+     * Values of the fields are not polled separately,
+     * the compound is polled while any field is in demand.
+     */
+    struct CompoundField {
+        CO::Index index;
+        CO::SubIndex subIndex;
+        // offset in the compound data, bytes.
+        size_t offset;
+        COValue::Type type;
+    };
+
+    bool addCompoundRead(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, size_t dataSize,
+                         const QVector<CompoundField>& fields, int timeout = 0, int period = 0);
+    void delCompoundRead(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex);
+
+    struct CompoundRead {
+        CO::NodeId nodeId;
+        CO::Index index;
+        CO::SubIndex subIndex;
+        size_t dataSize;
+        // poll period, ms (0 - update interval).
+        int period;
+        QVector<CompoundField> fields;
+    };
+
+    // compound reads sorted by the full index.
+    QList<CompoundRead> compoundReads() const;
+
+    // poll period of the values without demand, ms (0 - not polled).
+    int idlePeriod() const;
+    void setIdlePeriod(int newIdlePeriod);
+    // nodes of the held values.
+    QList<CO::NodeId> nodeIds() const;
+
+    /*
+     * Polling budget.
+     * Target utilization (0..1) of the CAN bus and of the serial link,
+     * 0 - unlimited. Reads are started while the estimated
+     * frames cost fits the budget left by the other traffic.
+     */
+    qreal busLoadTarget() const;
+    void setBusLoadTarget(qreal newBusLoadTarget);
+
+    qreal serialLoadTarget() const;
+    void setSerialLoadTarget(qreal newSerialLoadTarget);
+
+    // reads skipped due to the budget.
+    quint64 pollsSkipped() const;
+
+    // the value is in the batch of valuesUpdated(), O(1).
+    bool valueUpdated(HoldedSDOValuePtr sdoVal) const;
+
+    /*
+     * Change detection.
+     * Updated value is changed if the data differs from the last changed data
+     * by more than the deadband. Deadbands are set per holder (reference counted),
+     * the smallest one is applied if all holders set the deadband of the same mode.
+     */
+    bool valueChanged(HoldedSDOValuePtr sdoVal) const;
+    bool addValueDeadband(HoldedSDOValuePtr sdoVal, COValue::Type type, qreal deadband, DeadbandMode mode = DEADBAND_ABSOLUTE);
+    void releaseValueDeadband(HoldedSDOValuePtr sdoVal, COValue::Type type, qreal deadband, DeadbandMode mode = DEADBAND_ABSOLUTE);
+    // unchanged updates not repainted by the widgets.
+    quint64 repaintsAvoided() const;
+
+    /*
+     * Snapshots of the read values, readable from any thread.
+     * Values up to 8 bytes are published on the read completion.
+     */
+    const CoValuesSnapshot* snapshot() const;
+    // slot of the value in the snapshot or -1.
+    int snapshotSlot(HoldedSDOValuePtr sdoVal) const;
+
+    // Latest-value-wins writes, TPDO mapped values are sent via TPDO.
+    SDOWriteCoalescer* writeCoalescer();
+    bool writeValue(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, const void* data, size_t dataSize, int timeout = 0);
 
     template <typename T>
     T value(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex,
             const T& defVal = T(), bool* isOk = nullptr) const;
 
 signals:
+    // emitted every update interval.
     void updateBegin();
+    // values read or received since the last batch,
+    // emitted once per event loop cycle.
+    void valuesUpdated(const CoValuesHolder::UpdatedValues& values);
+    // values of the synchronous RPDOs sampled at the SYNC syncNum are updated.
+    void syncSampled(quint32 syncNum, quint32 periodUs);
 
 public slots:
     void update();
     void enableUpdating();
     void disableUpdating();
 
+private slots:
+    // poll the values with the elapsed deadline.
+    void pollDue();
+    void sdovalueReaded();
+    void sdovalueError();
+    void publishUpdates();
+    // value received by RPDO or observed on the bus.
+    void valueReceived(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex, const QByteArray& data);
+
 private:
     typedef quint32 FullIndex;
 
-    QMap<FullIndex, QPair<SDOValue*, size_t>> m_sdoValues;
+    struct ValueDeadband {
+        COValue::Type type;
+        DeadbandMode mode;
+        qreal deadband;
+    };
+
+    struct HeldValue {
+        SDOValue* sdoval;
+        size_t count;
+        PollPriority priority;
+        // update ticks skipped due to the budget.
+        uint skipped;
+        int period;
+        // next poll time, ms, -1 - not scheduled.
+        qint64 deadline;
+        uint demand;
+        // snapshot slot, -1 - not stored.
+        int slot;
+        // data of the last change.
+        QByteArray changedData;
+        QVector<ValueDeadband> deadbands;
+        // periods of the holders, ms.
+        QVector<int> periods;
+    };
+
+    // values by the full index.
+    CoValuesTable<HeldValue> m_sdoValues;
+
+    struct Compound {
+        HoldedSDOValuePtr sdoval;
+        QVector<CompoundField> fields;
+    };
+
+    // compounds by the full index.
+    QHash<FullIndex, Compound> m_compounds;
+    // field value -> compound.
+    QHash<FullIndex, FullIndex> m_compoundFields;
+
+    // earliest deadline first heap,
+    // entries of the removed or rescheduled values are skipped.
+    struct PollDeadline {
+        qint64 deadline;
+        FullIndex key;
+    };
+
+    QVector<PollDeadline> m_deadlines;
+    QElapsedTimer m_clock;
+    QTimer* m_deadlineTimer;
+    int m_idlePeriod;
+
+    // updated values batch,
+    // value -> changed.
+    UpdatedValues m_updatedValues;
+    QHash<HoldedSDOValuePtr, bool> m_updatedFlags;
+    // flags of the batch being emitted.
+    QHash<HoldedSDOValuePtr, bool> m_publishedFlags;
+    quint64 m_repaintsAvoided;
+    QTimer* m_publishTimer;
+
+    CoValuesSnapshot* m_snapshot;
+
+    qreal m_busLoadTarget;
+    qreal m_serialLoadTarget;
+    PollBudget m_busBudget;
+    PollBudget m_serialTxBudget;
+    PollBudget m_serialRxBudget;
+    QElapsedTimer m_pollTimer;
+    quint64 m_pollsSkipped;
 
     SLCanOpenNode* m_slcon;
     bool m_updatingEnabled;
     QTimer* m_updateTimer;
+    SDOWriteCoalescer* m_writeCoalescer;
+
+    void connectSLCanOpenNode();
+    void disconnectSLCanOpenNode();
+
+    // -1 - not polled.
+    qint64 effectivePeriod(const HeldValue& val) const;
+    void reschedule(FullIndex key, HeldValue& val);
+    void addDemand(FullIndex key, HeldValue& val);
+    void addCompoundDemand(FullIndex fieldKey);
+    void releaseCompoundDemand(FullIndex fieldKey);
+    // update the fields values from the compound data.
+    void splitCompound(const Compound& compound);
+    bool pollable(const HeldValue& val) const;
+    static bool deadlineLater(const PollDeadline& a, const PollDeadline& b);
+    void pushDeadline(qint64 deadline, FullIndex key);
+    void deleteValue(const HeldValue& val);
+    // compare with the last changed data and update it.
+    bool detectChange(HeldValue& val);
+    void schedulePoll();
+    void stopPolling();
+    void pollValues(QVector<HeldValue*>& values);
+    void resetPollBudget();
+    void refillPollBudget();
+    PollBudget::Cost pollCost(size_t dataSize) const;
 
     FullIndex makeFullIndex(CO::NodeId valNodeId, CO::Index valIndex, CO::SubIndex valSubIndex) const;
 };
@@ -0,0 +1,169 @@
+#include "covaluessnapshot.h"
+#include <algorithm>
+
+
+// key of the free slot.
+#define SNAPSHOT_FREE_KEY 0xffffffff
+#define SNAPSHOT_INFO_SIZE_MASK 0xff
+#define SNAPSHOT_INFO_QUALITY_SHIFT 8
+#define SNAPSHOT_INFO_QUALITY_MASK 0xff
+
+
+
+CoValuesSnapshot::CoValuesSnapshot(int newCapacity)
+{
+    m_capacity = std::max(newCapacity, 1);
+    m_slots.reset(new Slot[m_capacity]);
+
+    m_freeSlots.reserve(m_capacity);
+
+    // the lowest slots are allocated first.
+    for(int i = m_capacity - 1; i >= 0; i --){
+        Slot& s = m_slots[i];
+        s.seq.store(0, std::memory_order_relaxed);
+        s.key.store(SNAPSHOT_FREE_KEY, std::memory_order_relaxed);
+        s.info.store(0, std::memory_order_relaxed);
+        s.timestamp.store(0, std::memory_order_relaxed);
+        s.data.store(0, std::memory_order_relaxed);
+
+        m_freeSlots.append(i);
+    }
+
+    m_startTp = meas_clock::now();
+}
+
+CoValuesSnapshot::~CoValuesSnapshot()
+{
+}
+
+int CoValuesSnapshot::capacity() const
+{
+    return m_capacity;
+}
+
+int CoValuesSnapshot::alloc(quint32 key, size_t dataSize)
+{
+    if(dataSize == 0 || dataSize > MAX_DATA_SIZE) return -1;
+    if(m_freeSlots.isEmpty()) return -1;
+
+    int slot = m_freeSlots.takeLast();
+    Slot& s = m_slots[slot];
+
+    beginWrite(s);
+    s.key.store(key, std::memory_order_relaxed);
+    s.info.store(static_cast<quint32>(dataSize) | (QUALITY_NONE << SNAPSHOT_INFO_QUALITY_SHIFT), std::memory_order_relaxed);
+    s.timestamp.store(timestamp(), std::memory_order_relaxed);
+    s.data.store(0, std::memory_order_relaxed);
+    endWrite(s);
+
+    return slot;
+}
+
+void CoValuesSnapshot::release(int slot)
+{
+    if(slot < 0 || slot >= m_capacity) return;
+
+    Slot& s = m_slots[slot];
+    if(s.key.load(std::memory_order_relaxed) == SNAPSHOT_FREE_KEY) return;
+
+    beginWrite(s);
+    s.key.store(SNAPSHOT_FREE_KEY, std::memory_order_relaxed);
+    s.info.store(0, std::memory_order_relaxed);
+    endWrite(s);
+
+    m_freeSlots.append(slot);
+}
+
+void CoValuesSnapshot::publish(int slot, const void* data, size_t dataSize)
+{
+    if(slot < 0 || slot >= m_capacity) return;
+    if(data == nullptr) return;
+
+    Slot& s = m_slots[slot];
+
+    size_t slotSize = s.info.load(std::memory_order_relaxed) & SNAPSHOT_INFO_SIZE_MASK;
+    if(slotSize == 0) return;
+
+    quint64 word = 0;
+    memcpy(&word, data, std::min(dataSize, slotSize));
+
+    beginWrite(s);
+    s.data.store(word, std::memory_order_relaxed);
+    s.timestamp.store(timestamp(), std::memory_order_relaxed);
+    s.info.store(static_cast<quint32>(slotSize) | (QUALITY_GOOD << SNAPSHOT_INFO_QUALITY_SHIFT), std::memory_order_relaxed);
+    endWrite(s);
+}
+
+void CoValuesSnapshot::setQuality(int slot, Quality quality)
+{
+    if(slot < 0 || slot >= m_capacity) return;
+
+    Slot& s = m_slots[slot];
+
+    quint32 info = s.info.load(std::memory_order_relaxed);
+    if((info & SNAPSHOT_INFO_SIZE_MASK) == 0) return;
+
+    info &= ~(SNAPSHOT_INFO_QUALITY_MASK << SNAPSHOT_INFO_QUALITY_SHIFT);
+    info |= static_cast<quint32>(quality) << SNAPSHOT_INFO_QUALITY_SHIFT;
+
+    beginWrite(s);
+    s.info.store(info, std::memory_order_relaxed);
+    s.timestamp.store(timestamp(), std::memory_order_relaxed);
+    endWrite(s);
+}
+
+bool CoValuesSnapshot::read(int slot, Sample* sample) const
+{
+    if(slot < 0 || slot >= m_capacity) return false;
+    if(sample == nullptr) return false;
+
+    const Slot& s = m_slots[slot];
+
+    quint32 seq1, seq2;
+    quint32 key, info;
+    qint64 ts;
+    quint64 word;
+
+    do{
+        seq1 = s.seq.load(std::memory_order_acquire);
+        if(seq1 & 1) continue;
+
+        key = s.key.load(std::memory_order_relaxed);
+        info = s.info.load(std::memory_order_relaxed);
+        ts = s.timestamp.load(std::memory_order_relaxed);
+        word = s.data.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq2 = s.seq.load(std::memory_order_relaxed);
+    }while((seq1 & 1) || seq1 != seq2);
+
+    if(key == SNAPSHOT_FREE_KEY) return false;
+
+    sample->key = key;
+    sample->timestamp = ts;
+    sample->quality = static_cast<Quality>((info >> SNAPSHOT_INFO_QUALITY_SHIFT) & SNAPSHOT_INFO_QUALITY_MASK);
+    sample->dataSize = info & SNAPSHOT_INFO_SIZE_MASK;
+    memcpy(sample->data, &word, sizeof(sample->data));
+
+    return true;
+}
+
+void CoValuesSnapshot::beginWrite(Slot& s)
+{
+    quint32 seq = s.seq.load(std::memory_order_relaxed);
+
+    s.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void CoValuesSnapshot::endWrite(Slot& s)
+{
+    quint32 seq = s.seq.load(std::memory_order_relaxed);
+
+    s.seq.store(seq + 1, std::memory_order_release);
+}
+
+qint64 CoValuesSnapshot::timestamp() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(meas_clock::now() - m_startTp).count();
+}
@@ -0,0 +1,104 @@
+#ifndef COVALUESSNAPSHOT_H
+#define COVALUESSNAPSHOT_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+
+/*
+ * Snapshots of the finished values.
+ * Values are stored in the fixed array of slots,
+ * each slot is protected by the sequence counter (seqlock):
+ * single writer (holder thread), readers from any thread are lock-free
+ * and retry when the slot is being written.
+ */
+class CoValuesSnapshot
+{
+public:
+
+    enum Quality {
+        // not read yet.
+        QUALITY_NONE = 0,
+        QUALITY_GOOD = 1,
+        // last transfer failed, data is the last good value.
+        QUALITY_ERROR = 2
+    };
+
+    struct Sample {
+        // full index (node id, index, subindex) of the slot value.
+        quint32 key;
+        // us from the snapshot creation.
+        qint64 timestamp;
+        Quality quality;
+        size_t dataSize;
+        quint8 data[8];
+    };
+
+    static const size_t MAX_DATA_SIZE = 8;
+    static const int DEFAULT_CAPACITY = 16384;
+
+    explicit CoValuesSnapshot(int newCapacity = DEFAULT_CAPACITY);
+    ~CoValuesSnapshot();
+
+    int capacity() const;
+
+    // Writer.
+    // slot for the value or -1 if the store is full or the value is too large.
+    int alloc(quint32 key, size_t dataSize);
+    void release(int slot);
+    void publish(int slot, const void* data, size_t dataSize);
+    void setQuality(int slot, Quality quality);
+
+    // Readers.
+    bool read(int slot, Sample* sample) const;
+
+    template <typename T>
+    T value(int slot, const T& defVal = T(), bool* isOk = nullptr) const;
+
+private:
+    using meas_clock = std::chrono::steady_clock;
+
+    struct Slot {
+        // odd - the slot is being written.
+        std::atomic<quint32> seq;
+        std::atomic<quint32> key;
+        // dataSize:8 | quality:8.
+        std::atomic<quint32> info;
+        std::atomic<qint64> timestamp;
+        std::atomic<quint64> data;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    int m_capacity;
+    // writer only.
+    QVector<int> m_freeSlots;
+
+    meas_clock::time_point m_startTp;
+
+    void beginWrite(Slot& s);
+    void endWrite(Slot& s);
+    qint64 timestamp() const;
+};
+
+template <typename T>
+T CoValuesSnapshot::value(int slot, const T& defVal, bool* isOk) const
+{
+    Sample sample;
+
+    if(!read(slot, &sample) || sample.quality == QUALITY_NONE || sample.dataSize != sizeof(T))
+    { if(isOk) *isOk = false; return defVal; }
+
+    T val;
+    memcpy(&val, sample.data, sizeof(T));
+
+    if(isOk) *isOk = true;
+
+    return val;
+}
+
+#endif // COVALUESSNAPSHOT_H
@@ -0,0 +1,252 @@
+#ifndef COVALUESTABLE_H
+#define COVALUESTABLE_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <algorithm>
+
+
+/*
+ * Flat open addressing hash table of the values
+ * by the 32 bit full index (node id, index, subindex).
+ * Keys and values are stored in the separate arrays,
+ * probing (linear) touches the keys array only.
+ * Erased slots are marked as deleted and reused,
+ * so the slots may be erased while iterating.
+ * Slots are stable until the next insertion.
+ */
+template <typename T>
+class CoValuesTable
+{
+public:
+    using Key = quint32;
+
+    // reserved keys, the node id is at most 127.
+    static constexpr Key EMPTY_KEY = 0xffffffff;
+    static constexpr Key DELETED_KEY = 0xfffffffe;
+
+    static constexpr int MIN_CAPACITY = 16;
+
+    CoValuesTable();
+
+    int size() const;
+    bool isEmpty() const;
+    int capacity() const;
+
+    void clear();
+    void reserve(int count);
+
+    // slot of the key or -1.
+    int find(Key key) const;
+    // slot of the inserted value, -1 if the key exists.
+    int insert(Key key, const T& value);
+    void erase(int slot);
+
+    // for(int i = begin(); i != end(); i = next(i)).
+    int begin() const;
+    int end() const;
+    int next(int slot) const;
+
+    Key key(int slot) const;
+    T& value(int slot);
+    const T& value(int slot) const;
+
+private:
+    QVector<Key> m_keys;
+    QVector<T> m_values;
+    int m_size;
+    // used and deleted slots.
+    int m_used;
+    int m_shift;
+
+    int home(Key key) const;
+    void rehash(int newCapacity);
+};
+
+template <typename T>
+CoValuesTable<T>::CoValuesTable()
+{
+    m_size = 0;
+    m_used = 0;
+    m_shift = 32;
+}
+
+template <typename T>
+int CoValuesTable<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+bool CoValuesTable<T>::isEmpty() const
+{
+    return m_size == 0;
+}
+
+template <typename T>
+int CoValuesTable<T>::capacity() const
+{
+    return m_keys.size();
+}
+
+template <typename T>
+void CoValuesTable<T>::clear()
+{
+    m_keys.clear();
+    m_values.clear();
+    m_size = 0;
+    m_used = 0;
+    m_shift = 32;
+}
+
+template <typename T>
+void CoValuesTable<T>::reserve(int count)
+{
+    int newCapacity = MIN_CAPACITY;
+    while(newCapacity < count * 2) newCapacity *= 2;
+
+    if(newCapacity > m_keys.size()) rehash(newCapacity);
+}
+
+template <typename T>
+int CoValuesTable<T>::find(Key key) const
+{
+    if(m_size == 0) return -1;
+
+    int mask = m_keys.size() - 1;
+
+    // the table always has empty slots.
+    for(int i = home(key);; i = (i + 1) & mask){
+        Key k = m_keys[i];
+        if(k == key) return i;
+        if(k == EMPTY_KEY) return -1;
+    }
+}
+
+template <typename T>
+int CoValuesTable<T>::insert(Key key, const T& value)
+{
+    Q_ASSERT(key < DELETED_KEY);
+
+    // max load is 3/4 including the deleted slots.
+    if((m_used + 1) * 4 > m_keys.size() * 3){
+        int newCapacity = std::max(m_keys.size(), static_cast<int>(MIN_CAPACITY));
+        while((m_size + 1) * 2 > newCapacity) newCapacity *= 2;
+        rehash(newCapacity);
+    }
+
+    int mask = m_keys.size() - 1;
+    int slot = -1;
+
+    for(int i = home(key);; i = (i + 1) & mask){
+        Key k = m_keys[i];
+        if(k == key) return -1;
+        if(k == DELETED_KEY){
+            if(slot < 0) slot = i;
+            continue;
+        }
+        if(k == EMPTY_KEY){
+            if(slot < 0){
+                slot = i;
+                m_used ++;
+            }
+            break;
+        }
+    }
+
+    m_keys[slot] = key;
+    m_values[slot] = value;
+    m_size ++;
+
+    return slot;
+}
+
+template <typename T>
+void CoValuesTable<T>::erase(int slot)
+{
+    if(slot < 0 || slot >= m_keys.size()) return;
+    if(m_keys[slot] >= DELETED_KEY) return;
+
+    m_keys[slot] = DELETED_KEY;
+    m_values[slot] = T();
+    m_size --;
+}
+
+template <typename T>
+int CoValuesTable<T>::begin() const
+{
+    return next(-1);
+}
+
+template <typename T>
+int CoValuesTable<T>::end() const
+{
+    return m_keys.size();
+}
+
+template <typename T>
+int CoValuesTable<T>::next(int slot) const
+{
+    int capacity = m_keys.size();
+
+    for(slot ++; slot < capacity; slot ++){
+        if(m_keys[slot] < DELETED_KEY) break;
+    }
+
+    return slot;
+}
+
+template <typename T>
+typename CoValuesTable<T>::Key CoValuesTable<T>::key(int slot) const
+{
+    return m_keys[slot];
+}
+
+template <typename T>
+T& CoValuesTable<T>::value(int slot)
+{
+    return m_values[slot];
+}
+
+template <typename T>
+const T& CoValuesTable<T>::value(int slot) const
+{
+    return m_values[slot];
+}
+
+template <typename T>
+int CoValuesTable<T>::home(Key key) const
+{
+    // Fibonacci hashing, the node id and index bits are mixed into the high bits.
+    return static_cast<int>(static_cast<quint32>(key * 0x9e3779b9U) >> m_shift);
+}
+
+template <typename T>
+void CoValuesTable<T>::rehash(int newCapacity)
+{
+    QVector<Key> keys(newCapacity, EMPTY_KEY);
+    QVector<T> values(newCapacity);
+
+    int shift = 32;
+    for(int c = newCapacity; c > 1; c >>= 1) shift --;
+
+    keys.swap(m_keys);
+    values.swap(m_values);
+    m_shift = shift;
+    m_used = m_size;
+
+    int mask = newCapacity - 1;
+
+    for(int j = 0; j < keys.size(); j ++){
+        Key key = keys[j];
+        if(key >= DELETED_KEY) continue;
+
+        int i = home(key);
+        while(m_keys[i] != EMPTY_KEY) i = (i + 1) & mask;
+
+        m_keys[i] = key;
+        m_values[i] = values[j];
+    }
+}
+
+#endif // COVALUESTABLE_H
@@ -1,5 +1,11 @@
 #include "covaluetypes.h"
 #include <QObject>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 
 
@@ -15,7 +21,305 @@ QList<QPair<QString, COValue::Type>> COValue::getTypesNames()
           << qMakePair(QObject::tr("U8"), COValue::U8)
           << qMakePair(QObject::tr("IQ24"), COValue::IQ24)
           << qMakePair(QObject::tr("IQ15"), COValue::IQ15)
-          << qMakePair(QObject::tr("IQ7"), COValue::IQ7);
+          << qMakePair(QObject::tr("IQ7"), COValue::IQ7)
+          << qMakePair(QObject::tr("I64"), COValue::I64)
+          << qMakePair(QObject::tr("U64"), COValue::U64)
+          << qMakePair(QObject::tr("REAL32"), COValue::REAL32)
+          << qMakePair(QObject::tr("REAL64"), COValue::REAL64);
 
     return types;
 }
+
+QString COValue::typeName(Type type)
+{
+    if(isBitField(type)){
+        QString word = QObject::tr("U%1").arg(bitFieldWordSize(type) * 8);
+        int offset = bitFieldOffset(type);
+        int width = bitFieldWidth(type);
+
+        if(width == 1) return QObject::tr("%1 [%2]").arg(word).arg(offset);
+        return QObject::tr("%1 [%2..%3]").arg(word).arg(offset).arg(offset + width - 1);
+    }
+
+    auto types = getTypesNames();
+
+    for(auto& t: types){
+        if(t.second == type) return t.first;
+    }
+
+    return QString();
+}
+
+
+namespace {
+
+// IQ fraction bits scale.
+template <int Q>
+constexpr double iqScale()
+{
+    return static_cast<double>(1 << Q);
+}
+
+// converted count by the vector kernel.
+template <typename T, int Q>
+size_t valuesFromSimd(const uint8_t* src, double* dst, size_t count)
+{
+    size_t i = 0;
+
+    // 64 bit & floating point types are converted by the scalar code.
+    if constexpr(!std::is_integral_v<T> || sizeof(T) > 4){
+        Q_UNUSED(src);
+        Q_UNUSED(dst);
+        Q_UNUSED(count);
+        return i;
+    }else{
+#if defined(__AVX2__)
+        const __m256d scale = _mm256_set1_pd(1.0 / iqScale<Q>());
+
+        for(; i + 4 <= count; i += 4){
+            __m128i v;
+
+            if constexpr(sizeof(T) == 4){
+                v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+                if constexpr(std::is_unsigned_v<T>){
+                    // biased to the signed range.
+                    v = _mm_xor_si128(v, _mm_set1_epi32(INT32_MIN));
+                }
+            }else if constexpr(sizeof(T) == 2){
+                v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 2));
+                v = std::is_unsigned_v<T> ? _mm_cvtepu16_epi32(v) : _mm_cvtepi16_epi32(v);
+            }else{
+                int32_t raw;
+                memcpy(&raw, src + i, sizeof(raw));
+                v = _mm_cvtsi32_si128(raw);
+                v = std::is_unsigned_v<T> ? _mm_cvtepu8_epi32(v) : _mm_cvtepi8_epi32(v);
+            }
+
+            __m256d d = _mm256_cvtepi32_pd(v);
+            if constexpr(sizeof(T) == 4 && std::is_unsigned_v<T>){
+                d = _mm256_add_pd(d, _mm256_set1_pd(2147483648.0));
+            }
+            if constexpr(Q != 0){
+                d = _mm256_mul_pd(d, scale);
+            }
+
+            _mm256_storeu_pd(dst + i, d);
+        }
+#elif defined(__SSE2__)
+        const __m128d scale = _mm_set1_pd(1.0 / iqScale<Q>());
+        const __m128i zero = _mm_setzero_si128();
+
+        for(; i + 2 <= count; i += 2){
+            __m128i v;
+
+            if constexpr(sizeof(T) == 4){
+                v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 4));
+                if constexpr(std::is_unsigned_v<T>){
+                    v = _mm_xor_si128(v, _mm_set1_epi32(INT32_MIN));
+                }
+            }else if constexpr(sizeof(T) == 2){
+                int32_t raw;
+                memcpy(&raw, src + i * 2, sizeof(raw));
+                v = _mm_cvtsi32_si128(raw);
+                if constexpr(std::is_unsigned_v<T>){
+                    v = _mm_unpacklo_epi16(v, zero);
+                }else{
+                    v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                }
+            }else{
+                uint16_t raw;
+                memcpy(&raw, src + i, sizeof(raw));
+                v = _mm_cvtsi32_si128(raw);
+                if constexpr(std::is_unsigned_v<T>){
+                    v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+                }else{
+                    v = _mm_unpacklo_epi8(v, v);
+                    v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 24);
+                }
+            }
+
+            __m128d d = _mm_cvtepi32_pd(v);
+            if constexpr(sizeof(T) == 4 && std::is_unsigned_v<T>){
+                d = _mm_add_pd(d, _mm_set1_pd(2147483648.0));
+            }
+            if constexpr(Q != 0){
+                d = _mm_mul_pd(d, scale);
+            }
+
+            _mm_storeu_pd(dst + i, d);
+        }
+#else
+        Q_UNUSED(src);
+        Q_UNUSED(dst);
+        Q_UNUSED(count);
+#endif
+
+        return i;
+    }
+}
+
+template <typename T, int Q>
+void valuesFromArray(const void* valuesData, double* values, size_t count)
+{
+    const uint8_t* src = static_cast<const uint8_t*>(valuesData);
+
+    size_t i = valuesFromSimd<T, Q>(src, values, count);
+
+    for(; i < count; i ++){
+        T v;
+        memcpy(&v, src + i * sizeof(T), sizeof(T));
+        values[i] = static_cast<double>(v) / iqScale<Q>();
+    }
+}
+
+// converted count by the vector kernel.
+template <typename T, int Q>
+size_t valuesToSimd(uint8_t* dst, const double* src, size_t count)
+{
+    size_t i = 0;
+
+    // narrow types are truncated as by the scalar cast.
+    if constexpr(std::is_integral_v<T> && sizeof(T) == 4 && std::is_signed_v<T>){
+#if defined(__AVX2__)
+        const __m256d scale = _mm256_set1_pd(iqScale<Q>());
+
+        for(; i + 4 <= count; i += 4){
+            __m256d d = _mm256_loadu_pd(src + i);
+            if constexpr(Q != 0){
+                d = _mm256_mul_pd(d, scale);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm256_cvttpd_epi32(d));
+        }
+#elif defined(__SSE2__)
+        const __m128d scale = _mm_set1_pd(iqScale<Q>());
+
+        for(; i + 2 <= count; i += 2){
+            __m128d d = _mm_loadu_pd(src + i);
+            if constexpr(Q != 0){
+                d = _mm_mul_pd(d, scale);
+            }
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 4), _mm_cvttpd_epi32(d));
+        }
+#else
+        Q_UNUSED(dst);
+        Q_UNUSED(src);
+        Q_UNUSED(count);
+#endif
+    }else{
+        Q_UNUSED(dst);
+        Q_UNUSED(src);
+        Q_UNUSED(count);
+    }
+
+    return i;
+}
+
+template <typename T, int Q>
+void valuesToArray(void* valuesData, const double* values, size_t count)
+{
+    uint8_t* dst = static_cast<uint8_t*>(valuesData);
+
+    size_t i = valuesToSimd<T, Q>(dst, values, count);
+
+    for(; i < count; i ++){
+        T v = static_cast<T>(values[i] * iqScale<Q>());
+        memcpy(dst + i * sizeof(T), &v, sizeof(T));
+    }
+}
+
+using ValuesFromFn = void (*)(const void*, double*, size_t);
+using ValuesToFn = void (*)(void*, const double*, size_t);
+
+template <COValue::Type T>
+constexpr ValuesFromFn valuesFromFn()
+{
+    using Raw = typename COValue::TypeTraits<T>::Raw;
+
+    if constexpr(std::is_void_v<Raw>){
+        return nullptr;
+    }else{
+        return &valuesFromArray<Raw, COValue::TypeTraits<T>::Q>;
+    }
+}
+
+template <COValue::Type T>
+constexpr ValuesToFn valuesToFn()
+{
+    using Raw = typename COValue::TypeTraits<T>::Raw;
+
+    if constexpr(std::is_void_v<Raw>){
+        return nullptr;
+    }else{
+        return &valuesToArray<Raw, COValue::TypeTraits<T>::Q>;
+    }
+}
+
+template <size_t... I>
+constexpr std::array<ValuesFromFn, sizeof...(I)> makeValuesFromTable(std::index_sequence<I...>)
+{
+    return {{ valuesFromFn<static_cast<COValue::Type>(I)>()... }};
+}
+
+template <size_t... I>
+constexpr std::array<ValuesToFn, sizeof...(I)> makeValuesToTable(std::index_sequence<I...>)
+{
+    return {{ valuesToFn<static_cast<COValue::Type>(I)>()... }};
+}
+
+constexpr auto valuesFromTable = makeValuesFromTable(std::make_index_sequence<COValue::TYPES_COUNT>{});
+constexpr auto valuesToTable = makeValuesToTable(std::make_index_sequence<COValue::TYPES_COUNT>{});
+
+}
+
+
+bool COValue::valuesFrom(const void* valuesData, Type type, double* values, size_t count)
+{
+    if(count == 0) return true;
+    if(valuesData == nullptr || values == nullptr) return false;
+
+    if(isBitField(type)){
+        if(!isValid(type)) return false;
+
+        const uint8_t* src = static_cast<const uint8_t*>(valuesData);
+        size_t size = bitFieldWordSize(type);
+
+        for(size_t i = 0; i < count; i ++){
+            values[i] = valueFrom<double>(src + i * size, type);
+        }
+
+        return true;
+    }
+
+    const int N = static_cast<int>(type);
+    if(N < 0 || N >= TYPES_COUNT || valuesFromTable[N] == nullptr) return false;
+
+    valuesFromTable[N](valuesData, values, count);
+
+    return true;
+}
+
+bool COValue::valuesTo(void* valuesData, Type type, const double* values, size_t count)
+{
+    if(count == 0) return true;
+    if(valuesData == nullptr || values == nullptr) return false;
+
+    if(isBitField(type)){
+        if(!isValid(type)) return false;
+
+        uint8_t* dst = static_cast<uint8_t*>(valuesData);
+        size_t size = bitFieldWordSize(type);
+
+        for(size_t i = 0; i < count; i ++){
+            valueTo<double>(dst + i * size, type, values[i]);
+        }
+
+        return true;
+    }
+
+    const int N = static_cast<int>(type);
+    if(N < 0 || N >= TYPES_COUNT || valuesToTable[N] == nullptr) return false;
+
+    valuesToTable[N](valuesData, values, count);
+
+    return true;
+}
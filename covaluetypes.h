@@ -4,7 +4,9 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
+#include <algorithm>
 #include <array>
+#include <type_traits>
 #include <utility>
 #include <variant>
 #include <QPair>
@@ -27,41 +29,214 @@ enum Type {
     IQ15 = 7,
     IQ7 = 8,
     STR = 9,
-    MEM = 10
+    MEM = 10,
+    REAL32 = 11,
+    REAL64 = 12,
+    I64 = 13,
+    U64 = 14,
+    // bit field flag, see bitField().
+    BITFIELD = 0x1000
 };
 
+// count of the plain types.
+constexpr int TYPES_COUNT = U64 + 1;
+
 
 extern QList<QPair<QString, Type>> getTypesNames();
+// name of any type including the bit fields.
+extern QString typeName(Type type);
+
+/*
+ * Bulk conversion of the packed values arrays.
+ * Kernels are instantiated per type, SSE2/AVX2 are used if enabled
+ * by the compiler flags, the tail is converted by the scalar code.
+ * Return false for the STR & MEM types.
+ */
+extern bool valuesFrom(const void* valuesData, Type type, double* values, size_t count);
+extern bool valuesTo(void* valuesData, Type type, const double* values, size_t count);
 
 
-template <int N, typename ET, ET first, ET next, ET... other>
-inline constexpr int FindEnumElement(const ET target)
+/*
+ * Bit field of the unsigned word of 1, 2 or 4 bytes.
+ * The type is BITFIELD | size code:2 | (width - 1):5 | offset:5,
+ * the value is the unsigned field, the other bits are kept on write.
+ */
+constexpr bool isBitField(const Type type)
 {
-    if(target == first){
-        return N;
-    }else{
-        return FindEnumElement<N + 1, ET, next, other...>(target);
-    }
+    return (static_cast<int>(type) & BITFIELD) != 0;
+}
+
+constexpr int bitFieldOffset(const Type type)
+{
+    return static_cast<int>(type) & 0x1f;
+}
+
+constexpr int bitFieldWidth(const Type type)
+{
+    return ((static_cast<int>(type) >> 5) & 0x1f) + 1;
+}
+
+constexpr size_t bitFieldWordSize(const Type type)
+{
+    return static_cast<size_t>(1) << ((static_cast<int>(type) >> 10) & 0x3);
 }
 
-template <int N, typename ET, ET first>
-inline constexpr int FindEnumElement(const ET target)
+// plain type or the bit field fitting the word.
+constexpr bool isValid(const Type type)
 {
-    if(target == first){
-        return N;
+    const int N = static_cast<int>(type);
+
+    if(!isBitField(type)) return N >= 0 && N < TYPES_COUNT;
+
+    // unknown bits or size code 3.
+    if((N & ~0x1fff) != 0 || ((N >> 10) & 0x3) > 2) return false;
+
+    return bitFieldOffset(type) + bitFieldWidth(type) <= static_cast<int>(bitFieldWordSize(type) * 8);
+}
+
+// BITFIELD if the field does not fit the word.
+constexpr Type bitField(const size_t wordSize, const int offset, const int width = 1)
+{
+    int sizeCode = (wordSize == 4) ? 2 : (wordSize == 2) ? 1 : 0;
+
+    if(wordSize != 1 && wordSize != 2 && wordSize != 4) return BITFIELD;
+    if(offset < 0 || width < 1 || offset + width > static_cast<int>(wordSize * 8)) return BITFIELD;
+
+    return static_cast<Type>(BITFIELD | (sizeCode << 10) | ((width - 1) << 5) | offset);
+}
+
+
+/*
+ * Plain type traits.
+ * Raw - storage type (void - not convertible), Q - IQ fraction bits.
+ */
+template <Type T> struct TypeTraits { using Raw = void; static constexpr int Q = 0; };
+template <> struct TypeTraits<I32> { using Raw = int32_t; static constexpr int Q = 0; };
+template <> struct TypeTraits<I16> { using Raw = int16_t; static constexpr int Q = 0; };
+template <> struct TypeTraits<I8> { using Raw = int8_t; static constexpr int Q = 0; };
+template <> struct TypeTraits<U32> { using Raw = uint32_t; static constexpr int Q = 0; };
+template <> struct TypeTraits<U16> { using Raw = uint16_t; static constexpr int Q = 0; };
+template <> struct TypeTraits<U8> { using Raw = uint8_t; static constexpr int Q = 0; };
+template <> struct TypeTraits<IQ24> { using Raw = int32_t; static constexpr int Q = 24; };
+template <> struct TypeTraits<IQ15> { using Raw = int32_t; static constexpr int Q = 15; };
+template <> struct TypeTraits<IQ7> { using Raw = int32_t; static constexpr int Q = 7; };
+template <> struct TypeTraits<REAL32> { using Raw = float; static constexpr int Q = 0; };
+template <> struct TypeTraits<REAL64> { using Raw = double; static constexpr int Q = 0; };
+template <> struct TypeTraits<I64> { using Raw = int64_t; static constexpr int Q = 0; };
+template <> struct TypeTraits<U64> { using Raw = uint64_t; static constexpr int Q = 0; };
+
+
+template <Type T>
+constexpr size_t rawSize()
+{
+    using Raw = typename TypeTraits<T>::Raw;
+
+    if constexpr(std::is_void_v<Raw>){
+        return 0;
     }else{
-        return -1;
+        return sizeof(Raw);
     }
 }
 
+template <size_t... I>
+constexpr std::array<size_t, sizeof...(I)> makeSizesTable(std::index_sequence<I...>)
+{
+    return {{ rawSize<static_cast<Type>(I)>()... }};
+}
+
 template <typename ET>
 constexpr size_t typeSize(const ET target, const int defSize = 0)
 {
-    const auto sizes = std::array{4  , 2  , 1 , 4  , 2  , 1 , 4   , 4   , 4  , 0  , 0  };
+    constexpr auto sizes = makeSizesTable(std::make_index_sequence<TYPES_COUNT>{});
+
+    const Type type = static_cast<Type>(target);
+
+    if(isBitField(type)) return bitFieldWordSize(type);
 
-    const int N = FindEnumElement<0, ET, I32, I16, I8, U32, U16, U8, IQ24, IQ15, IQ7, STR, MEM>(target);
+    const int N = static_cast<int>(type);
 
-    return (N >= 0) ? sizes[N] : defSize;
+    return (N >= 0 && N < TYPES_COUNT && sizes[N] != 0) ? sizes[N] : static_cast<size_t>(defSize);
+}
+
+
+template <typename Type, COValue::Type T>
+Type rawValueFrom(const void* valueData)
+{
+    using Raw = typename TypeTraits<T>::Raw;
+
+    Raw raw;
+    memcpy(&raw, valueData, sizeof(Raw));
+
+    if constexpr(TypeTraits<T>::Q != 0){
+        return Type(raw) / (1<<TypeTraits<T>::Q);
+    }else{
+        return Type(raw);
+    }
+}
+
+template <typename Type, COValue::Type T>
+void rawValueTo(void* valueData, const Type& val)
+{
+    using Raw = typename TypeTraits<T>::Raw;
+
+    Raw raw;
+
+    if constexpr(TypeTraits<T>::Q != 0){
+        raw = static_cast<Raw>(val * (1<<TypeTraits<T>::Q));
+    }else{
+        raw = static_cast<Raw>(val);
+    }
+
+    memcpy(valueData, &raw, sizeof(Raw));
+}
+
+template <typename Type, COValue::Type T>
+constexpr auto valueFromFn() -> Type (*)(const void*)
+{
+    if constexpr(rawSize<T>() != 0){
+        return &rawValueFrom<Type, T>;
+    }else{
+        return nullptr;
+    }
+}
+
+template <typename Type, COValue::Type T>
+constexpr auto valueToFn() -> void (*)(void*, const Type&)
+{
+    if constexpr(rawSize<T>() != 0){
+        return &rawValueTo<Type, T>;
+    }else{
+        return nullptr;
+    }
+}
+
+// conversion functions by the type, nullptr if not convertible.
+template <typename Type, size_t... I>
+constexpr auto makeValueFromTable(std::index_sequence<I...>)
+{
+    return std::array<Type (*)(const void*), sizeof...(I)>{{ valueFromFn<Type, static_cast<COValue::Type>(I)>()... }};
+}
+
+template <typename Type, size_t... I>
+constexpr auto makeValueToTable(std::index_sequence<I...>)
+{
+    return std::array<void (*)(void*, const Type&), sizeof...(I)>{{ valueToFn<Type, static_cast<COValue::Type>(I)>()... }};
+}
+
+inline uint32_t bitFieldWord(const void* valueData, const COValue::Type type)
+{
+    uint32_t word = 0;
+    // little endian.
+    memcpy(&word, valueData, std::min(bitFieldWordSize(type), sizeof(word)));
+
+    return word;
+}
+
+inline uint32_t bitFieldMask(const COValue::Type type)
+{
+    int width = bitFieldWidth(type);
+
+    return (width >= 32) ? 0xffffffff : ((static_cast<uint32_t>(1) << width) - 1);
 }
 
 
@@ -72,30 +247,15 @@ Type valueFrom(const void* valueData, const std::variant<COValue::Type, size_t>
     const auto pSize = std::get_if<size_t>(&typeOrSize);
 
     if(pType){
-        switch(*pType){
-        default:
-            break;
-        case I32:
-            return Type(*static_cast<const int32_t*>(valueData));
-        case I16:
-            return Type(*static_cast<const int16_t*>(valueData));
-        case I8:
-            return Type(*static_cast<const int8_t*>(valueData));
-        case U32:
-            return Type(*static_cast<const uint32_t*>(valueData));
-        case U16:
-            return Type(*static_cast<const uint16_t*>(valueData));
-        case U8:
-            return Type(*static_cast<const uint8_t*>(valueData));
-        case IQ24:
-            return Type(*static_cast<const int32_t*>(valueData)) / (1<<24);
-        case IQ15:
-            return Type(*static_cast<const int32_t*>(valueData)) / (1<<15);
-        case IQ7:
-            return Type(*static_cast<const int32_t*>(valueData)) / (1<<7);
-        case STR:
-        case MEM:
-            break;
+        if(isBitField(*pType)){
+            return Type((bitFieldWord(valueData, *pType) >> bitFieldOffset(*pType)) & bitFieldMask(*pType));
+        }
+
+        static constexpr auto conv = makeValueFromTable<Type>(std::make_index_sequence<TYPES_COUNT>{});
+
+        const int N = static_cast<int>(*pType);
+        if(N >= 0 && N < TYPES_COUNT && conv[N] != nullptr){
+            return conv[N](valueData);
         }
     }else if(pSize){
         if(*pSize == sizeof(Type)){
@@ -114,40 +274,23 @@ bool valueTo(void* valueData, const std::variant<COValue::Type, size_t> typeOrSi
     const auto pSize = std::get_if<size_t>(&typeOrSize);
 
     if(pType){
-        switch(*pType){
-        default:
-            return false;
-        case I32:
-            *static_cast<int32_t*>(valueData) = static_cast<int32_t>(val);
-            break;
-        case I16:
-            *static_cast<int16_t*>(valueData) = static_cast<int16_t>(val);
-            break;
-        case I8:
-            *static_cast<int8_t*>(valueData) = static_cast<int8_t>(val);
-            break;
-        case U32:
-            *static_cast<uint32_t*>(valueData) = static_cast<uint32_t>(val);
-            break;
-        case U16:
-            *static_cast<uint16_t*>(valueData) = static_cast<uint16_t>(val);
-            break;
-        case U8:
-            *static_cast<uint8_t*>(valueData) = static_cast<uint8_t>(val);
-            break;
-        case IQ24:
-            *static_cast<int32_t*>(valueData) = static_cast<int32_t>(val * (1<<24));
-            break;
-        case IQ15:
-            *static_cast<int32_t*>(valueData) = static_cast<int32_t>(val * (1<<15));
-            break;
-        case IQ7:
-            *static_cast<int32_t*>(valueData) = static_cast<int32_t>(val * (1<<7));
-            break;
-        case STR:
-        case MEM:
-            return false;
+        if(isBitField(*pType)){
+            uint32_t mask = bitFieldMask(*pType) << bitFieldOffset(*pType);
+            uint32_t word = bitFieldWord(valueData, *pType);
+
+            word = (word & ~mask) | ((static_cast<uint32_t>(val) << bitFieldOffset(*pType)) & mask);
+
+            memcpy(valueData, &word, std::min(bitFieldWordSize(*pType), sizeof(word)));
+
+            return true;
         }
+
+        static constexpr auto conv = makeValueToTable<Type>(std::make_index_sequence<TYPES_COUNT>{});
+
+        const int N = static_cast<int>(*pType);
+        if(N < 0 || N >= TYPES_COUNT || conv[N] == nullptr) return false;
+
+        conv[N](valueData, val);
     }else if(pSize){
         if(*pSize == sizeof(Type)){
             *static_cast<Type*>(valueData) = val;
@@ -159,7 +302,6 @@ bool valueTo(void* valueData, const std::variant<COValue::Type, size_t> typeOrSi
     }
     return true;
 }
-
 }
 
 
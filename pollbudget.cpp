@@ -0,0 +1,85 @@
+#include "pollbudget.h"
+#include "canbusstats.h"
+#include <algorithm>
+
+
+// SDO expedited transfer data size.
+#define SDO_EXPEDITED_SIZE 4
+// SDO segment data size.
+#define SDO_SEGMENT_SIZE 7
+// budget share always left for polling when the bus is overloaded by the other traffic.
+#define POLL_MIN_BUDGET_SHARE 0.1
+// max credit accumulated, update intervals.
+#define POLL_MAX_CREDIT_INTERVALS 2
+
+
+PollBudget::Cost PollBudget::sdoUploadCost(size_t dataSize, bool adapterAnswers)
+{
+    // request & response pairs: initiate + segments.
+    qreal pairs = 1;
+    if(dataSize > SDO_EXPEDITED_SIZE){
+        pairs += static_cast<qreal>((dataSize + SDO_SEGMENT_SIZE - 1) / SDO_SEGMENT_SIZE);
+    }
+
+    qreal frameChars = CanBusStats::frameSerialChars(false, 8);
+
+    Cost cost;
+    cost.busBits = pairs * 2 * CanBusStats::frameMaxBits(8);
+    cost.serialTxChars = pairs * frameChars;
+    cost.serialRxChars = pairs * (frameChars + (adapterAnswers ? CanBusStats::txAnswerSerialChars() : 0));
+
+    return cost;
+}
+
+PollBudget::PollBudget()
+{
+    reset();
+}
+
+PollBudget::~PollBudget()
+{
+}
+
+qreal PollBudget::credit() const
+{
+    return m_credit;
+}
+
+qreal PollBudget::maxCredit() const
+{
+    return m_maxCredit;
+}
+
+void PollBudget::reset()
+{
+    m_credit = 0.0;
+    m_maxCredit = 0.0;
+    m_spent = 0.0;
+}
+
+void PollBudget::refill(qreal target, qreal measuredLoad, qreal capacity, qreal intervalCapacity)
+{
+    if(capacity <= 0.0) return;
+
+    // the measured load includes the polling of the previous interval.
+    qreal otherLoad = std::max(0.0, measuredLoad - m_spent / capacity);
+    qreal share = std::max(target - otherLoad, target * POLL_MIN_BUDGET_SHARE);
+
+    // the cap does not depend on the elapsed time.
+    m_maxCredit = target * intervalCapacity * POLL_MAX_CREDIT_INTERVALS;
+    m_credit = std::min(m_credit + share * capacity, m_maxCredit);
+    m_spent = 0.0;
+}
+
+bool PollBudget::fits(qreal cost) const
+{
+    if(cost <= m_credit) return true;
+
+    return m_maxCredit > 0.0 && m_credit >= m_maxCredit;
+}
+
+void PollBudget::spend(qreal cost)
+{
+    m_credit -= cost;
+    m_spent += cost;
+}
@@ -0,0 +1,47 @@
+#ifndef POLLBUDGET_H
+#define POLLBUDGET_H
+
+#include <QtGlobal>
+#include <stddef.h>
+
+
+/*
+ * Polling budget of the CAN bus or of the serial link.
+ * Credit in bits (bus) or chars (serial) is refilled
+ * by the share of the capacity left by the other traffic
+ * and is limited by the credit of the update intervals.
+ */
+class PollBudget
+{
+public:
+
+    // SDO upload frames cost.
+    struct Cost {
+        qreal busBits;
+        qreal serialTxChars;
+        qreal serialRxChars;
+    };
+
+    static Cost sdoUploadCost(size_t dataSize, bool adapterAnswers);
+
+    PollBudget();
+    ~PollBudget();
+
+    qreal credit() const;
+    qreal maxCredit() const;
+
+    void reset();
+    // capacity - of the elapsed time, intervalCapacity - of the update interval.
+    void refill(qreal target, qreal measuredLoad, qreal capacity, qreal intervalCapacity);
+    // the cost larger than the max credit fits the full credit.
+    bool fits(qreal cost) const;
+    // the credit may become negative.
+    void spend(qreal cost);
+
+private:
+    qreal m_credit;
+    qreal m_maxCredit;
+    qreal m_spent;
+};
+
+#endif // POLLBUDGET_H
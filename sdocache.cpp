@@ -0,0 +1,196 @@
+#include "sdocache.h"
+#include <algorithm>
+#include <string.h>
+
+
+
+SDOCache::SDOCache()
+{
+    m_enabled = false;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+SDOCache::~SDOCache()
+{
+}
+
+bool SDOCache::enabled() const
+{
+    return m_enabled;
+}
+
+void SDOCache::setEnabled(bool newEnabled)
+{
+    if(!newEnabled) m_items.clear();
+
+    m_enabled = newEnabled;
+}
+
+SDOCache::Policy SDOCache::policy(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex, int* ttl) const
+{
+    const PolicyItem* item = findPolicy(nodeId, index, subIndex);
+
+    if(item == nullptr){
+        if(ttl) *ttl = 0;
+        return NEVER;
+    }
+
+    if(ttl) *ttl = item->ttl;
+
+    return item->policy;
+}
+
+void SDOCache::setPolicy(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex, Policy newPolicy, int ttl)
+{
+    FullIndex fi = makeFullIndex(nodeId, index, subIndex);
+
+    m_policies.insert(fi, {newPolicy, std::max(ttl, 0)});
+
+    if(nodeId == ANY_NODE){
+        for(auto it = m_items.begin(); it != m_items.end();){
+            if((it.key() & 0x00ffffff) == fi){
+                it = m_items.erase(it);
+            }else{
+                ++ it;
+            }
+        }
+    }else{
+        m_items.remove(fi);
+    }
+}
+
+void SDOCache::resetPolicies()
+{
+    m_policies.clear();
+    m_items.clear();
+}
+
+void SDOCache::setDefaultPolicies()
+{
+    // Device type.
+    setPolicy(ANY_NODE, 0x1000, 0x00, FOREVER);
+    // Manufacturer device name, hardware version, software version.
+    setPolicy(ANY_NODE, 0x1008, 0x00, FOREVER);
+    setPolicy(ANY_NODE, 0x1009, 0x00, FOREVER);
+    setPolicy(ANY_NODE, 0x100A, 0x00, FOREVER);
+    // Identity.
+    for(CO::SubIndex si = 0x00; si <= 0x04; si ++){
+        setPolicy(ANY_NODE, 0x1018, si, FOREVER);
+    }
+}
+
+bool SDOCache::get(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex, void* data, size_t dataSize, size_t* readSize)
+{
+    if(!m_enabled) return false;
+    if(data == nullptr || dataSize == 0) return false;
+
+    FullIndex fi = makeFullIndex(nodeId, index, subIndex);
+
+    auto it = m_items.find(fi);
+
+    if(it == m_items.end()){
+        const PolicyItem* pol = findPolicy(nodeId, index, subIndex);
+        if(pol != nullptr && pol->policy != NEVER) m_misses ++;
+        return false;
+    }
+
+    if(!it->forever && cache_clock::now() >= it->expires){
+        m_items.erase(it);
+        m_misses ++;
+        return false;
+    }
+
+    size_t size = std::min(dataSize, static_cast<size_t>(it->data.size()));
+    memcpy(data, it->data.constData(), size);
+
+    if(readSize) *readSize = size;
+
+    m_hits ++;
+
+    return true;
+}
+
+bool SDOCache::put(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex, const void* data, size_t dataSize)
+{
+    if(!m_enabled) return false;
+    if(data == nullptr || dataSize == 0) return false;
+
+    const PolicyItem* pol = findPolicy(nodeId, index, subIndex);
+    if(pol == nullptr || pol->policy == NEVER) return false;
+
+    CacheItem item;
+    item.data = QByteArray(static_cast<const char*>(data), static_cast<int>(dataSize));
+    item.forever = pol->policy == FOREVER;
+    item.expires = cache_clock::now() + std::chrono::milliseconds(pol->ttl);
+
+    m_items.insert(makeFullIndex(nodeId, index, subIndex), item);
+
+    return true;
+}
+
+void SDOCache::invalidate(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex)
+{
+    m_items.remove(makeFullIndex(nodeId, index, subIndex));
+}
+
+void SDOCache::invalidateNode(CO::NodeId nodeId)
+{
+    if(nodeId == ANY_NODE){
+        m_items.clear();
+        return;
+    }
+
+    for(auto it = m_items.begin(); it != m_items.end();){
+        if((it.key() >> 24) == nodeId){
+            it = m_items.erase(it);
+        }else{
+            ++ it;
+        }
+    }
+}
+
+void SDOCache::clear()
+{
+    m_items.clear();
+}
+
+size_t SDOCache::hits() const
+{
+    return m_hits;
+}
+
+size_t SDOCache::misses() const
+{
+    return m_misses;
+}
+
+void SDOCache::resetCounters()
+{
+    m_hits = 0;
+    m_misses = 0;
+}
+
+SDOCache::FullIndex SDOCache::makeFullIndex(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const
+{
+    FullIndex fi = 0;
+
+    fi |= (quint32)nodeId << 24;
+    fi |= (quint32)index << 8;
+    fi |= (quint32)subIndex;
+
+    return fi;
+}
+
+const SDOCache::PolicyItem* SDOCache::findPolicy(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const
+{
+    if(m_policies.isEmpty()) return nullptr;
+
+    auto it = m_policies.find(makeFullIndex(nodeId, index, subIndex));
+    if(it != m_policies.end()) return &it.value();
+
+    it = m_policies.find(makeFullIndex(ANY_NODE, index, subIndex));
+    if(it != m_policies.end()) return &it.value();
+
+    return nullptr;
+}
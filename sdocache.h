@@ -0,0 +1,82 @@
+#ifndef SDOCACHE_H
+#define SDOCACHE_H
+
+#include <QHash>
+#include <QByteArray>
+#include <stddef.h>
+#include <chrono>
+#include "cotypes.h"
+
+
+/**
+ * @brief Кэш ответов SDO для объектов, не меняющихся во время работы.
+ */
+class SDOCache
+{
+public:
+
+    enum Policy {
+        NEVER = 0,
+        FOREVER = 1,
+        TTL = 2
+    };
+
+    // nodeId == 0 -> any node.
+    static const CO::NodeId ANY_NODE = 0;
+
+    SDOCache();
+    ~SDOCache();
+
+    bool enabled() const;
+    void setEnabled(bool newEnabled);
+
+    Policy policy(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex, int* ttl = nullptr) const;
+    // ttl in ms, used only by the TTL policy.
+    void setPolicy(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex, Policy newPolicy, int ttl = 0);
+    void resetPolicies();
+    // 0x1000, 0x1008 - 0x100A, 0x1018.
+    void setDefaultPolicies();
+
+    // return true on hit and copy cached data.
+    bool get(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex,
+             void* data, size_t dataSize, size_t* readSize = nullptr);
+    // store data if policy allows it.
+    bool put(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex,
+             const void* data, size_t dataSize);
+
+    void invalidate(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex);
+    void invalidateNode(CO::NodeId nodeId);
+    void clear();
+
+    size_t hits() const;
+    size_t misses() const;
+    void resetCounters();
+
+private:
+    typedef quint32 FullIndex;
+
+    using cache_clock = std::chrono::steady_clock;
+
+    struct PolicyItem {
+        Policy policy;
+        int ttl;
+    };
+
+    struct CacheItem {
+        QByteArray data;
+        cache_clock::time_point expires;
+        bool forever;
+    };
+
+    QHash<FullIndex, PolicyItem> m_policies;
+    QHash<FullIndex, CacheItem> m_items;
+
+    bool m_enabled;
+    size_t m_hits;
+    size_t m_misses;
+
+    FullIndex makeFullIndex(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const;
+    const PolicyItem* findPolicy(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const;
+};
+
+#endif // SDOCACHE_H
@@ -0,0 +1,135 @@
+#include "sdoobserver.h"
+
+
+// command specifier.
+#define SDO_CS_MASK 0xe0
+#define SDO_CCS_DOWNLOAD_INIT 0x20
+#define SDO_SCS_UPLOAD_INIT 0x40
+#define SDO_SCS_DOWNLOAD_INIT 0x60
+#define SDO_CS_ABORT 0x80
+// expedited & size indicated bits.
+#define SDO_E_BIT 0x02
+#define SDO_S_BIT 0x01
+#define SDO_N_SHIFT 2
+#define SDO_N_MASK 0x03
+
+
+
+SDOObserver::SDOObserver()
+{
+}
+
+SDOObserver::~SDOObserver()
+{
+}
+
+void SDOObserver::reset()
+{
+    m_downloads.clear();
+    m_values.clear();
+}
+
+bool SDOObserver::put(quint16 cobid, quint8 dlc, const quint8* data)
+{
+    if(data == nullptr || dlc != 8) return false;
+
+    CO::NodeId nodeId = cobid & 0x7f;
+    if(nodeId == 0) return false;
+
+    switch(cobid & 0x780){
+    case COBID_REQUEST:
+        putRequest(nodeId, data);
+        return false;
+    case COBID_RESPONSE:
+        return putResponse(nodeId, data);
+    default:
+        break;
+    }
+
+    return false;
+}
+
+bool SDOObserver::hasValues() const
+{
+    return !m_values.isEmpty();
+}
+
+QVector<SDOObserver::Value> SDOObserver::takeValues()
+{
+    QVector<Value> values;
+    values.swap(m_values);
+
+    return values;
+}
+
+static int expeditedSize(quint8 cs)
+{
+    if(cs & SDO_S_BIT) return 4 - ((cs >> SDO_N_SHIFT) & SDO_N_MASK);
+
+    return 4;
+}
+
+void SDOObserver::putRequest(CO::NodeId nodeId, const quint8* data)
+{
+    quint8 cs = data[0];
+
+    // segmented downloads are not decoded,
+    // any other request ends the previous transfer.
+    if((cs & SDO_CS_MASK) != SDO_CCS_DOWNLOAD_INIT || (cs & SDO_E_BIT) == 0){
+        m_downloads.remove(nodeId);
+        return;
+    }
+
+    // the value is valid on the confirmation.
+    Download dl;
+    dl.index = static_cast<CO::Index>(data[1]) | (static_cast<CO::Index>(data[2]) << 8);
+    dl.subIndex = data[3];
+    dl.data = QByteArray(reinterpret_cast<const char*>(&data[4]), expeditedSize(cs));
+
+    m_downloads.insert(nodeId, dl);
+}
+
+bool SDOObserver::putResponse(CO::NodeId nodeId, const quint8* data)
+{
+    quint8 cs = data[0];
+
+    Value val;
+    val.nodeId = nodeId;
+    val.index = static_cast<CO::Index>(data[1]) | (static_cast<CO::Index>(data[2]) << 8);
+    val.subIndex = data[3];
+
+    switch(cs & SDO_CS_MASK){
+    // upload response with the data.
+    case SDO_SCS_UPLOAD_INIT:
+        m_downloads.remove(nodeId);
+
+        // segmented uploads are not decoded.
+        if((cs & SDO_E_BIT) == 0) return false;
+
+        val.data = QByteArray(reinterpret_cast<const char*>(&data[4]), expeditedSize(cs));
+        m_values.append(val);
+        return true;
+    // download confirmation.
+    case SDO_SCS_DOWNLOAD_INIT:{
+        auto it = m_downloads.find(nodeId);
+        if(it == m_downloads.end()) return false;
+
+        bool matched = it->index == val.index && it->subIndex == val.subIndex;
+        if(matched){
+            val.data = it->data;
+            m_values.append(val);
+        }
+        m_downloads.erase(it);
+
+        return matched;
+        }
+    // abort.
+    case SDO_CS_ABORT:
+        m_downloads.remove(nodeId);
+        break;
+    default:
+        break;
+    }
+
+    return false;
+}
@@ -0,0 +1,58 @@
+#ifndef SDOOBSERVER_H
+#define SDOOBSERVER_H
+
+#include <QtGlobal>
+#include <QHash>
+#include <QVector>
+#include <QByteArray>
+#include "cotypes.h"
+
+
+/*
+ * Decoder of the expedited SDO transfers of other masters.
+ * Download requests (client -> server, 0x600 + node id) are kept per node
+ * until the server response (server -> client, 0x580 + node id):
+ * the value is observed on the download confirmation
+ * or with the data of the upload response.
+ */
+class SDOObserver
+{
+public:
+
+    struct Value {
+        CO::NodeId nodeId;
+        CO::Index index;
+        CO::SubIndex subIndex;
+        QByteArray data;
+    };
+
+    static const quint16 COBID_REQUEST = 0x600;
+    static const quint16 COBID_RESPONSE = 0x580;
+
+    SDOObserver();
+    ~SDOObserver();
+
+    void reset();
+
+    // SDO frame of the node, true if the value is observed.
+    bool put(quint16 cobid, quint8 dlc, const quint8* data);
+
+    bool hasValues() const;
+    // observed values in the order of the reception.
+    QVector<Value> takeValues();
+
+private:
+    struct Download {
+        CO::Index index;
+        CO::SubIndex subIndex;
+        QByteArray data;
+    };
+
+    QHash<CO::NodeId, Download> m_downloads;
+    QVector<Value> m_values;
+
+    void putRequest(CO::NodeId nodeId, const quint8* data);
+    bool putResponse(CO::NodeId nodeId, const quint8* data);
+};
+
+#endif // SDOOBSERVER_H
@@ -205,6 +205,17 @@ bool SDOValue::running() const
     return m_sdoc->running();
 }
 
+bool SDOValue::updateData(const void* newData, size_t newDataSize)
+{
+    if(newData == nullptr || newDataSize == 0) return false;
+    if(m_sdoc->data() == nullptr || m_sdoc->dataSize() == 0) return false;
+
+    memcpy(m_sdoc->data(), newData, std::min(newDataSize, m_sdoc->dataSize()));
+
+    emit readed();
+
+    return true;
+}
 
 bool SDOValue::read()
 {
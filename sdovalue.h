@@ -54,6 +54,9 @@ public:
 
     bool running() const;
 
+    // set data received not by the SDO (PDO) and emit readed().
+    bool updateData(const void* newData, size_t newDataSize);
+
     template <typename T>
     T value(const T& defVal = T(), bool* isOk = nullptr) const;
 
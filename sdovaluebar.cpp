@@ -1,5 +1,6 @@
 #include "sdovaluebar.h"
 #include "sdovalue.h"
+#include "covaluedemand.h"
 #include <QPaintEvent>
 #include <QwtAbstractScaleDraw>
 #include <QPainter>
@@ -16,9 +17,14 @@
 SDOValueBar::SDOValueBar(CoValuesHolder* newValsHolder, QWidget* parent)
     :QwtThermo(parent)
 {
-    m_valsHolder = newValsHolder;
+    m_valsHolder = nullptr;
+    m_demand = new CoValueDemand(this);
+    setValuesHolder(newValsHolder);
     m_sdoValue = nullptr;
+    m_pollPeriod = 0;
     m_sdoValueType = COValue::Type();
+    m_deadband = 0.0;
+    m_deadbandMode = CoValuesHolder::DEADBAND_NONE;
     m_name = QString("");
 
     updateContentMargins();
@@ -30,6 +36,8 @@ SDOValueBar::~SDOValueBar()
         resetSDOValue();
         delete m_sdoValue;
     }
+
+    delete m_demand;
 }
 
 QString SDOValueBar::name() const
@@ -49,7 +57,14 @@ CoValuesHolder* SDOValueBar::valuesHolder() const
 
 void SDOValueBar::setValuesHolder(CoValuesHolder* newValuesHolder)
 {
+    if(m_valsHolder){
+        disconnect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueBar::sdovaluesUpdated);
+    }
     m_valsHolder = newValuesHolder;
+    m_demand->setValuesHolder(newValuesHolder);
+    if(m_valsHolder){
+        connect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueBar::sdovaluesUpdated);
+    }
 }
 
 QColor SDOValueBar::barBackColor() const
@@ -199,6 +214,48 @@ void SDOValueBar::setRangeMax(qreal newRangeMax)
     setUpperBound(newRangeMax);
 }
 
+qreal SDOValueBar::deadband() const
+{
+    return m_deadband;
+}
+
+CoValuesHolder::DeadbandMode SDOValueBar::deadbandMode() const
+{
+    return m_deadbandMode;
+}
+
+void SDOValueBar::setDeadband(qreal newDeadband, CoValuesHolder::DeadbandMode newMode)
+{
+    if(m_sdoValue != nullptr && m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+        m_valsHolder->releaseValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+    }
+
+    m_deadband = qMax(newDeadband, 0.0);
+    m_deadbandMode = newMode;
+
+    if(m_sdoValue != nullptr && m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+        m_valsHolder->addValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+    }
+}
+
+int SDOValueBar::pollPeriod() const
+{
+    return m_pollPeriod;
+}
+
+void SDOValueBar::setPollPeriod(int newPollPeriod)
+{
+    if(m_sdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->releaseValuePeriod(m_sdoValue, m_pollPeriod);
+    }
+
+    m_pollPeriod = qMax(newPollPeriod, 0);
+
+    if(m_sdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->addValuePeriod(m_sdoValue, m_pollPeriod);
+    }
+}
+
 bool SDOValueBar::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType, qreal newMin, qreal newMax)
 {
     if(m_valsHolder == nullptr) return false;
@@ -214,9 +271,14 @@ bool SDOValueBar::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubI
 
     m_sdoValueType = newType;
 
+    if(m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+        m_valsHolder->addValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+    }
+
     setScale(newMin, newMax);
 
-    connect(m_sdoValue, &SDOValue::readed, this, &SDOValueBar::sdovalueReaded);
+    m_demand->addValue(m_sdoValue);
+    if(m_pollPeriod > 0) m_valsHolder->addValuePeriod(m_sdoValue, m_pollPeriod);
 
     return true;
 }
@@ -241,17 +303,23 @@ void SDOValueBar::resetSDOValue()
     if(m_valsHolder == nullptr) return;
 
     if(m_sdoValue != nullptr){
-        disconnect(m_sdoValue, &SDOValue::readed, this, &SDOValueBar::sdovalueReaded);
+        m_demand->removeValue(m_sdoValue);
+
+        if(m_valsHolder != nullptr && m_pollPeriod > 0) m_valsHolder->releaseValuePeriod(m_sdoValue, m_pollPeriod);
+
+        if(m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+            m_valsHolder->releaseValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+        }
 
         m_valsHolder->delSdoValue(m_sdoValue);
         m_sdoValue = nullptr;
     }
 }
 
-void SDOValueBar::sdovalueReaded()
+void SDOValueBar::sdovaluesUpdated()
 {
-    auto sdoval = qobject_cast<CoValuesHolder::HoldedSDOValuePtr>(sender());
-    if(sdoval == nullptr) return;
+    auto sdoval = m_sdoValue;
+    if(sdoval == nullptr || !m_valsHolder->valueChanged(sdoval)) return;
 
     setValue(COValue::valueFrom<qreal>(sdoval->data(), m_sdoValueType, 0.0));
 }
@@ -8,6 +8,7 @@
 
 
 class SDOValue;
+class CoValueDemand;
 
 
 class SDOValueBar : public QwtThermo
@@ -65,6 +66,15 @@ public:
     qreal rangeMax() const;
     void setRangeMax(qreal newRangeMax);
 
+    // deadband of the displayed value changes.
+    qreal deadband() const;
+    CoValuesHolder::DeadbandMode deadbandMode() const;
+    void setDeadband(qreal newDeadband, CoValuesHolder::DeadbandMode newMode = CoValuesHolder::DEADBAND_ABSOLUTE);
+
+    // poll period of the value, ms (0 - update interval).
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     bool setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType, qreal newMin = 0.0, qreal newMax = 1.0);
     CoValuesHolder::HoldedSDOValuePtr getSDOValue();
     CoValuesHolder::HoldedSDOValuePtr getSDOValue() const;
@@ -72,12 +82,16 @@ public:
     void resetSDOValue();
 
 private slots:
-    void sdovalueReaded();
+    void sdovaluesUpdated();
 
 protected:
     CoValuesHolder* m_valsHolder;
+    CoValueDemand* m_demand;
     CoValuesHolder::HoldedSDOValuePtr m_sdoValue;
+    int m_pollPeriod;
     COValue::Type m_sdoValueType;
+    qreal m_deadband;
+    CoValuesHolder::DeadbandMode m_deadbandMode;
     QString m_name;
 
     void updateContentMargins();
@@ -1,6 +1,7 @@
 #include "sdovaluebareditdlg.h"
 #include "ui_sdovaluebareditdlg.h"
 #include "covaluetypes.h"
+#include "bitfieldeditdlg.h"
 #include <QColorDialog>
 
 
@@ -18,6 +19,7 @@ SDOValueBarEditDlg::SDOValueBarEditDlg(QWidget *parent) :
     setTextColor(QColor(Qt::white));
 
     populateTypes();
+    populateDeadbandModes();
     populateOrientations();
     populateScalePositions();
 
@@ -79,7 +81,25 @@ COValue::Type SDOValueBarEditDlg::type() const
 
 void SDOValueBarEditDlg::setType(COValue::Type newType)
 {
-    ui->cbType->setCurrentIndex(ui->cbType->findData(static_cast<int>(newType)));
+    int index = ui->cbType->findData(static_cast<int>(newType));
+
+    // bit fields are not listed.
+    if(index == -1 && COValue::isBitField(newType)){
+        ui->cbType->addItem(COValue::typeName(newType), static_cast<int>(newType));
+        index = ui->cbType->count() - 1;
+    }
+
+    ui->cbType->setCurrentIndex(index);
+}
+
+int SDOValueBarEditDlg::pollPeriod() const
+{
+    return ui->sbPollPeriod->value();
+}
+
+void SDOValueBarEditDlg::setPollPeriod(int newPollPeriod)
+{
+    ui->sbPollPeriod->setValue(newPollPeriod);
 }
 
 int SDOValueBarEditDlg::posRow() const
@@ -211,6 +231,29 @@ void SDOValueBarEditDlg::setRangeMax(qreal newRangeMax)
     ui->sbRangeMax->blockSignals(false);
 }
 
+qreal SDOValueBarEditDlg::deadband() const
+{
+    return ui->sbDeadband->value();
+}
+
+void SDOValueBarEditDlg::setDeadband(qreal newDeadband)
+{
+    ui->sbDeadband->setValue(newDeadband);
+}
+
+CoValuesHolder::DeadbandMode SDOValueBarEditDlg::deadbandMode() const
+{
+    bool ok = false;
+    auto res = static_cast<CoValuesHolder::DeadbandMode>(ui->cbDeadbandMode->currentData().toInt(&ok));
+    if(ok) return res;
+    return CoValuesHolder::DEADBAND_NONE;
+}
+
+void SDOValueBarEditDlg::setDeadbandMode(CoValuesHolder::DeadbandMode newMode)
+{
+    ui->cbDeadbandMode->setCurrentIndex(ui->cbDeadbandMode->findData(static_cast<int>(newMode)));
+}
+
 int SDOValueBarEditDlg::barWidth() const
 {
     return ui->sbBarWidth->value();
@@ -287,6 +330,18 @@ void SDOValueBarEditDlg::setAlarmLevel(qreal newLevel)
     ui->sbAlarmLevel->setValue(newLevel);
 }
 
+void SDOValueBarEditDlg::on_tbBitFieldSel_clicked(bool checked)
+{
+    Q_UNUSED(checked);
+
+    BitFieldEditDlg dlg(this);
+    dlg.setType(type());
+
+    if(dlg.exec() == QDialog::Accepted){
+        setType(dlg.type());
+    }
+}
+
 void SDOValueBarEditDlg::on_tbBarBackColorSel_clicked(bool checked)
 {
     Q_UNUSED(checked)
@@ -370,3 +425,11 @@ void SDOValueBarEditDlg::populateScalePositions()
     ui->cbScalePos->addItem(tr("После"), static_cast<int>(QwtThermo::LeadingScale));
     ui->cbScalePos->addItem(tr("Перед"), static_cast<int>(QwtThermo::TrailingScale));
 }
+
+void SDOValueBarEditDlg::populateDeadbandModes()
+{
+    ui->cbDeadbandMode->clear();
+    ui->cbDeadbandMode->addItem(tr("Нет"), static_cast<int>(CoValuesHolder::DEADBAND_NONE));
+    ui->cbDeadbandMode->addItem(tr("Абсолютная"), static_cast<int>(CoValuesHolder::DEADBAND_ABSOLUTE));
+    ui->cbDeadbandMode->addItem(tr("%"), static_cast<int>(CoValuesHolder::DEADBAND_PERCENT));
+}
@@ -6,6 +6,7 @@
 #include <QwtThermo>
 #include "cotypes.h"
 #include "covaluetypes.h"
+#include "covaluesholder.h"
 
 
 namespace Ui {
@@ -35,6 +36,10 @@ public:
     COValue::Type type() const;
     void setType(COValue::Type newType);
 
+    // ms, 0 - update interval.
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     int posRow() const;
     void setPosRow(int newPosRow);
 
@@ -68,6 +73,12 @@ public:
     qreal rangeMax() const;
     void setRangeMax(qreal newRangeMax);
 
+    qreal deadband() const;
+    void setDeadband(qreal newDeadband);
+
+    CoValuesHolder::DeadbandMode deadbandMode() const;
+    void setDeadbandMode(CoValuesHolder::DeadbandMode newMode);
+
     int barWidth() const;
     void setBarWidth(int newBarWidth);
 
@@ -90,6 +101,7 @@ public:
     void setAlarmLevel(qreal newLevel);
 
 private slots:
+    void on_tbBitFieldSel_clicked(bool checked = false);
     void on_tbBarBackColorSel_clicked(bool checked = false);
     void on_tbBarColorSel_clicked(bool checked = false);
     void on_tbBarAlarmColorSel_clicked(bool checked = false);
@@ -103,6 +115,7 @@ private:
 
     void peekColor(QWidget* colHolder);
     void populateTypes();
+    void populateDeadbandModes();
     void populateOrientations();
     void populateScalePositions();
 };
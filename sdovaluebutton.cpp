@@ -1,5 +1,7 @@
 #include "sdovaluebutton.h"
 #include "sdovalue.h"
+#include "covaluedemand.h"
+#include "slcanopennode.h"
 #include <QPaintEvent>
 #include <QwtAbstractScaleDraw>
 #include <QPainter>
@@ -19,8 +21,11 @@
 SDOValueButton::SDOValueButton(CoValuesHolder* newValsHolder, QWidget* parent)
     :QAbstractButton(parent)
 {
-    m_valsHolder = newValsHolder;
+    m_valsHolder = nullptr;
+    m_demand = new CoValueDemand(this);
+    setValuesHolder(newValsHolder);
     m_rdSdoValue = nullptr;
+    m_pollPeriod = 0;
     m_wrSdoValue = nullptr;
     m_sdoValueType = COValue::Type();
     m_updateMask = false;
@@ -67,6 +72,8 @@ SDOValueButton::~SDOValueButton()
     resetSDOValue();
 
     deleteImages();
+
+    delete m_demand;
 }
 
 CoValuesHolder* SDOValueButton::valuesHolder() const
@@ -76,7 +83,14 @@ CoValuesHolder* SDOValueButton::valuesHolder() const
 
 void SDOValueButton::setValuesHolder(CoValuesHolder* newValuesHolder)
 {
+    if(m_valsHolder){
+        disconnect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueButton::sdovaluesUpdated);
+    }
     m_valsHolder = newValuesHolder;
+    m_demand->setValuesHolder(newValuesHolder);
+    if(m_valsHolder){
+        connect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueButton::sdovaluesUpdated);
+    }
 }
 
 QColor SDOValueButton::buttonColor() const
@@ -251,6 +265,24 @@ void SDOValueButton::setActivateValue(uint32_t newActivateValue)
     m_activateValue = newActivateValue;
 }
 
+int SDOValueButton::pollPeriod() const
+{
+    return m_pollPeriod;
+}
+
+void SDOValueButton::setPollPeriod(int newPollPeriod)
+{
+    if(m_rdSdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->releaseValuePeriod(m_rdSdoValue, m_pollPeriod);
+    }
+
+    m_pollPeriod = qMax(newPollPeriod, 0);
+
+    if(m_rdSdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->addValuePeriod(m_rdSdoValue, m_pollPeriod);
+    }
+}
+
 bool SDOValueButton::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType)
 {
     if(m_valsHolder == nullptr) return false;
@@ -279,7 +311,8 @@ bool SDOValueButton::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::S
         return false;
     }
 
-    connect(m_rdSdoValue, &SDOValue::readed, this, &SDOValueButton::sdovalueReaded);
+    m_demand->addValue(m_rdSdoValue);
+    if(m_pollPeriod > 0) m_valsHolder->addValuePeriod(m_rdSdoValue, m_pollPeriod);
 
     return true;
 }
@@ -302,7 +335,9 @@ COValue::Type SDOValueButton::SDOValueType() const
 void SDOValueButton::resetSDOValue()
 {
     if(m_rdSdoValue != nullptr){
-        disconnect(m_rdSdoValue, &SDOValue::readed, this, &SDOValueButton::sdovalueReaded);
+        m_demand->removeValue(m_rdSdoValue);
+
+        if(m_valsHolder != nullptr && m_pollPeriod > 0) m_valsHolder->releaseValuePeriod(m_rdSdoValue, m_pollPeriod);
 
         if(m_valsHolder != nullptr) m_valsHolder->delSdoValue(m_rdSdoValue);
         m_rdSdoValue = nullptr;
@@ -341,13 +376,13 @@ void SDOValueButton::applyAppearance()
     update();
 }
 
-void SDOValueButton::sdovalueReaded()
+void SDOValueButton::sdovaluesUpdated()
 {
     if(m_updateMask) return;
     if(!indicatorEnabled()) return;
 
-    auto sdoval = qobject_cast<CoValuesHolder::HoldedSDOValuePtr>(sender());
-    if(sdoval == nullptr) return;
+    auto sdoval = m_rdSdoValue;
+    if(sdoval == nullptr || !m_valsHolder->valueUpdated(sdoval)) return;
 
     auto value = COValue::valueFrom<uint32_t>(sdoval->data(), m_sdoValueType, 0);
 
@@ -394,13 +429,16 @@ void SDOValueButton::setupRdSdoValue()
                                                          COValue::typeSize(m_sdoValueType));
 
                 if(m_rdSdoValue){
-                    connect(m_rdSdoValue, &SDOValue::readed, this, &SDOValueButton::sdovalueReaded);
+                    m_demand->addValue(m_rdSdoValue);
+                    if(m_pollPeriod > 0) m_valsHolder->addValuePeriod(m_rdSdoValue, m_pollPeriod);
                 }
             }
         }
     }else{
         if(m_rdSdoValue != nullptr){
-            disconnect(m_rdSdoValue, &SDOValue::readed, this, &SDOValueButton::sdovalueReaded);
+            m_demand->removeValue(m_rdSdoValue);
+
+            if(m_valsHolder != nullptr && m_pollPeriod > 0) m_valsHolder->releaseValuePeriod(m_rdSdoValue, m_pollPeriod);
 
             if(m_valsHolder != nullptr) m_valsHolder->delSdoValue(m_rdSdoValue);
             m_rdSdoValue = nullptr;
@@ -415,7 +453,26 @@ void SDOValueButton::onClick()
     if(m_valsHolder == nullptr) return;
     if(m_wrSdoValue == nullptr) return;
 
-    if(!COValue::valueTo(m_wrSdoValue->data(), m_sdoValueType, m_activateValue) || !m_wrSdoValue->write()){
+    // other bits of the bit field are kept as read.
+    if(COValue::isBitField(m_sdoValueType) && m_rdSdoValue != nullptr && m_rdSdoValue->data() != nullptr){
+        memcpy(m_wrSdoValue->data(), m_rdSdoValue->data(), m_wrSdoValue->dataSize());
+    }
+
+    if(!COValue::valueTo(m_wrSdoValue->data(), m_sdoValueType, m_activateValue)){
+#if defined(SDOVALUEBUTTON_MESSAGE_ON_WRITE_ERROR) && SDOVALUEBUTTON_MESSAGE_ON_WRITE_ERROR == 1
+        QMessageBox::critical(this, tr("Ошибка!"), tr("Невозможно начать запись значения!"));
+#endif
+        return;
+    }
+
+    // TPDO mapped command.
+    SLCanOpenNode* slcon = m_valsHolder->getSLCanOpenNode();
+    if(slcon != nullptr && slcon->writeTpdo(m_wrSdoValue->nodeId(), m_wrSdoValue->index(), m_wrSdoValue->subIndex(),
+                                            m_wrSdoValue->data(), m_wrSdoValue->dataSize())){
+        return;
+    }
+
+    if(!m_wrSdoValue->write()){
 #if defined(SDOVALUEBUTTON_MESSAGE_ON_WRITE_ERROR) && SDOVALUEBUTTON_MESSAGE_ON_WRITE_ERROR == 1
         QMessageBox::critical(this, tr("Ошибка!"), tr("Невозможно начать запись значения!"));
 #endif
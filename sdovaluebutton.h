@@ -8,6 +8,7 @@
 
 
 class SDOValue;
+class CoValueDemand;
 class QImage;
 
 
@@ -74,6 +75,10 @@ public:
     uint32_t activateValue() const;
     void setActivateValue(uint32_t newActivateValue);
 
+    // poll period of the value, ms (0 - update interval).
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     bool setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType);
     CoValuesHolder::HoldedSDOValuePtr getSDOValue();
     CoValuesHolder::HoldedSDOValuePtr getSDOValue() const;
@@ -88,11 +93,13 @@ public:
     void applyAppearance();
 
 private slots:
-    void sdovalueReaded();
+    void sdovaluesUpdated();
 
 protected:
     CoValuesHolder* m_valsHolder;
+    CoValueDemand* m_demand;
     CoValuesHolder::HoldedSDOValuePtr m_rdSdoValue;
+    int m_pollPeriod;
     SDOValue* m_wrSdoValue;
     COValue::Type m_sdoValueType;
     bool m_updateMask;
@@ -1,6 +1,7 @@
 #include "sdovaluebuttoneditdlg.h"
 #include "ui_sdovaluebuttoneditdlg.h"
 #include "covaluetypes.h"
+#include "bitfieldeditdlg.h"
 #include <stdint.h>
 #include <QColorDialog>
 #include <QDebug>
@@ -79,7 +80,25 @@ COValue::Type SDOValueButtonEditDlg::type() const
 
 void SDOValueButtonEditDlg::setType(COValue::Type newType)
 {
-    ui->cbType->setCurrentIndex(ui->cbType->findData(static_cast<int>(newType)));
+    int index = ui->cbType->findData(static_cast<int>(newType));
+
+    // bit fields are not listed.
+    if(index == -1 && COValue::isBitField(newType)){
+        ui->cbType->addItem(COValue::typeName(newType), static_cast<int>(newType));
+        index = ui->cbType->count() - 1;
+    }
+
+    ui->cbType->setCurrentIndex(index);
+}
+
+int SDOValueButtonEditDlg::pollPeriod() const
+{
+    return ui->sbPollPeriod->value();
+}
+
+void SDOValueButtonEditDlg::setPollPeriod(int newPollPeriod)
+{
+    ui->sbPollPeriod->setValue(newPollPeriod);
 }
 
 int SDOValueButtonEditDlg::posRow() const
@@ -317,6 +336,18 @@ void SDOValueButtonEditDlg::setActivateValue(uint32_t newActivateValue)
     ui->leActivateValue->setText(QStringLiteral("0x%1").arg(newActivateValue, 0, 16));
 }
 
+void SDOValueButtonEditDlg::on_tbBitFieldSel_clicked(bool checked)
+{
+    Q_UNUSED(checked);
+
+    BitFieldEditDlg dlg(this);
+    dlg.setType(type());
+
+    if(dlg.exec() == QDialog::Accepted){
+        setType(dlg.type());
+    }
+}
+
 void SDOValueButtonEditDlg::on_tbButtonColorSel_clicked(bool checked)
 {
     Q_UNUSED(checked)
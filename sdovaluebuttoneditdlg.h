@@ -35,6 +35,10 @@ public:
     COValue::Type type() const;
     void setType(COValue::Type newType);
 
+    // ms, 0 - update interval.
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     int posRow() const;
     void setPosRow(int newPosRow);
 
@@ -90,6 +94,7 @@ public:
     void setActivateValue(uint32_t newActivateValue);
 
 private slots:
+    void on_tbBitFieldSel_clicked(bool checked = false);
     void on_tbButtonColorSel_clicked(bool checked = false);
     void on_tbBorderColorSel_clicked(bool checked = false);
     void on_tbIndicatorColorSel_clicked(bool checked = false);
@@ -1,5 +1,6 @@
 #include "sdovaluedial.h"
 #include "sdovalue.h"
+#include "covaluedemand.h"
 #include <QwtDialSimpleNeedle>
 #include <QwtRoundScaleDraw>
 #include <QwtAbstractScaleDraw>
@@ -13,9 +14,14 @@
 SDOValueDial::SDOValueDial(CoValuesHolder* newValsHolder, QWidget* parent)
     :QwtDial(parent)
 {
-    m_valsHolder = newValsHolder;
+    m_valsHolder = nullptr;
+    m_demand = new CoValueDemand(this);
+    setValuesHolder(newValsHolder);
     m_sdoValue = nullptr;
+    m_pollPeriod = 0;
     m_sdoValueType = COValue::Type();
+    m_deadband = 0.0;
+    m_deadbandMode = CoValuesHolder::DEADBAND_NONE;
 
     m_name = QString();
     m_precision = 0;
@@ -46,6 +52,8 @@ SDOValueDial::~SDOValueDial()
         resetSDOValue();
         delete m_sdoValue;
     }
+
+    delete m_demand;
 }
 
 QString SDOValueDial::name() const
@@ -65,7 +73,14 @@ CoValuesHolder* SDOValueDial::valuesHolder() const
 
 void SDOValueDial::setValuesHolder(CoValuesHolder* newValuesHolder)
 {
+    if(m_valsHolder){
+        disconnect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueDial::sdovaluesUpdated);
+    }
     m_valsHolder = newValuesHolder;
+    m_demand->setValuesHolder(newValuesHolder);
+    if(m_valsHolder){
+        connect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueDial::sdovaluesUpdated);
+    }
 }
 
 QColor SDOValueDial::outsideBackColor() const
@@ -188,6 +203,48 @@ void SDOValueDial::setRangeMax(qreal newRangeMax)
     setUpperBound(newRangeMax);
 }
 
+qreal SDOValueDial::deadband() const
+{
+    return m_deadband;
+}
+
+CoValuesHolder::DeadbandMode SDOValueDial::deadbandMode() const
+{
+    return m_deadbandMode;
+}
+
+void SDOValueDial::setDeadband(qreal newDeadband, CoValuesHolder::DeadbandMode newMode)
+{
+    if(m_sdoValue != nullptr && m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+        m_valsHolder->releaseValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+    }
+
+    m_deadband = qMax(newDeadband, 0.0);
+    m_deadbandMode = newMode;
+
+    if(m_sdoValue != nullptr && m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+        m_valsHolder->addValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+    }
+}
+
+int SDOValueDial::pollPeriod() const
+{
+    return m_pollPeriod;
+}
+
+void SDOValueDial::setPollPeriod(int newPollPeriod)
+{
+    if(m_sdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->releaseValuePeriod(m_sdoValue, m_pollPeriod);
+    }
+
+    m_pollPeriod = qMax(newPollPeriod, 0);
+
+    if(m_sdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->addValuePeriod(m_sdoValue, m_pollPeriod);
+    }
+}
+
 bool SDOValueDial::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType, qreal newMin, qreal newMax)
 {
     if(m_valsHolder == nullptr) return false;
@@ -201,9 +258,14 @@ bool SDOValueDial::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::Sub
 
     m_sdoValueType = newType;
 
+    if(m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+        m_valsHolder->addValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+    }
+
     setScale(newMin, newMax);
 
-    connect(m_sdoValue, &SDOValue::readed, this, &SDOValueDial::sdovalueReaded);
+    m_demand->addValue(m_sdoValue);
+    if(m_pollPeriod > 0) m_valsHolder->addValuePeriod(m_sdoValue, m_pollPeriod);
 
     return true;
 }
@@ -228,16 +290,22 @@ void SDOValueDial::resetSDOValue()
     if(m_valsHolder == nullptr) return;
     if(m_sdoValue == nullptr) return;
 
-    disconnect(m_sdoValue, &SDOValue::readed, this, &SDOValueDial::sdovalueReaded);
+    m_demand->removeValue(m_sdoValue);
+
+    if(m_valsHolder != nullptr && m_pollPeriod > 0) m_valsHolder->releaseValuePeriod(m_sdoValue, m_pollPeriod);
+
+    if(m_deadbandMode != CoValuesHolder::DEADBAND_NONE){
+        m_valsHolder->releaseValueDeadband(m_sdoValue, m_sdoValueType, m_deadband, m_deadbandMode);
+    }
 
     m_valsHolder->delSdoValue(m_sdoValue);
     m_sdoValue = nullptr;
 }
 
-void SDOValueDial::sdovalueReaded()
+void SDOValueDial::sdovaluesUpdated()
 {
-    auto sdoval = qobject_cast<CoValuesHolder::HoldedSDOValuePtr>(sender());
-    if(sdoval == nullptr) return;
+    auto sdoval = m_sdoValue;
+    if(sdoval == nullptr || !m_valsHolder->valueChanged(sdoval)) return;
 
     setValue(COValue::valueFrom<qreal>(sdoval->data(), m_sdoValueType, 0.0));
 }
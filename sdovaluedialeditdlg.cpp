@@ -1,6 +1,7 @@
 #include "sdovaluedialeditdlg.h"
 #include "ui_sdovaluedialeditdlg.h"
 #include "covaluetypes.h"
+#include "bitfieldeditdlg.h"
 #include <QColorDialog>
 
 
@@ -18,6 +19,7 @@ SDOValueDialEditDlg::SDOValueDialEditDlg(QWidget *parent) :
     setNeedleColor(Qt::darkRed);
 
     populateTypes();
+    populateDeadbandModes();
 }
 
 SDOValueDialEditDlg::~SDOValueDialEditDlg()
@@ -75,7 +77,25 @@ COValue::Type SDOValueDialEditDlg::type() const
 
 void SDOValueDialEditDlg::setType(COValue::Type newType)
 {
-    ui->cbType->setCurrentIndex(ui->cbType->findData(static_cast<int>(newType)));
+    int index = ui->cbType->findData(static_cast<int>(newType));
+
+    // bit fields are not listed.
+    if(index == -1 && COValue::isBitField(newType)){
+        ui->cbType->addItem(COValue::typeName(newType), static_cast<int>(newType));
+        index = ui->cbType->count() - 1;
+    }
+
+    ui->cbType->setCurrentIndex(index);
+}
+
+int SDOValueDialEditDlg::pollPeriod() const
+{
+    return ui->sbPollPeriod->value();
+}
+
+void SDOValueDialEditDlg::setPollPeriod(int newPollPeriod)
+{
+    ui->sbPollPeriod->setValue(newPollPeriod);
 }
 
 int SDOValueDialEditDlg::posRow() const
@@ -203,6 +223,29 @@ void SDOValueDialEditDlg::setRangeMax(qreal newRangeMax)
     ui->sbRangeMax->setValue(newRangeMax);
 }
 
+qreal SDOValueDialEditDlg::deadband() const
+{
+    return ui->sbDeadband->value();
+}
+
+void SDOValueDialEditDlg::setDeadband(qreal newDeadband)
+{
+    ui->sbDeadband->setValue(newDeadband);
+}
+
+CoValuesHolder::DeadbandMode SDOValueDialEditDlg::deadbandMode() const
+{
+    bool ok = false;
+    auto res = static_cast<CoValuesHolder::DeadbandMode>(ui->cbDeadbandMode->currentData().toInt(&ok));
+    if(ok) return res;
+    return CoValuesHolder::DEADBAND_NONE;
+}
+
+void SDOValueDialEditDlg::setDeadbandMode(CoValuesHolder::DeadbandMode newMode)
+{
+    ui->cbDeadbandMode->setCurrentIndex(ui->cbDeadbandMode->findData(static_cast<int>(newMode)));
+}
+
 qreal SDOValueDialEditDlg::penWidth() const
 {
     return ui->sbPenWidth->value();
@@ -223,6 +266,18 @@ void SDOValueDialEditDlg::setPrecision(uint newPrecision)
     ui->sbPrecision->setValue(static_cast<int>(newPrecision));
 }
 
+void SDOValueDialEditDlg::on_tbBitFieldSel_clicked(bool checked)
+{
+    Q_UNUSED(checked);
+
+    BitFieldEditDlg dlg(this);
+    dlg.setType(type());
+
+    if(dlg.exec() == QDialog::Accepted){
+        setType(dlg.type());
+    }
+}
+
 void SDOValueDialEditDlg::on_tbOutsideBackColorSel_clicked(bool checked)
 {
     Q_UNUSED(checked)
@@ -280,3 +335,11 @@ void SDOValueDialEditDlg::populateTypes()
         ui->cbType->addItem(type.first, static_cast<int>(type.second));
     }
 }
+
+void SDOValueDialEditDlg::populateDeadbandModes()
+{
+    ui->cbDeadbandMode->clear();
+    ui->cbDeadbandMode->addItem(tr("Нет"), static_cast<int>(CoValuesHolder::DEADBAND_NONE));
+    ui->cbDeadbandMode->addItem(tr("Абсолютная"), static_cast<int>(CoValuesHolder::DEADBAND_ABSOLUTE));
+    ui->cbDeadbandMode->addItem(tr("%"), static_cast<int>(CoValuesHolder::DEADBAND_PERCENT));
+}
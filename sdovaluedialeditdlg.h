@@ -5,6 +5,7 @@
 #include <QColor>
 #include "cotypes.h"
 #include "covaluetypes.h"
+#include "covaluesholder.h"
 
 
 namespace Ui {
@@ -34,6 +35,10 @@ public:
     COValue::Type type() const;
     void setType(COValue::Type newType);
 
+    // ms, 0 - update interval.
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     int posRow() const;
     void setPosRow(int newPosRow);
 
@@ -67,6 +72,12 @@ public:
     qreal rangeMax() const;
     void setRangeMax(qreal newRangeMax);
 
+    qreal deadband() const;
+    void setDeadband(qreal newDeadband);
+
+    CoValuesHolder::DeadbandMode deadbandMode() const;
+    void setDeadbandMode(CoValuesHolder::DeadbandMode newMode);
+
     qreal penWidth() const;
     void setPenWidth(qreal newPenWidth);
 
@@ -74,6 +85,7 @@ public:
     void setPrecision(uint newPrecision);
 
 private slots:
+    void on_tbBitFieldSel_clicked(bool checked = false);
     void on_tbOutsideBackColorSel_clicked(bool checked = false);
     void on_tbInsideBackColorSel_clicked(bool checked = false);
     void on_tbInsideScaleBackColorSel_clicked(bool checked = false);
@@ -85,6 +97,7 @@ private:
 
     void peekColor(QWidget* colHolder);
     void populateTypes();
+    void populateDeadbandModes();
 };
 
 #endif // SDOVALUEDIALEDITDLG_H
@@ -1,5 +1,6 @@
 #include "sdovalueindicator.h"
 #include "sdovalue.h"
+#include "covaluedemand.h"
 #include <QPaintEvent>
 #include <QwtAbstractScaleDraw>
 #include <QPainter>
@@ -19,8 +20,11 @@
 SDOValueIndicator::SDOValueIndicator(CoValuesHolder* newValsHolder, QWidget* parent)
     :QWidget(parent)
 {
-    m_valsHolder = newValsHolder;
+    m_valsHolder = nullptr;
+    m_demand = new CoValueDemand(this);
+    setValuesHolder(newValsHolder);
     m_sdoValue = nullptr;
+    m_pollPeriod = 0;
     m_sdoValueType = COValue::Type();
 
     createImages();
@@ -57,6 +61,8 @@ SDOValueIndicator::~SDOValueIndicator()
     resetSDOValue();
 
     deleteImages();
+
+    delete m_demand;
 }
 
 CoValuesHolder* SDOValueIndicator::valuesHolder() const
@@ -66,7 +72,14 @@ CoValuesHolder* SDOValueIndicator::valuesHolder() const
 
 void SDOValueIndicator::setValuesHolder(CoValuesHolder* newValuesHolder)
 {
+    if(m_valsHolder){
+        disconnect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueIndicator::sdovaluesUpdated);
+    }
     m_valsHolder = newValuesHolder;
+    m_demand->setValuesHolder(newValuesHolder);
+    if(m_valsHolder){
+        connect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueIndicator::sdovaluesUpdated);
+    }
 }
 
 QString SDOValueIndicator::text() const
@@ -216,6 +229,24 @@ void SDOValueIndicator::setIndicatorValue(uint32_t newIndicatorValue)
     m_indicatorValue = newIndicatorValue;
 }
 
+int SDOValueIndicator::pollPeriod() const
+{
+    return m_pollPeriod;
+}
+
+void SDOValueIndicator::setPollPeriod(int newPollPeriod)
+{
+    if(m_sdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->releaseValuePeriod(m_sdoValue, m_pollPeriod);
+    }
+
+    m_pollPeriod = qMax(newPollPeriod, 0);
+
+    if(m_sdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->addValuePeriod(m_sdoValue, m_pollPeriod);
+    }
+}
+
 bool SDOValueIndicator::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType)
 {
     if(m_valsHolder == nullptr) return false;
@@ -232,7 +263,8 @@ bool SDOValueIndicator::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO
         return false;
     }
 
-    connect(m_sdoValue, &SDOValue::readed, this, &SDOValueIndicator::sdovalueReaded);
+    m_demand->addValue(m_sdoValue);
+    if(m_pollPeriod > 0) m_valsHolder->addValuePeriod(m_sdoValue, m_pollPeriod);
 
     return true;
 }
@@ -255,7 +287,9 @@ COValue::Type SDOValueIndicator::SDOValueType() const
 void SDOValueIndicator::resetSDOValue()
 {
     if(m_sdoValue != nullptr){
-        disconnect(m_sdoValue, &SDOValue::readed, this, &SDOValueIndicator::sdovalueReaded);
+        m_demand->removeValue(m_sdoValue);
+
+        if(m_valsHolder != nullptr && m_pollPeriod > 0) m_valsHolder->releaseValuePeriod(m_sdoValue, m_pollPeriod);
 
         if(m_valsHolder != nullptr) m_valsHolder->delSdoValue(m_sdoValue);
         m_sdoValue = nullptr;
@@ -286,10 +320,10 @@ void SDOValueIndicator::applyAppearance()
     update();
 }
 
-void SDOValueIndicator::sdovalueReaded()
+void SDOValueIndicator::sdovaluesUpdated()
 {
-    auto sdoval = qobject_cast<CoValuesHolder::HoldedSDOValuePtr>(sender());
-    if(sdoval == nullptr) return;
+    auto sdoval = m_sdoValue;
+    if(sdoval == nullptr || !m_valsHolder->valueChanged(sdoval)) return;
 
     auto value = COValue::valueFrom<uint32_t>(sdoval->data(), m_sdoValueType, 0);
 
@@ -8,6 +8,7 @@
 
 
 class SDOValue;
+class CoValueDemand;
 class QImage;
 
 
@@ -68,6 +69,10 @@ public:
     uint32_t indicatorValue() const;
     void setIndicatorValue(uint32_t newIndicatorValue);
 
+    // poll period of the value, ms (0 - update interval).
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     bool setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType);
     CoValuesHolder::HoldedSDOValuePtr getSDOValue();
     CoValuesHolder::HoldedSDOValuePtr getSDOValue() const;
@@ -82,11 +87,13 @@ public:
     void applyAppearance();
 
 private slots:
-    void sdovalueReaded();
+    void sdovaluesUpdated();
 
 protected:
     CoValuesHolder* m_valsHolder;
+    CoValueDemand* m_demand;
     CoValuesHolder::HoldedSDOValuePtr m_sdoValue;
+    int m_pollPeriod;
     COValue::Type m_sdoValueType;
 
     QImage* m_imgBuffer;
@@ -1,6 +1,7 @@
 #include "sdovalueindicatoreditdlg.h"
 #include "ui_sdovalueindicatoreditdlg.h"
 #include "covaluetypes.h"
+#include "bitfieldeditdlg.h"
 #include <stdint.h>
 #include <QColorDialog>
 #include <QDebug>
@@ -78,7 +79,25 @@ COValue::Type SDOValueIndicatorEditDlg::type() const
 
 void SDOValueIndicatorEditDlg::setType(COValue::Type newType)
 {
-    ui->cbType->setCurrentIndex(ui->cbType->findData(static_cast<int>(newType)));
+    int index = ui->cbType->findData(static_cast<int>(newType));
+
+    // bit fields are not listed.
+    if(index == -1 && COValue::isBitField(newType)){
+        ui->cbType->addItem(COValue::typeName(newType), static_cast<int>(newType));
+        index = ui->cbType->count() - 1;
+    }
+
+    ui->cbType->setCurrentIndex(index);
+}
+
+int SDOValueIndicatorEditDlg::pollPeriod() const
+{
+    return ui->sbPollPeriod->value();
+}
+
+void SDOValueIndicatorEditDlg::setPollPeriod(int newPollPeriod)
+{
+    ui->sbPollPeriod->setValue(newPollPeriod);
 }
 
 int SDOValueIndicatorEditDlg::posRow() const
@@ -265,6 +284,18 @@ void SDOValueIndicatorEditDlg::setIndicatorValue(uint32_t newIndicatorValue)
     ui->leIndicatorValue->setText(QStringLiteral("0x%1").arg(newIndicatorValue, 0, 16));
 }
 
+void SDOValueIndicatorEditDlg::on_tbBitFieldSel_clicked(bool checked)
+{
+    Q_UNUSED(checked);
+
+    BitFieldEditDlg dlg(this);
+    dlg.setType(type());
+
+    if(dlg.exec() == QDialog::Accepted){
+        setType(dlg.type());
+    }
+}
+
 void SDOValueIndicatorEditDlg::on_tbBackColorSel_clicked(bool checked)
 {
     Q_UNUSED(checked)
@@ -35,6 +35,10 @@ public:
     COValue::Type type() const;
     void setType(COValue::Type newType);
 
+    // ms, 0 - update interval.
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     int posRow() const;
     void setPosRow(int newPosRow);
 
@@ -81,6 +85,7 @@ public:
     void setIndicatorValue(uint32_t newIndicatorValue);
 
 private slots:
+    void on_tbBitFieldSel_clicked(bool checked = false);
     void on_tbBackColorSel_clicked(bool checked = false);
     void on_tbShadowColorSel_clicked(bool checked = false);
     void on_tbIndicatorColorSel_clicked(bool checked = false);
@@ -1,28 +1,43 @@
 #include "sdovalueplot.h"
 #include "sdovalue.h"
+#include "covaluedemand.h"
 #include <algorithm>
+#include <cmath>
 #include <QDebug>
 
 
 #define SDOVALUEPLOT_FALLBACK_VALUE 0.0
 #define SDOVALUEPLOT_TIMEOUT_VALUE it->value
+// Timer sampling is resumed after missed SYNC periods.
+#define SDOVALUEPLOT_SYNC_TIMEOUT_PERIODS 3
+#define SDOVALUEPLOT_SYNC_MIN_TIMEOUT_MS 100
 
 
 SDOValuePlot::SDOValuePlot(const QString& newName, CoValuesHolder* valsHolder, QWidget* parent)
     :SignalPlot(newName, parent)
 {
     m_valsHolder = nullptr;
+    m_demand = new CoValueDemand(this);
+    m_syncNum = 0;
+    m_syncPeriod = 0;
     setValuesHolder(valsHolder);
+
+    // only the new samples are painted on the holder ticks.
+    setIncremental(true);
 }
 
 SDOValuePlot::~SDOValuePlot()
 {
     if(m_valsHolder){
         for(auto& valData: m_sdoValues){
+            m_demand->removeValue(valData.sdoval);
+            if(valData.pollPeriod > 0) m_valsHolder->releaseValuePeriod(valData.sdoval, valData.pollPeriod);
             m_valsHolder->delSdoValue(valData.sdoval);
         }
         m_sdoValues.clear();
     }
+
+    delete m_demand;
 }
 
 CoValuesHolder* SDOValuePlot::valuesHolder() const
@@ -34,10 +49,15 @@ void SDOValuePlot::setValuesHolder(CoValuesHolder* newValuesHolder)
 {
     if(m_valsHolder){
         disconnect(m_valsHolder, &CoValuesHolder::updateBegin, this, &SDOValuePlot::sdovalsUpdating);
+        disconnect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValuePlot::sdovaluesUpdated);
+        disconnect(m_valsHolder, &CoValuesHolder::syncSampled, this, &SDOValuePlot::sdovalsSyncSampled);
     }
     m_valsHolder = newValuesHolder;
+    m_demand->setValuesHolder(newValuesHolder);
     if(m_valsHolder){
         connect(newValuesHolder, &CoValuesHolder::updateBegin, this, &SDOValuePlot::sdovalsUpdating);
+        connect(newValuesHolder, &CoValuesHolder::valuesUpdated, this, &SDOValuePlot::sdovaluesUpdated);
+        connect(newValuesHolder, &CoValuesHolder::syncSampled, this, &SDOValuePlot::sdovalsSyncSampled);
     }
 }
 
@@ -52,16 +72,47 @@ bool SDOValuePlot::addSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::Sub
     int signal_num = addSignal(newName, newColor, z);
     if(signal_num == -1) return false;
 
-    auto sdoValPtr = m_valsHolder->addSdoValue(newNodeId, newIndex, newSubIndex, typeSize);
+    // plot samples are kept over the other values on the busy bus.
+    auto sdoValPtr = m_valsHolder->addSdoValue(newNodeId, newIndex, newSubIndex, typeSize, 0,
+                                               CoValuesHolder::POLL_PRIORITY_HIGH);
 
     if(sdoValPtr == nullptr){
         removeSignal(signal_num);
         return false;
     }
 
-    m_sdoValues.append({sdoValPtr, true, type, 0.0});
+    m_sdoValues.append({sdoValPtr, true, type, 0.0, 0, 0.0, 0});
+    m_demand->addValue(sdoValPtr);
+
+    return true;
+}
+
+bool SDOValuePlot::addSDOWaveform(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type type,
+                                  int samplesCount, qreal samplePeriod,
+                                  const QString& newName, const QColor& newColor, const qreal& z)
+{
+    if(m_valsHolder == nullptr) return false;
+    if(samplesCount <= 0 || samplePeriod <= 0.0) return false;
+
+    size_t typeSize = COValue::typeSize(type);
+    if(typeSize == 0) return false;
+
+    int signal_num = addSignal(newName, newColor, z);
+    if(signal_num == -1) return false;
+
+    // the buffer is uploaded once per capture.
+    int period = static_cast<int>(std::ceil(samplesCount * samplePeriod * 1000));
+
+    auto sdoValPtr = m_valsHolder->addSdoValue(newNodeId, newIndex, newSubIndex, typeSize * static_cast<size_t>(samplesCount), 0,
+                                               CoValuesHolder::POLL_PRIORITY_NORMAL, period);
+
+    if(sdoValPtr == nullptr){
+        removeSignal(signal_num);
+        return false;
+    }
 
-    connect(sdoValPtr, &SDOValue::readed, this, &SDOValuePlot::sdovalueReaded);
+    m_sdoValues.append({sdoValPtr, false, type, 0.0, samplesCount, samplePeriod, 0});
+    m_demand->addValue(sdoValPtr);
 
     return true;
 }
@@ -86,7 +137,8 @@ void SDOValuePlot::delSDOValue(int n)
 
     removeSignal(n);
 
-    disconnect(item.sdoval, &SDOValue::readed, this, &SDOValuePlot::sdovalueReaded);
+    m_demand->removeValue(item.sdoval);
+    if(item.pollPeriod > 0) m_valsHolder->releaseValuePeriod(item.sdoval, item.pollPeriod);
     m_valsHolder->delSdoValue(item.sdoval);
 
     m_sdoValues.removeAt(n);
@@ -113,18 +165,52 @@ COValue::Type SDOValuePlot::SDOValueType(int n) const
     return m_sdoValues[n].type;
 }
 
-void SDOValuePlot::sdovalueReaded()
+int SDOValuePlot::SDOValueSamples(int n) const
+{
+    if(n < 0 || n >= m_sdoValues.size()) return 0;
+
+    return m_sdoValues[n].samples;
+}
+
+qreal SDOValuePlot::SDOValueSamplePeriod(int n) const
+{
+    if(n < 0 || n >= m_sdoValues.size()) return 0.0;
+
+    return m_sdoValues[n].samplePeriod;
+}
+
+int SDOValuePlot::SDOValuePollPeriod(int n) const
 {
-    auto sdoval = qobject_cast<CoValuesHolder::HoldedSDOValuePtr>(sender());
-    if(sdoval == nullptr) return;
+    if(n < 0 || n >= m_sdoValues.size()) return 0;
+
+    return m_sdoValues[n].pollPeriod;
+}
+
+void SDOValuePlot::setSDOValuePollPeriod(int n, int newPollPeriod)
+{
+    if(n < 0 || n >= m_sdoValues.size()) return;
+
+    auto& item = m_sdoValues[n];
+
+    if(item.pollPeriod > 0) m_valsHolder->releaseValuePeriod(item.sdoval, item.pollPeriod);
+
+    item.pollPeriod = qMax(newPollPeriod, 0);
+
+    if(item.pollPeriod > 0) m_valsHolder->addValuePeriod(item.sdoval, item.pollPeriod);
+}
 
+void SDOValuePlot::sdovaluesUpdated()
+{
     int n = 0;
-    auto it = m_sdoValues.begin();
-    for(; it != m_sdoValues.end(); ++ it, n ++){
-        if(it->sdoval == sdoval) break;
-    }
+    for(auto it = m_sdoValues.begin(); it != m_sdoValues.end(); ++ it, n ++){
+        if(!m_valsHolder->valueUpdated(it->sdoval)) continue;
+
+        // captures are put as is.
+        if(it->samples > 0){
+            if(m_demand->active()) putWaveform(n, *it);
+            continue;
+        }
 
-    if(it != m_sdoValues.end()){
         it->value = COValue::valueFrom<qreal>(it->sdoval->data(), it->type, SDOVALUEPLOT_FALLBACK_VALUE);
         it->readed = true;
     }
@@ -134,16 +220,92 @@ void SDOValuePlot::sdovalsUpdating()
 {
     //qDebug() << "sdovalsUpdating";
 
+    // hidden plot is not sampled & replotted.
+    if(!m_demand->active()){
+        m_elapsedTimer.invalidate();
+        return;
+    }
+
+    // samples are put on SYNC.
+    if(syncAligned()){
+        updatePlot();
+        return;
+    }
+    m_syncTimer.invalidate();
+
     qreal dt = 0.0;
     if(m_elapsedTimer.isValid()) dt = static_cast<qreal>(m_elapsedTimer.elapsed()) / 1000;
     m_elapsedTimer.start();
 
+    putSamples(dt);
+
+    updatePlot();
+}
+
+void SDOValuePlot::sdovalsSyncSampled(quint32 syncNum, quint32 periodUs)
+{
+    if(!m_demand->active()){
+        m_elapsedTimer.invalidate();
+        m_syncTimer.invalidate();
+        return;
+    }
+
+    qreal dt = 0.0;
+    // time between the samples by the SYNC counter,
+    // independent on the reception jitter.
+    if(syncAligned() && periodUs != 0){
+        dt = static_cast<qreal>(syncNum - m_syncNum) * periodUs / 1000000;
+    }else if(m_elapsedTimer.isValid()){
+        dt = static_cast<qreal>(m_elapsedTimer.elapsed()) / 1000;
+    }
+    m_elapsedTimer.start();
+
+    m_syncNum = syncNum;
+    m_syncPeriod = periodUs;
+    m_syncTimer.start();
+
+    putSamples(dt);
+}
+
+bool SDOValuePlot::syncAligned() const
+{
+    if(!m_syncTimer.isValid()) return false;
+
+    qint64 timeout = std::max(static_cast<qint64>(m_syncPeriod) * SDOVALUEPLOT_SYNC_TIMEOUT_PERIODS / 1000,
+                              static_cast<qint64>(SDOVALUEPLOT_SYNC_MIN_TIMEOUT_MS));
+
+    return m_syncTimer.elapsed() <= timeout;
+}
+
+void SDOValuePlot::putSamples(qreal dt)
+{
     int n = 0;
     for(auto it = m_sdoValues.begin(); it != m_sdoValues.end(); ++ it, n ++){
+        if(it->samples > 0) continue;
+
         putSample(n, it->readed ? it->value : SDOVALUEPLOT_TIMEOUT_VALUE, dt);
         it->readed = false;
     }
+}
+
+void SDOValuePlot::putWaveform(int n, const SDOValItem& item)
+{
+    const quint8* data = static_cast<const quint8*>(item.sdoval->data());
+    if(data == nullptr) return;
+
+    size_t typeSize = COValue::typeSize(item.type);
+
+    // the capture may be shorter than the buffer.
+    size_t dataSize = item.sdoval->transferedDataSize();
+    if(dataSize == 0 || dataSize > item.sdoval->dataSize()) dataSize = item.sdoval->dataSize();
+
+    int count = static_cast<int>(std::min(dataSize / typeSize, static_cast<size_t>(item.samples)));
+    if(count <= 0) return;
+
+    m_waveform.resize(count);
+
+    if(!COValue::valuesFrom(data, item.type, m_waveform.data(), static_cast<size_t>(count))) return;
 
-    replot();
+    SignalPlot::putSamples(n, m_waveform.constData(), static_cast<size_t>(count), item.samplePeriod);
 }
 
@@ -9,9 +9,12 @@
 #include <variant>
 #include <QList>
 #include <QPair>
+#include <QVector>
 #include <QElapsedTimer>
 
 
+class CoValueDemand;
+
 
 class SDOValuePlot : public SignalPlot
 {
@@ -25,29 +28,60 @@ public:
 
     bool addSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type type,
                      const QString& newName = QString(), const QColor& newColor = QColor(), const qreal& z = -1);
+    /*
+     * Waveform signal.
+     * Node side capture buffer (array or DOMAIN) of the samplesCount packed samples
+     * is uploaded once per capture (block SDO if enabled)
+     * and put to the signal buffer with the samplePeriod step, s.
+     */
+    bool addSDOWaveform(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type type,
+                        int samplesCount, qreal samplePeriod,
+                        const QString& newName = QString(), const QColor& newColor = QColor(), const qreal& z = -1);
     int SDOValuesCount() const;
     CoValuesHolder::HoldedSDOValuePtr getSDOValue(int n) const;
     void delSDOValue(int n);
     void delSDOValue(CoValuesHolder::HoldedSDOValuePtr sdoval);
     void delAllSDOValues();
     COValue::Type SDOValueType(int n) const;
+    // 0 - single value.
+    int SDOValueSamples(int n) const;
+    qreal SDOValueSamplePeriod(int n) const;
+    // poll period of the signal value, ms (0 - update interval).
+    int SDOValuePollPeriod(int n) const;
+    void setSDOValuePollPeriod(int n, int newPollPeriod);
 
 private slots:
-    void sdovalueReaded();
+    void sdovaluesUpdated();
     void sdovalsUpdating();
+    void sdovalsSyncSampled(quint32 syncNum, quint32 periodUs);
 
 protected:
     CoValuesHolder* m_valsHolder;
+    CoValueDemand* m_demand;
 
     struct SDOValItem{
         CoValuesHolder::HoldedSDOValuePtr sdoval;
         bool readed;
         COValue::Type type;
         qreal value;
+        int samples;
+        qreal samplePeriod;
+        int pollPeriod;
     };
 
     QList<SDOValItem> m_sdoValues;
     QElapsedTimer m_elapsedTimer;
+    // converted waveform samples.
+    QVector<qreal> m_waveform;
+
+    // SYNC aligned samples.
+    QElapsedTimer m_syncTimer;
+    quint32 m_syncNum;
+    quint32 m_syncPeriod;
+
+    bool syncAligned() const;
+    void putSamples(qreal dt);
+    void putWaveform(int n, const SDOValItem& item);
 };
 
 #endif // SDOVALUEPLOT_H
@@ -1,5 +1,7 @@
 #include "sdovalueslider.h"
 #include "sdovalue.h"
+#include "covaluedemand.h"
+#include "sdowritecoalescer.h"
 #include <QPaintEvent>
 #include <QwtAbstractScaleDraw>
 #include <QPainter>
@@ -16,8 +18,11 @@
 SDOValueSlider::SDOValueSlider(CoValuesHolder* newValsHolder, QWidget* parent)
     :QwtSlider(parent)
 {
-    m_valsHolder = newValsHolder;
+    m_valsHolder = nullptr;
+    m_demand = new CoValueDemand(this);
+    setValuesHolder(newValsHolder);
     m_rdSdoValue = nullptr;
+    m_pollPeriod = 0;
     m_wrSdoValue = nullptr;
     m_sdoValueType = COValue::Type();
     m_name = tr("Слайдер");
@@ -35,6 +40,8 @@ SDOValueSlider::SDOValueSlider(CoValuesHolder* newValsHolder, QWidget* parent)
 SDOValueSlider::~SDOValueSlider()
 {
     resetSDOValue();
+
+    delete m_demand;
 }
 
 QString SDOValueSlider::name() const
@@ -54,7 +61,14 @@ CoValuesHolder* SDOValueSlider::valuesHolder() const
 
 void SDOValueSlider::setValuesHolder(CoValuesHolder* newValuesHolder)
 {
+    if(m_valsHolder){
+        disconnect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueSlider::sdovaluesUpdated);
+    }
     m_valsHolder = newValuesHolder;
+    m_demand->setValuesHolder(newValuesHolder);
+    if(m_valsHolder){
+        connect(m_valsHolder, &CoValuesHolder::valuesUpdated, this, &SDOValueSlider::sdovaluesUpdated);
+    }
 }
 
 QColor SDOValueSlider::troughColor() const
@@ -202,6 +216,24 @@ void SDOValueSlider::setRangeMax(qreal newRangeMax)
     setUpperBound(newRangeMax);
 }
 
+int SDOValueSlider::pollPeriod() const
+{
+    return m_pollPeriod;
+}
+
+void SDOValueSlider::setPollPeriod(int newPollPeriod)
+{
+    if(m_rdSdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->releaseValuePeriod(m_rdSdoValue, m_pollPeriod);
+    }
+
+    m_pollPeriod = qMax(newPollPeriod, 0);
+
+    if(m_rdSdoValue != nullptr && m_pollPeriod > 0){
+        m_valsHolder->addValuePeriod(m_rdSdoValue, m_pollPeriod);
+    }
+}
+
 bool SDOValueSlider::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType, qreal newMin, qreal newMax)
 {
     if(m_valsHolder == nullptr) return false;
@@ -217,7 +249,10 @@ bool SDOValueSlider::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::S
     m_wrSdoValue->setDataSize(typeSize);
 
 #if defined(SDOVALUESLIDER_MESSAGE_ON_WRITE_ERROR) && SDOVALUESLIDER_MESSAGE_ON_WRITE_ERROR == 1
-    connect(m_wrSdoValue, &SDOValue::errorOccured, this, [this](){
+    connect(m_valsHolder->writeCoalescer(), &SDOWriteCoalescer::errorOccured, this,
+            [this](CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex){
+        if(m_wrSdoValue == nullptr) return;
+        if(nodeId != m_wrSdoValue->nodeId() || index != m_wrSdoValue->index() || subIndex != m_wrSdoValue->subIndex()) return;
         QMessageBox::critical(this, tr("Ошибка!"), tr("Невозможно записать значение!"));
     });
 #endif
@@ -232,7 +267,8 @@ bool SDOValueSlider::setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::S
 
     setScale(newMin, newMax);
 
-    connect(m_rdSdoValue, &SDOValue::readed, this, &SDOValueSlider::sdovalueReaded);
+    m_demand->addValue(m_rdSdoValue);
+    if(m_pollPeriod > 0) m_valsHolder->addValuePeriod(m_rdSdoValue, m_pollPeriod);
 
     return true;
 }
@@ -255,7 +291,9 @@ COValue::Type SDOValueSlider::SDOValueType() const
 void SDOValueSlider::resetSDOValue()
 {
     if(m_rdSdoValue != nullptr){
-        disconnect(m_rdSdoValue, &SDOValue::readed, this, &SDOValueSlider::sdovalueReaded);
+        m_demand->removeValue(m_rdSdoValue);
+
+        if(m_valsHolder != nullptr && m_pollPeriod > 0) m_valsHolder->releaseValuePeriod(m_rdSdoValue, m_pollPeriod);
 
         if(m_valsHolder != nullptr) m_valsHolder->delSdoValue(m_rdSdoValue);
         m_rdSdoValue = nullptr;
@@ -263,19 +301,19 @@ void SDOValueSlider::resetSDOValue()
 
     if(m_wrSdoValue != nullptr){
 #if defined(SDOVALUESLIDER_MESSAGE_ON_WRITE_ERROR) && SDOVALUESLIDER_MESSAGE_ON_WRITE_ERROR == 1
-        disconnect(m_wrSdoValue, &SDOValue::errorOccured, nullptr, nullptr);
+        if(m_valsHolder != nullptr) disconnect(m_valsHolder->writeCoalescer(), &SDOWriteCoalescer::errorOccured, this, nullptr);
 #endif
         delete m_wrSdoValue;
         m_wrSdoValue = nullptr;
     }
 }
 
-void SDOValueSlider::sdovalueReaded()
+void SDOValueSlider::sdovaluesUpdated()
 {
     if(m_updateMask) return;
 
-    auto sdoval = qobject_cast<CoValuesHolder::HoldedSDOValuePtr>(sender());
-    if(sdoval == nullptr) return;
+    auto sdoval = m_rdSdoValue;
+    if(sdoval == nullptr || !m_valsHolder->valueUpdated(sdoval)) return;
 
     setValue(COValue::valueFrom<qreal>(sdoval->data(), m_sdoValueType, 0.0));
 }
@@ -318,14 +356,18 @@ void SDOValueSlider::sliderChange()
 
     QwtSlider::sliderChange();
 
-    if(!m_wrSdoValue->running()){
-//        qDebug() << /*"sliderChange()" <<*/ value()
-//                 << COValue::valueTo(m_wrSdoValue->data(), m_sdoValueType, value())
-//                 << COValue::valueFrom(m_wrSdoValue->data(), m_sdoValueType, 0.0);
+    if(m_valsHolder == nullptr || m_wrSdoValue == nullptr) return;
+
+    // other bits of the bit field are kept as read.
+    if(COValue::isBitField(m_sdoValueType) && m_rdSdoValue != nullptr && m_rdSdoValue->data() != nullptr){
+        memcpy(m_wrSdoValue->data(), m_rdSdoValue->data(), m_wrSdoValue->dataSize());
+    }
 
-        if(COValue::valueTo(m_wrSdoValue->data(), m_sdoValueType, value())){
-        /*qDebug() << */m_wrSdoValue->write();
-        }
+    // m_wrSdoValue is used only as the value buffer,
+    // the holder's coalescer sends the latest value.
+    if(COValue::valueTo(m_wrSdoValue->data(), m_sdoValueType, value())){
+        m_valsHolder->writeValue(m_wrSdoValue->nodeId(), m_wrSdoValue->index(), m_wrSdoValue->subIndex(),
+                                 m_wrSdoValue->data(), m_wrSdoValue->dataSize());
     }
 }
 
@@ -8,6 +8,7 @@
 
 
 class SDOValue;
+class CoValueDemand;
 
 
 class SDOValueSlider : public QwtSlider
@@ -59,6 +60,10 @@ public:
     qreal rangeMax() const;
     void setRangeMax(qreal newRangeMax);
 
+    // poll period of the value, ms (0 - update interval).
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     bool setSDOValue(CO::NodeId newNodeId, CO::Index newIndex, CO::SubIndex newSubIndex, COValue::Type newType, qreal newMin = 0.0, qreal newMax = 1.0);
     CoValuesHolder::HoldedSDOValuePtr getSDOValue();
     CoValuesHolder::HoldedSDOValuePtr getSDOValue() const;
@@ -66,11 +71,13 @@ public:
     void resetSDOValue();
 
 private slots:
-    void sdovalueReaded();
+    void sdovaluesUpdated();
 
 protected:
     CoValuesHolder* m_valsHolder;
+    CoValueDemand* m_demand;
     CoValuesHolder::HoldedSDOValuePtr m_rdSdoValue;
+    int m_pollPeriod;
     SDOValue* m_wrSdoValue;
     COValue::Type m_sdoValueType;
     QString m_name;
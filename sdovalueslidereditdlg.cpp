@@ -1,6 +1,7 @@
 #include "sdovalueslidereditdlg.h"
 #include "ui_sdovalueslidereditdlg.h"
 #include "covaluetypes.h"
+#include "bitfieldeditdlg.h"
 #include <QColorDialog>
 
 
@@ -76,7 +77,25 @@ COValue::Type SDOValueSliderEditDlg::type() const
 
 void SDOValueSliderEditDlg::setType(COValue::Type newType)
 {
-    ui->cbType->setCurrentIndex(ui->cbType->findData(static_cast<int>(newType)));
+    int index = ui->cbType->findData(static_cast<int>(newType));
+
+    // bit fields are not listed.
+    if(index == -1 && COValue::isBitField(newType)){
+        ui->cbType->addItem(COValue::typeName(newType), static_cast<int>(newType));
+        index = ui->cbType->count() - 1;
+    }
+
+    ui->cbType->setCurrentIndex(index);
+}
+
+int SDOValueSliderEditDlg::pollPeriod() const
+{
+    return ui->sbPollPeriod->value();
+}
+
+void SDOValueSliderEditDlg::setPollPeriod(int newPollPeriod)
+{
+    ui->sbPollPeriod->setValue(newPollPeriod);
 }
 
 int SDOValueSliderEditDlg::posRow() const
@@ -257,6 +276,18 @@ void SDOValueSliderEditDlg::setOrientation(Qt::Orientation newOrientation)
     ui->cbOrientation->setCurrentIndex(ui->cbOrientation->findData(static_cast<int>(newOrientation)));
 }
 
+void SDOValueSliderEditDlg::on_tbBitFieldSel_clicked(bool checked)
+{
+    Q_UNUSED(checked);
+
+    BitFieldEditDlg dlg(this);
+    dlg.setType(type());
+
+    if(dlg.exec() == QDialog::Accepted){
+        setType(dlg.type());
+    }
+}
+
 void SDOValueSliderEditDlg::on_tbTroughColorSel_clicked(bool checked)
 {
     Q_UNUSED(checked)
@@ -34,6 +34,10 @@ public:
     COValue::Type type() const;
     void setType(COValue::Type newType);
 
+    // ms, 0 - update interval.
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
     int posRow() const;
     void setPosRow(int newPosRow);
 
@@ -83,6 +87,7 @@ public:
     void setOrientation(Qt::Orientation newAlign);
 
 private slots:
+    void on_tbBitFieldSel_clicked(bool checked = false);
     void on_tbTroughColorSel_clicked(bool checked = false);
     void on_tbGrooveColorSel_clicked(bool checked = false);
     void on_tbHandleColorSel_clicked(bool checked = false);
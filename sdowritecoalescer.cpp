@@ -0,0 +1,294 @@
+#include "sdowritecoalescer.h"
+#include "slcanopennode.h"
+#include "sdocomm.h"
+#include <QTimer>
+#include <algorithm>
+#include <QDebug>
+
+
+#define SDO_WRITE_COALESCER_DEFAULT_INTERVAL 50
+#define SDO_WRITE_COALESCER_DEFAULT_RETRIES 2
+
+
+
+SDOWriteCoalescer::SDOWriteCoalescer(SLCanOpenNode* slcon, QObject *parent)
+    : QObject{parent}
+{
+    m_slcon = slcon;
+    m_minInterval = SDO_WRITE_COALESCER_DEFAULT_INTERVAL;
+    m_retries = SDO_WRITE_COALESCER_DEFAULT_RETRIES;
+    m_writesCount = 0;
+    m_coalescedCount = 0;
+
+    m_flushTimer = new QTimer();
+    m_flushTimer->setSingleShot(true);
+    connect(m_flushTimer, &QTimer::timeout, this, &SDOWriteCoalescer::flushPending);
+}
+
+SDOWriteCoalescer::~SDOWriteCoalescer()
+{
+    cancelAll();
+    delete m_flushTimer;
+}
+
+SLCanOpenNode* SDOWriteCoalescer::getSLCanOpenNode()
+{
+    return m_slcon;
+}
+
+bool SDOWriteCoalescer::setSLCanOpenNode(SLCanOpenNode* slcon)
+{
+    if(m_slcon == slcon) return true;
+
+    cancelAll();
+
+    m_slcon = slcon;
+
+    return true;
+}
+
+int SDOWriteCoalescer::minInterval() const
+{
+    return m_minInterval;
+}
+
+void SDOWriteCoalescer::setMinInterval(int newMinInterval)
+{
+    m_minInterval = std::max(newMinInterval, 0);
+}
+
+int SDOWriteCoalescer::retries() const
+{
+    return m_retries;
+}
+
+void SDOWriteCoalescer::setRetries(int newRetries)
+{
+    m_retries = std::max(newRetries, 0);
+}
+
+bool SDOWriteCoalescer::write(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex, const void* data, size_t dataSize, int timeout)
+{
+    if(m_slcon == nullptr || !m_slcon->isConnected()) return false;
+    if(data == nullptr || dataSize == 0) return false;
+
+    FullIndex key = makeFullIndex(nodeId, index, subIndex);
+
+    Item* item = getItem(key);
+
+    if(item->hasLatest) m_coalescedCount ++;
+
+    item->latest = QByteArray(static_cast<const char*>(data), static_cast<int>(dataSize));
+    item->hasLatest = true;
+    item->retriesLeft = m_retries;
+    item->timeout = timeout;
+
+    if(item->sdoc->running()) return true;
+
+    int ms = msToWrite(item, meas_clock::now());
+    if(ms <= 0){
+        return startWrite(key, item);
+    }
+
+    scheduleFlush(ms);
+
+    return true;
+}
+
+bool SDOWriteCoalescer::running(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const
+{
+    Item* item = m_items.value(makeFullIndex(nodeId, index, subIndex), nullptr);
+    if(item == nullptr) return false;
+
+    return item->sdoc->running();
+}
+
+bool SDOWriteCoalescer::hasPending(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const
+{
+    Item* item = m_items.value(makeFullIndex(nodeId, index, subIndex), nullptr);
+    if(item == nullptr) return false;
+
+    return item->hasLatest;
+}
+
+size_t SDOWriteCoalescer::writesCount() const
+{
+    return m_writesCount;
+}
+
+size_t SDOWriteCoalescer::coalescedCount() const
+{
+    return m_coalescedCount;
+}
+
+void SDOWriteCoalescer::resetCounters()
+{
+    m_writesCount = 0;
+    m_coalescedCount = 0;
+}
+
+void SDOWriteCoalescer::cancelAll()
+{
+    m_flushTimer->stop();
+
+    for(auto it = m_items.begin(); it != m_items.end(); ++ it){
+        deleteItem(it.value());
+    }
+    m_items.clear();
+}
+
+void SDOWriteCoalescer::flushPending()
+{
+    auto tp = meas_clock::now();
+    int nextMs = -1;
+
+    for(auto it = m_items.begin(); it != m_items.end(); ++ it){
+        Item* item = it.value();
+
+        if(!item->hasLatest || item->sdoc->running()) continue;
+
+        int ms = msToWrite(item, tp);
+        if(ms <= 0){
+            startWrite(it.key(), item);
+        }else{
+            nextMs = (nextMs < 0) ? ms : std::min(nextMs, ms);
+        }
+    }
+
+    if(nextMs > 0) scheduleFlush(nextMs);
+}
+
+SDOWriteCoalescer::Item* SDOWriteCoalescer::getItem(FullIndex key)
+{
+    auto it = m_items.find(key);
+    if(it != m_items.end()) return it.value();
+
+    Item* item = new Item();
+    item->sdoc = new SDOComm();
+    item->hasLatest = false;
+    item->retriesLeft = 0;
+    item->timeout = 0;
+    item->lastWriteTp = meas_clock::time_point();
+
+    connect(item->sdoc, &SDOComm::finished, this, [this, key](){ sdocommFinished(key); });
+
+    m_items.insert(key, item);
+
+    return item;
+}
+
+bool SDOWriteCoalescer::startWrite(FullIndex key, Item* item)
+{
+    if(m_slcon == nullptr) return false;
+
+    item->inFlight = item->latest;
+    item->lastWriteTp = meas_clock::now();
+
+    CO::NodeId nodeId = static_cast<CO::NodeId>(key >> 24);
+    CO::Index index = static_cast<CO::Index>(key >> 8);
+    CO::SubIndex subIndex = static_cast<CO::SubIndex>(key);
+
+    if(m_slcon->write(nodeId, index, subIndex, item->inFlight.data(), item->inFlight.size(),
+                      item->sdoc, item->timeout) == nullptr){
+        // the value stays pending until the write starts or the retries are over.
+        if(item->retriesLeft > 0){
+            item->retriesLeft --;
+            scheduleFlush(std::max(m_minInterval, 1));
+        }else{
+            item->latest.clear();
+            item->hasLatest = false;
+
+            emit errorOccured(nodeId, index, subIndex);
+        }
+        return false;
+    }
+
+    item->latest.clear();
+    item->hasLatest = false;
+
+    m_writesCount ++;
+
+    return true;
+}
+
+void SDOWriteCoalescer::sdocommFinished(FullIndex key)
+{
+    Item* item = m_items.value(key, nullptr);
+    if(item == nullptr) return;
+
+    SDOComm* sdoc = item->sdoc;
+
+    CO::NodeId nodeId = static_cast<CO::NodeId>(key >> 24);
+    CO::Index index = static_cast<CO::Index>(key >> 8);
+    CO::SubIndex subIndex = static_cast<CO::SubIndex>(key);
+
+    if(sdoc->error() == SDOComm::ERROR_NONE){
+        emit written(nodeId, index, subIndex);
+    }else if(!(sdoc->error() == SDOComm::ERROR_CANCEL && sdoc->cancelled())){
+        // retry the last value.
+        if(!item->hasLatest && item->retriesLeft > 0){
+            item->latest = item->inFlight;
+            item->hasLatest = true;
+            item->retriesLeft --;
+        }else{
+            emit errorOccured(nodeId, index, subIndex);
+        }
+    }
+
+    if(!item->hasLatest) return;
+
+    int ms = msToWrite(item, meas_clock::now());
+    if(ms <= 0){
+        startWrite(key, item);
+    }else{
+        scheduleFlush(ms);
+    }
+}
+
+int SDOWriteCoalescer::msToWrite(const Item* item, const meas_clock::time_point& tp) const
+{
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(tp - item->lastWriteTp).count();
+
+    if(elapsed >= m_minInterval) return 0;
+
+    return m_minInterval - static_cast<int>(elapsed);
+}
+
+void SDOWriteCoalescer::scheduleFlush(int ms)
+{
+    if(!m_flushTimer->isActive() || m_flushTimer->remainingTime() > ms){
+        m_flushTimer->start(ms);
+    }
+}
+
+void SDOWriteCoalescer::deleteItem(Item* item)
+{
+    SDOComm* sdoc = item->sdoc;
+
+    if(!sdoc->running() || (m_slcon != nullptr && m_slcon->cancel(sdoc))){
+        delete sdoc;
+        delete item;
+        return;
+    }
+
+    sdoc->disconnect();
+
+    // keep data buffer until the comm finished.
+    QByteArray dataToDelete = item->inFlight;
+    connect(sdoc, &SDOComm::finished, sdoc, [sdoc, dataToDelete](){ sdoc->deleteLater(); });
+
+    sdoc->cancel();
+
+    delete item;
+}
+
+SDOWriteCoalescer::FullIndex SDOWriteCoalescer::makeFullIndex(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const
+{
+    FullIndex valFullIndex = 0;
+
+    valFullIndex |= (quint32)nodeId << 24;
+    valFullIndex |= (quint32)index << 8;
+    valFullIndex |= (quint32)subIndex;
+
+    return valFullIndex;
+}
@@ -0,0 +1,95 @@
+#ifndef SDOWRITECOALESCER_H
+#define SDOWRITECOALESCER_H
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include <stddef.h>
+#include <chrono>
+#include "cotypes.h"
+
+
+class QTimer;
+class SDOComm;
+class SLCanOpenNode;
+
+
+/*
+ * Latest-value-wins SDO writer.
+ * Per key: one write in flight and one pending value,
+ * new values replace the pending one.
+ * The last written value is always delivered.
+ */
+class SDOWriteCoalescer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SDOWriteCoalescer(SLCanOpenNode* slcon = nullptr, QObject *parent = nullptr);
+    ~SDOWriteCoalescer();
+
+    SLCanOpenNode* getSLCanOpenNode();
+    bool setSLCanOpenNode(SLCanOpenNode* slcon);
+
+    // Min interval between writes to the same key in ms.
+    int minInterval() const;
+    void setMinInterval(int newMinInterval);
+
+    // Retries of the last value on error.
+    int retries() const;
+    void setRetries(int newRetries);
+
+    bool write(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex,
+               const void* data, size_t dataSize, int timeout = 0);
+
+    bool running(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const;
+    bool hasPending(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const;
+
+    size_t writesCount() const;
+    size_t coalescedCount() const;
+    void resetCounters();
+
+    void cancelAll();
+
+signals:
+    void written(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex);
+    void errorOccured(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex);
+
+private slots:
+    void flushPending();
+
+private:
+    typedef quint32 FullIndex;
+
+    using meas_clock = std::chrono::steady_clock;
+
+    struct Item {
+        SDOComm* sdoc;
+        QByteArray inFlight;
+        QByteArray latest;
+        bool hasLatest;
+        int retriesLeft;
+        int timeout;
+        meas_clock::time_point lastWriteTp;
+    };
+
+    QHash<FullIndex, Item*> m_items;
+
+    SLCanOpenNode* m_slcon;
+    QTimer* m_flushTimer;
+    int m_minInterval;
+    int m_retries;
+
+    size_t m_writesCount;
+    size_t m_coalescedCount;
+
+    Item* getItem(FullIndex key);
+    bool startWrite(FullIndex key, Item* item);
+    void sdocommFinished(FullIndex key);
+    int msToWrite(const Item* item, const meas_clock::time_point& tp) const;
+    void scheduleFlush(int ms);
+    void deleteItem(Item* item);
+
+    FullIndex makeFullIndex(CO::NodeId nodeId, CO::Index index, CO::SubIndex subIndex) const;
+};
+
+#endif // SDOWRITECOALESCER_H
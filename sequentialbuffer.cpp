@@ -1,12 +1,21 @@
 #include "sequentialbuffer.h"
+#include <algorithm>
 
 
 #define SEQ_BUF_TOP_SCALE 0.1
+// Допустимое отклонение X компактной точки, доля шага.
+#define SEQ_BUF_X_TOLERANCE 0.25
+// Минимальное число устаревших меток для их удаления.
+#define SEQ_BUF_ANCHORS_PURGE 64
+// Число блоков (точек) в блоке следующего уровня пирамиды экстремумов.
+#define SEQ_BUF_LOD_FANOUT 16
 
 
 SequentialBuffer::SequentialBuffer()
 {
     m_d = new Data();
+    m_d->storage = POINTS;
+    m_d->size = 0;
     m_d->period = 1.0;
     m_d->startTime = 0.0;
     m_d->addrMode = CIRCULAR;
@@ -15,14 +24,7 @@ SequentialBuffer::SequentialBuffer()
 
 SequentialBuffer::SequentialBuffer(const SequentialBuffer& sb)
 {
-    m_d = new Data();
-    m_d->samples = sb.m_d->samples;
-    m_d->index = sb.m_d->index;
-    m_d->count = sb.m_d->count;
-    m_d->period = sb.m_d->period;
-    m_d->startTime = sb.m_d->startTime;
-    m_d->addrMode = sb.m_d->addrMode;
-    m_d->boundingRect = sb.m_d->boundingRect;
+    m_d = new Data(*sb.m_d);
 }
 
 SequentialBuffer::SequentialBuffer(SequentialBuffer&& sb)
@@ -47,14 +49,49 @@ void SequentialBuffer::setAddressingMode(AddressingMode newMode)
     m_d->addrMode = newMode;
 }
 
+SequentialBuffer::StorageMode SequentialBuffer::storageMode() const
+{
+    return m_d->storage;
+}
+
+void SequentialBuffer::setStorageMode(StorageMode newMode)
+{
+    if(m_d->storage == newMode) return;
+
+    m_d->storage = newMode;
+
+    if(newMode == COMPACT){
+        m_d->samples = QVector<QPointF>();
+        m_d->values.resize(m_d->size);
+    }else{
+        m_d->values = QVector<float>();
+        m_d->samples.resize(m_d->size);
+    }
+
+    clear();
+}
+
 size_t SequentialBuffer::size() const
 {
-    return m_d->samples.size();
+    return static_cast<size_t>(m_d->size);
 }
 
 void SequentialBuffer::setSize(size_t newSize)
 {
-    m_d->samples.resize(newSize);
+    if(static_cast<size_t>(m_d->size) == newSize) return;
+
+    m_d->size = static_cast<int>(newSize);
+
+    if(m_d->storage == COMPACT){
+        m_d->values.resize(m_d->size);
+    }else{
+        m_d->samples.resize(m_d->size);
+    }
+
+    resizeLod();
+
+    // Старые индексы недействительны.
+    reset();
 }
 
 qreal SequentialBuffer::samplingPeriod() const
@@ -83,6 +120,7 @@ void SequentialBuffer::clear()
     //m_d->samples.clear();
     //m_d->samples.resize(sz);
     m_d->samples.fill(QPointF());
+    m_d->values.fill(0.0f);
 
     reset();
 }
@@ -91,7 +129,18 @@ void SequentialBuffer::reset()
 {
     m_d->index = 0;
     m_d->count = 0;
+    m_d->written = 0;
+    m_d->lastX = m_d->startTime;
+    m_d->anchors.clear();
+    m_d->anchorsHead = 0;
     m_d->boundingRect = QRectF(0, 0, -1, -1);
+
+    // Компактному буферу очереди не нужны, границы - по пирамиде экстремумов.
+    int dequeCapacity = (m_d->storage == COMPACT) ? 0 : m_d->size;
+    m_d->minDeque.reset(dequeCapacity);
+    m_d->maxDeque.reset(dequeCapacity);
+    m_d->minIndex = -1;
+    m_d->maxIndex = -1;
 }
 
 size_t SequentialBuffer::avail() const
@@ -99,6 +148,11 @@ size_t SequentialBuffer::avail() const
     return static_cast<size_t>(m_d->count);
 }
 
+quint64 SequentialBuffer::written() const
+{
+    return m_d->written;
+}
+
 void SequentialBuffer::put(const qreal& y, const qreal& dx)
 {
     putAndUpd(y, dx);
@@ -106,25 +160,121 @@ void SequentialBuffer::put(const qreal& y, const qreal& dx)
     //    m_d->count = incCount(m_d->count);
 }
 
+void SequentialBuffer::put(const qreal* y, size_t count, const qreal& dx)
+{
+    if(y == nullptr || count == 0) return;
+
+    QRectF& bounds = m_d->boundingRect;
+
+    int sz = m_d->size;
+    if(sz == 0) return;
+
+    int i = m_d->index;
+    int cnt = m_d->count;
+
+    qreal step = (dx < 0) ? m_d->period : dx;
+
+    // Сохраняются только последние sz точек.
+    size_t skip = (count > static_cast<size_t>(sz)) ? count - static_cast<size_t>(sz) : 0;
+
+    // Координаты первой добавляемой точки.
+    qreal x0;
+    qreal top;
+    qreal bottom;
+    if(cnt == 0){
+        x0 = m_d->startTime + step * skip;
+        top = y[skip];
+        bottom = y[skip];
+    }else{
+        x0 = m_d->lastX + step * (skip + 1);
+        top = bounds.bottom();
+        bottom = bounds.top();
+    }
+
+    // Перезапись старых точек, в том числе пропущенных.
+    bool overwrite = static_cast<size_t>(cnt) + count > static_cast<size_t>(sz);
+
+    qreal x = x0;
+    for(size_t k = skip; k < count; k ++){
+        x = x0 + step * (k - skip);
+        qreal ny = storedY(y[k]);
+
+        putExtremum(i, ny, cnt + static_cast<int>(k - skip) >= sz);
+
+        writeSample(i, x, ny, step);
+        i = incIndex(i);
+
+        if(ny > top) top = ny;
+        if(ny < bottom) bottom = ny;
+    }
+
+    cnt = static_cast<int>(std::min(static_cast<size_t>(cnt) + (count - skip), static_cast<size_t>(sz)));
+
+    m_d->index = i;
+    m_d->count = cnt;
+
+    qreal left = sampleX((cnt < sz) ? 0 : i);
+    qreal right = sampleX(decIndex(i));
+
+    bounds.setCoords(left, bottom, right, top);
+
+    if(overwrite){
+        updateVerticalBounds();
+    }
+}
+
 const QRectF& SequentialBuffer::boundingRect() const
 {
     return m_d->boundingRect;
 }
 
-const QPointF& SequentialBuffer::get(size_t i) const
+bool SequentialBuffer::extremums(size_t from, size_t to, size_t* minIndex, size_t* maxIndex) const
 {
-    static const QPointF zero_point = QPointF();
+    if(from >= to || to > static_cast<size_t>(m_d->count)) return false;
+
+    int sz = m_d->size;
+    int len = static_cast<int>(to - from);
+    int top = m_d->lod.size();
+    int blockSize = 1;
+    for(int l = 0; l < top; l ++) blockSize *= SEQ_BUF_LOD_FANOUT;
+
+    int minI = -1;
+    int maxI = -1;
+
+    // Диапазон в массиве может разделиться на два.
+    int a = transIndex(static_cast<int>(from), m_d->index);
+    int b = std::min(a + len, sz);
+    lodExtremums(top, blockSize, a, b, &minI, &maxI);
+    if(b - a < len){
+        lodExtremums(top, blockSize, 0, len - (b - a), &minI, &maxI);
+    }
+
+    // Обратно в порядковые индексы.
+    if(m_d->addrMode == CIRCULAR && m_d->count == sz){
+        minI -= m_d->index;
+        if(minI < 0) minI += sz;
+        maxI -= m_d->index;
+        if(maxI < 0) maxI += sz;
+    }
 
-    if(i >= static_cast<size_t>(m_d->samples.size())) return zero_point;
+    if(minIndex) *minIndex = static_cast<size_t>(minI);
+    if(maxIndex) *maxIndex = static_cast<size_t>(maxI);
 
-    return m_d->samples[transIndex(static_cast<int>(i), m_d->index)];
+    return true;
 }
 
-QPointF SequentialBuffer::get(size_t i)
+QPointF SequentialBuffer::get(size_t i) const
 {
-    if(i >= static_cast<size_t>(m_d->samples.size())) return QPointF();
+    if(i >= static_cast<size_t>(m_d->size)) return QPointF();
 
-    return m_d->samples[transIndex(static_cast<int>(i), m_d->index)];
+    int si = transIndex(static_cast<int>(i), m_d->index);
+
+    if(m_d->storage == POINTS) return m_d->samples[si];
+
+    // Компактные точки вне окна не определены.
+    if(i >= static_cast<size_t>(m_d->count)) return QPointF();
+
+    return QPointF(sampleX(si), sampleY(si));
 }
 
 void SequentialBuffer::putAndUpd(const qreal& new_y, const qreal& new_dx)
@@ -132,13 +282,16 @@ void SequentialBuffer::putAndUpd(const qreal& new_y, const qreal& new_dx)
     int i = m_d->index;
     int cnt = m_d->count;
 
-    QVector<QPointF>& m_samples = m_d->samples;
     QRectF& bounds = m_d->boundingRect;
 
+    qreal dx = (new_dx < 0) ? m_d->period : new_dx;
+    qreal y = storedY(new_y);
+
     if(cnt == 0){
-        QPointF p = QPointF(m_d->startTime, new_y);
+        QPointF p = QPointF(m_d->startTime, y);
 
-        m_samples[i] = p;
+        putExtremum(i, y, false);
+        writeSample(i, p.x(), y, dx);
 
         m_d->index = incIndex(i);
         m_d->count = incCount(cnt);
@@ -148,7 +301,7 @@ void SequentialBuffer::putAndUpd(const qreal& new_y, const qreal& new_dx)
         return;
     }
 
-    int sz = m_samples.size();
+    int sz = m_d->size;
 
     // Координаты границы.
     qreal left = bounds.left();
@@ -157,11 +310,7 @@ void SequentialBuffer::putAndUpd(const qreal& new_y, const qreal& new_dx)
     qreal bottom = bounds.top();
 
     // Координаты добавляемой точки.
-    qreal dx = (new_dx < 0) ? m_d->period : new_dx;
-    qreal x = right + dx;
-    qreal y = new_y;
-    // Добавляемая точка.
-    QPointF p(x, y);
+    qreal x = m_d->lastX + dx;
 
     // Проверка новой точки по оси Y.
     if(y > top) top = y;
@@ -170,13 +319,15 @@ void SequentialBuffer::putAndUpd(const qreal& new_y, const qreal& new_dx)
     // Массив не заполнен.
     if(cnt < sz){
         //left = left;
-        right = x;
 
-        m_samples[i] = p;
+        putExtremum(i, y, false);
+        writeSample(i, x, y, dx);
 
         m_d->index = incIndex(i);
         m_d->count = incCount(cnt);
 
+        right = sampleX(i);
+
         // Обновим границу.
         bounds.setCoords(left, bottom, right, top);
         return;
@@ -193,17 +344,15 @@ void SequentialBuffer::putAndUpd(const qreal& new_y, const qreal& new_dx)
 //    }
 
     // Добавим точку.
-    m_samples[i] = p;
+    putExtremum(i, y, true);
+    writeSample(i, x, y, dx);
 
     m_d->index = incIndex(i);
     m_d->count = incCount(cnt);
 
-    // Первая точка.
-    QPointF& first_p = m_samples[m_d->index];
-
-    // Новые границы по горизонтали.
-    left = first_p.x();
-    right = p.x();
+    // Новые границы по горизонтали, первая и добавленная точки.
+    left = sampleX(m_d->index);
+    right = sampleX(i);
 
     // Обновим границу.
     bounds.setCoords(left, bottom, right, top);
@@ -221,7 +370,7 @@ int SequentialBuffer::transIndex(int i, int ref_i) const
 {
     if(m_d->addrMode == LINEAR) return i;
 
-    int sz = m_d->samples.size();
+    int sz = m_d->size;
 
     if(m_d->count < sz) return i;
 
@@ -233,7 +382,7 @@ int SequentialBuffer::transIndex(int i, int ref_i) const
 
 int SequentialBuffer::decIndex(int i) const
 {
-    int sz = m_d->samples.size();
+    int sz = m_d->size;
 
     int ri = i - 1;
     if(ri < 0) ri += sz;
@@ -243,7 +392,7 @@ int SequentialBuffer::decIndex(int i) const
 
 int SequentialBuffer::incIndex(int i) const
 {
-    int sz = m_d->samples.size();
+    int sz = m_d->size;
 
     int ri = i + 1;
     if(ri >= sz) ri -= sz;
@@ -253,7 +402,7 @@ int SequentialBuffer::incIndex(int i) const
 
 int SequentialBuffer::incCount(int cnt) const
 {
-    int sz = m_d->samples.size();
+    int sz = m_d->size;
 
     if(cnt < sz) return cnt + 1;
     return sz;
@@ -267,28 +416,35 @@ int SequentialBuffer::decCount(int cnt) const
 
 void SequentialBuffer::updateVerticalBounds() const
 {
-    const QVector<QPointF>& m_samples = m_d->samples;
     QRectF& bounds = m_d->boundingRect;
 
-    if(m_samples.isEmpty()){
+    if(m_d->size == 0 || m_d->count == 0){
         bounds = QRectF(0, 0, -1, -1);
         return;
     }
 
-    int cnt = m_d->count;
-    const QPointF& p_first = m_samples.first();
-
     qreal left = bounds.left();
     qreal right = bounds.right();
-    qreal top = p_first.y();
-    qreal bottom = p_first.y();
-
-    for(int i = 1; i < cnt; i ++){
-        const QPointF& p = m_samples[i];
-        qreal y = p.y();
-
-        top = std::max(top, y);
-        bottom = std::min(bottom, y);
+    qreal top;
+    qreal bottom;
+
+    if(m_d->storage == COMPACT){
+        // Крайняя точка перезаписана - поиск по блокам пирамиды экстремумов.
+        if(m_d->minIndex < 0 || m_d->maxIndex < 0){
+            size_t minI = 0;
+            size_t maxI = 0;
+            extremums(0, static_cast<size_t>(m_d->count), &minI, &maxI);
+
+            m_d->minIndex = transIndex(static_cast<int>(minI), m_d->index);
+            m_d->maxIndex = transIndex(static_cast<int>(maxI), m_d->index);
+        }
+
+        top = sampleY(m_d->maxIndex);
+        bottom = sampleY(m_d->minIndex);
+    }else{
+        // Крайние точки окна - в начале очередей.
+        top = sampleY(m_d->maxDeque.front());
+        bottom = sampleY(m_d->minDeque.front());
     }
 
 #if defined(SEQ_BUF_TOP_SCALE)
@@ -298,17 +454,243 @@ void SequentialBuffer::updateVerticalBounds() const
     bounds.setCoords(left, bottom, right, top);
 }
 
+void SequentialBuffer::putExtremum(int i, const qreal& y, bool overwrite)
+{
+    if(m_d->storage == COMPACT){
+        int& minI = m_d->minIndex;
+        int& maxI = m_d->maxIndex;
+
+        // Индексы неизвестны до поиска в updateVerticalBounds().
+        if(minI < 0 || maxI < 0) return;
+
+        if(overwrite && (i == minI || i == maxI)){
+            minI = -1;
+            maxI = -1;
+            return;
+        }
+
+        if(y <= sampleY(minI)) minI = i;
+        if(y >= sampleY(maxI)) maxI = i;
+        return;
+    }
+
+    IndexDeque& minDeque = m_d->minDeque;
+    IndexDeque& maxDeque = m_d->maxDeque;
+
+    // Перезаписываемая точка - самая старая в окне.
+    if(overwrite){
+        if(!minDeque.isEmpty() && minDeque.front() == i) minDeque.popFront();
+        if(!maxDeque.isEmpty() && maxDeque.front() == i) maxDeque.popFront();
+    }
+
+    while(!minDeque.isEmpty() && sampleY(minDeque.back()) >= y) minDeque.popBack();
+    minDeque.pushBack(i);
+
+    while(!maxDeque.isEmpty() && sampleY(maxDeque.back()) <= y) maxDeque.popBack();
+    maxDeque.pushBack(i);
+}
+
+qreal SequentialBuffer::storedY(const qreal& y) const
+{
+    if(m_d->storage == COMPACT) return static_cast<float>(y);
+
+    return y;
+}
+
+qreal SequentialBuffer::sampleX(int i) const
+{
+    if(m_d->storage == POINTS) return m_d->samples[i].x();
+
+    const QVector<TimeAnchor>& anchors = m_d->anchors;
+    if(m_d->anchorsHead >= anchors.size()) return 0.0;
+
+    // Номер точки по расстоянию до следующей записываемой.
+    int d = m_d->index - i;
+    if(d <= 0) d += m_d->size;
+    quint64 seq = m_d->written - static_cast<quint64>(d);
+
+    // Последняя метка не позже точки.
+    auto it = std::upper_bound(anchors.begin() + m_d->anchorsHead, anchors.end(), seq,
+                               [](quint64 s, const TimeAnchor& a){ return s < a.seq; });
+    if(it != anchors.begin() + m_d->anchorsHead) -- it;
+    if(it->seq > seq) return it->x;
+
+    return it->x + static_cast<qreal>(seq - it->seq) * it->step;
+}
+
+qreal SequentialBuffer::sampleY(int i) const
+{
+    if(m_d->storage == POINTS) return m_d->samples[i].y();
+
+    return m_d->values[i];
+}
+
+void SequentialBuffer::writeSample(int i, const qreal& x, const qreal& y, const qreal& dx)
+{
+    if(m_d->storage == POINTS){
+        m_d->samples[i] = QPointF(x, y);
+    }else{
+        m_d->values[i] = static_cast<float>(y);
+        putTime(x, dx);
+    }
+
+    putLod(i);
+
+    m_d->written ++;
+    m_d->lastX = x;
+}
+
+void SequentialBuffer::putTime(const qreal& x, const qreal& dx)
+{
+    QVector<TimeAnchor>& anchors = m_d->anchors;
+    quint64 seq = m_d->written;
+
+    // Шаг, близкий к периоду, считается периодом.
+    qreal step = dx;
+    if(qAbs(dx - m_d->period) <= m_d->period * SEQ_BUF_X_TOLERANCE) step = m_d->period;
+
+    if(m_d->anchorsHead >= anchors.size()){
+        anchors.append({seq, x, step});
+        return;
+    }
+
+    const TimeAnchor& last = anchors.last();
+    qreal predicted = last.x + static_cast<qreal>(seq - last.seq) * last.step;
+
+    // Метка добавляется, если X отклонился от расчётного.
+    if(qAbs(x - predicted) > qAbs(last.step) * SEQ_BUF_X_TOLERANCE){
+        anchors.append({seq, x, step});
+    }
+
+    // Метки до самой старой точки окна, кроме последней из них, не нужны.
+    quint64 oldest = seq + 1 - std::min(seq + 1, static_cast<quint64>(m_d->size));
+    int head = m_d->anchorsHead;
+    while(head + 1 < anchors.size() && anchors[head + 1].seq <= oldest) head ++;
+
+    if(head >= SEQ_BUF_ANCHORS_PURGE && head * 2 >= anchors.size()){
+        anchors.remove(0, head);
+        head = 0;
+    }
+
+    m_d->anchorsHead = head;
+}
+
+void SequentialBuffer::resizeLod()
+{
+    QVector<QVector<Extremum>>& lod = m_d->lod;
+
+    lod.clear();
+
+    int sz = m_d->size;
+    if(sz == 0) return;
+
+    // Уровни до числа блоков не более FANOUT.
+    for(int blockSize = SEQ_BUF_LOD_FANOUT;; blockSize *= SEQ_BUF_LOD_FANOUT){
+        int blocks = (sz + blockSize - 1) / blockSize;
+        lod.append(QVector<Extremum>(blocks, {0, 0}));
+        if(blocks <= SEQ_BUF_LOD_FANOUT) break;
+    }
+}
+
+void SequentialBuffer::putLod(int i)
+{
+    QVector<QVector<Extremum>>& lod = m_d->lod;
+
+    int sz = m_d->size;
+    int blockSize = SEQ_BUF_LOD_FANOUT;
+
+    for(int l = 0; l < lod.size(); l ++, blockSize *= SEQ_BUF_LOD_FANOUT){
+        int block = i / blockSize;
+        int begin = block * blockSize;
+        int end = std::min(begin + blockSize, sz);
+
+        // Блок ещё не заполнен, блоки выше - тоже.
+        if(i != end - 1) break;
+
+        int minI = -1;
+        int maxI = -1;
+
+        if(l == 0){
+            for(int k = begin; k < end; k ++) putLodExtremum(k, &minI, &maxI);
+        }else{
+            const QVector<Extremum>& lower = lod[l - 1];
+            int first = block * SEQ_BUF_LOD_FANOUT;
+            int last = std::min(first + SEQ_BUF_LOD_FANOUT, lower.size());
+            for(int k = first; k < last; k ++){
+                putLodExtremum(lower[k].min, &minI, &maxI);
+                putLodExtremum(lower[k].max, &minI, &maxI);
+            }
+        }
+
+        lod[l][block] = {minI, maxI};
+    }
+}
+
+bool SequentialBuffer::lodBlockValid(int blockSize, int block) const
+{
+    int begin = block * blockSize;
+    int end = std::min(begin + blockSize, m_d->size);
+
+    // Блок, в который идёт запись, содержит точки разных проходов.
+    int w = m_d->index;
+
+    return !(begin < w && w < end);
+}
+
+void SequentialBuffer::lodExtremums(int level, int blockSize, int from, int to, int* minI, int* maxI) const
+{
+    if(from >= to) return;
+
+    if(level == 0){
+        for(int k = from; k < to; k ++) putLodExtremum(k, minI, maxI);
+        return;
+    }
+
+    const QVector<Extremum>& blocks = m_d->lod[level - 1];
+    int lowerSize = blockSize / SEQ_BUF_LOD_FANOUT;
+
+    // Целые блоки внутри диапазона.
+    int first = (from + blockSize - 1) / blockSize;
+    int last = to / blockSize;
+    if(to == m_d->size) last = blocks.size();
+
+    if(first >= last){
+        lodExtremums(level - 1, lowerSize, from, to, minI, maxI);
+        return;
+    }
+
+    lodExtremums(level - 1, lowerSize, from, first * blockSize, minI, maxI);
+
+    for(int k = first; k < last; k ++){
+        if(lodBlockValid(blockSize, k)){
+            putLodExtremum(blocks[k].min, minI, maxI);
+            putLodExtremum(blocks[k].max, minI, maxI);
+        }else{
+            lodExtremums(level - 1, lowerSize, k * blockSize, std::min((k + 1) * blockSize, to), minI, maxI);
+        }
+    }
+
+    lodExtremums(level - 1, lowerSize, std::min(last * blockSize, to), to, minI, maxI);
+}
+
+void SequentialBuffer::putLodExtremum(int i, int* minI, int* maxI) const
+{
+    qreal y = sampleY(i);
+
+    if(*minI < 0 || y < sampleY(*minI)) *minI = i;
+    if(*maxI < 0 || y > sampleY(*maxI)) *maxI = i;
+}
+
 void SequentialBuffer::recalBounds()
 {
-    const QVector<QPointF>& m_samples = m_d->samples;
+    int cnt = m_d->count;
 
-    if(m_samples.isEmpty()){
+    if(cnt == 0){
         m_d->boundingRect = QRectF(0, 0, -1, -1);
         return;
     }
 
-    int cnt = m_d->count;
-    const QPointF& p_first = m_samples.first();
+    QPointF p_first = get(0);
 
     if(cnt == 1){
         m_d->boundingRect = QRectF(p_first, p_first);
@@ -321,7 +703,7 @@ void SequentialBuffer::recalBounds()
     qreal top = bottom;
 
     for(int i = 1; i < cnt; i ++){
-        const QPointF& p = m_samples[i];
+        QPointF p = get(static_cast<size_t>(i));
         qreal x = p.x();
         qreal y = p.y();
 
@@ -338,3 +720,58 @@ void SequentialBuffer::recalBounds()
     m_d->boundingRect.setCoords(left, top, right, bottom);
 }
 
+
+SequentialBuffer::IndexDeque::IndexDeque()
+{
+    m_head = 0;
+    m_count = 0;
+}
+
+void SequentialBuffer::IndexDeque::reset(int capacity)
+{
+    if(m_items.size() != capacity){
+        m_items.resize(capacity);
+        m_items.squeeze();
+    }
+    m_head = 0;
+    m_count = 0;
+}
+
+bool SequentialBuffer::IndexDeque::isEmpty() const
+{
+    return m_count == 0;
+}
+
+int SequentialBuffer::IndexDeque::front() const
+{
+    return m_items[m_head];
+}
+
+int SequentialBuffer::IndexDeque::back() const
+{
+    int i = m_head + m_count - 1;
+    if(i >= m_items.size()) i -= m_items.size();
+
+    return m_items[i];
+}
+
+void SequentialBuffer::IndexDeque::popFront()
+{
+    m_head ++;
+    if(m_head >= m_items.size()) m_head = 0;
+    m_count --;
+}
+
+void SequentialBuffer::IndexDeque::popBack()
+{
+    m_count --;
+}
+
+void SequentialBuffer::IndexDeque::pushBack(int i)
+{
+    int n = m_head + m_count;
+    if(n >= m_items.size()) n -= m_items.size();
+
+    m_items[n] = i;
+    m_count ++;
+}
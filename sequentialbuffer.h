@@ -18,6 +18,15 @@ public:
         LINEAR = 1
     };
 
+    // Способ хранения точек.
+    enum StorageMode {
+        // X и Y каждой точки, около 24.5 байт с очередями экстремумов.
+        POINTS = 0,
+        // Y во float, X по периоду и редким меткам времени,
+        // около 4.5 байт с пирамидой экстремумов.
+        COMPACT = 1
+    };
+
     SequentialBuffer();
     SequentialBuffer(const SequentialBuffer& sb);
     SequentialBuffer(SequentialBuffer&& sb);
@@ -26,6 +35,10 @@ public:
     AddressingMode addressingMode() const;
     void setAddressingMode(AddressingMode newMode);
 
+    // Смена способа хранения очищает буфер.
+    StorageMode storageMode() const;
+    void setStorageMode(StorageMode newMode);
+
     size_t size() const;
     void setSize(size_t newSize);
 
@@ -42,31 +55,105 @@ public:
 
     // Число семплов, записанных в буфер.
     size_t avail() const;
+    // Число точек, записанных после сброса.
+    quint64 written() const;
 
-    const QPointF& get(size_t i) const;
-    QPointF get(size_t i);
+    QPointF get(size_t i) const;
     // отрицательно приращение x
     // использует установленный период дискретизации.
     void put(const qreal& y, const qreal& dx = -1);
+    // Добавляет массив точек с шагом dx,
+    // границы пересчитываются один раз.
+    void put(const qreal* y, size_t count, const qreal& dx = -1);
 
     const QRectF& boundingRect() const;
 
+    // Индексы точек с минимальным и максимальным Y среди точек [from, to).
+    // Использует пирамиду экстремумов блоков, время не зависит от размера диапазона.
+    bool extremums(size_t from, size_t to, size_t* minIndex, size_t* maxIndex) const;
+
 private:
 
+    // Монотонная очередь индексов точек (кольцевая)
+    // для поиска минимума и максимума в окне за O(1).
+    class IndexDeque {
+    public:
+        IndexDeque();
+
+        void reset(int capacity);
+        bool isEmpty() const;
+        int front() const;
+        int back() const;
+        void popFront();
+        void popBack();
+        void pushBack(int i);
+
+    private:
+        QVector<int> m_items;
+        int m_head;
+        int m_count;
+    };
+
+    // Метка времени: X точки с номером seq,
+    // X следующих точек отсчитывается с шагом step.
+    struct TimeAnchor {
+        quint64 seq;
+        qreal x;
+        qreal step;
+    };
+
+    // Индексы точек с минимальным и максимальным Y в блоке.
+    struct Extremum {
+        int min;
+        int max;
+    };
+
     class Data {
     public:
+        StorageMode storage;
+        int size;
+        // POINTS.
         QVector<QPointF> samples;
+        // COMPACT.
+        QVector<float> values;
+        QVector<TimeAnchor> anchors;
+        int anchorsHead;
+        // Число записанных точек (номер следующей точки).
+        quint64 written;
+        // X последней точки без округления.
+        qreal lastX;
         int index;
         int count;
         qreal period;
         qreal startTime;
         AddressingMode addrMode;
         QRectF boundingRect;
+        // Индексы точек с возрастающими и убывающими Y (только POINTS).
+        IndexDeque minDeque;
+        IndexDeque maxDeque;
+        // Индексы точек с минимальным и максимальным Y (только COMPACT),
+        // -1 - ищутся по пирамиде экстремумов.
+        int minIndex;
+        int maxIndex;
+        // Пирамида экстремумов блоков, lod[l] - блоки по FANOUT^(l+1) точек.
+        // Блок обновляется при записи его последней точки.
+        QVector<QVector<Extremum>> lod;
     };
 
     Data* m_d;
 
     void putAndUpd(const qreal& new_y, const qreal& new_dx);
+    void putExtremum(int i, const qreal& y, bool overwrite);
+    qreal storedY(const qreal& y) const;
+    qreal sampleX(int i) const;
+    qreal sampleY(int i) const;
+    void writeSample(int i, const qreal& x, const qreal& y, const qreal& dx);
+    void putTime(const qreal& x, const qreal& dx);
+    void resizeLod();
+    void putLod(int i);
+    bool lodBlockValid(int blockSize, int block) const;
+    void lodExtremums(int level, int blockSize, int from, int to, int* minI, int* maxI) const;
+    void putLodExtremum(int i, int* minI, int* maxI) const;
     int transIndex(int i, int ref_i) const;
     int decIndex(int i) const;
     int incIndex(int i) const;
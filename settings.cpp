@@ -22,6 +22,8 @@ bool Settings::save() const
     savePort(s);
     saveCo(s);
     saveAppear(s);
+    savePdos(s, "tpdo", tpdo);
+    savePdos(s, "rpdo", rpdo);
 
     return s.status() == QSettings::NoError;
 }
@@ -34,6 +36,8 @@ bool Settings::load()
     loadPort(s);
     loadCo(s);
     loadAppear(s);
+    loadPdos(s, "tpdo", tpdo);
+    loadPdos(s, "rpdo", rpdo);
 
     return s.status() == QSettings::NoError;
 }
@@ -58,6 +62,9 @@ void Settings::savePort(QSettings& s) const
     s.setValue("chinaAdapter", conn.chinaAdapter);
     s.setValue("canBitrate",   conn.canBitrate);
     s.setValue("processInterval",   conn.processInterval);
+    s.setValue("listenOnly",   conn.listenOnly);
+    s.setValue("busLoadTarget",    conn.busLoadTarget);
+    s.setValue("serialLoadTarget", conn.serialLoadTarget);
 
     s.endGroup();
 }
@@ -71,11 +78,15 @@ void Settings::saveCo(QSettings& s) const
     s.setValue("cobidCliToSrv",       co.cobidCliToSrv);
     s.setValue("cobidSrvToCli",       co.cobidSrvToCli);
     s.setValue("useSdoBlockTransfer", co.useSdoBlockTransfer);
+    s.setValue("useSdoCache",         co.useSdoCache);
     s.setValue("cliTimeout",          co.cliTimeout);
     s.setValue("srvTimeout",          co.srvTimeout);
     s.setValue("sdoTimeout",          co.sdoTimeout);
     s.setValue("hbFirstTime",         co.hbFirstTime);
     s.setValue("hbPeriod",            co.hbPeriod);
+    s.setValue("syncPeriod",          co.syncPeriod);
+    s.setValue("syncCntOverflow",     co.syncCntOverflow);
+    s.setValue("hbConsTime",          co.hbConsTime);
 
     s.endGroup();
 }
@@ -89,6 +100,38 @@ void Settings::saveAppear(QSettings& s) const
     s.endGroup();
 }
 
+void Settings::savePdos(QSettings& s, const QString& name, const QVector<Pdo>& pdos) const
+{
+    s.beginWriteArray(name, pdos.size());
+
+    for(int i = 0; i < pdos.size(); i ++){
+        const Pdo& pdo = pdos[i];
+
+        s.setArrayIndex(i);
+
+        s.setValue("num",         pdo.num);
+        s.setValue("cobid",       pdo.cobid);
+        s.setValue("transType",   pdo.transType);
+        s.setValue("inhibitTime", pdo.inhibitTime);
+        s.setValue("eventTimer",  pdo.eventTimer);
+
+        s.beginWriteArray("mapping", pdo.mapping.size());
+        for(int j = 0; j < pdo.mapping.size(); j ++){
+            const PdoMapping& m = pdo.mapping[j];
+
+            s.setArrayIndex(j);
+
+            s.setValue("nodeId",   static_cast<uint>(m.nodeId));
+            s.setValue("index",    static_cast<uint>(m.index));
+            s.setValue("subIndex", static_cast<uint>(m.subIndex));
+            s.setValue("dataSize", m.dataSize);
+        }
+        s.endArray();
+    }
+
+    s.endArray();
+}
+
 void Settings::loadGeneral(QSettings& s)
 {
     s.beginGroup("common");
@@ -109,6 +152,9 @@ void Settings::loadPort(QSettings& s)
     conn.chinaAdapter = s.value("chinaAdapter", true).toBool();
     conn.canBitrate   = s.value("canBitrate", 125000).toUInt();
     conn.processInterval   = s.value("processInterval", 0).toUInt();
+    conn.listenOnly   = s.value("listenOnly", false).toBool();
+    conn.busLoadTarget    = s.value("busLoadTarget", 80).toUInt();
+    conn.serialLoadTarget = s.value("serialLoadTarget", 80).toUInt();
 
     s.endGroup();
 }
@@ -122,11 +168,15 @@ void Settings::loadCo(QSettings& s)
     co.cobidCliToSrv =       s.value("cobidCliToSrv",       0x600).toUInt();
     co.cobidSrvToCli =       s.value("cobidSrvToCli",       0x580).toUInt();
     co.useSdoBlockTransfer = s.value("useSdoBlockTransfer", true).toBool();
+    co.useSdoCache =         s.value("useSdoCache",         false).toBool();
     co.cliTimeout =          s.value("cliTimeout",          500).toUInt();
     co.srvTimeout =          s.value("srvTimeout",          500).toUInt();
     co.sdoTimeout =          s.value("sdoTimeout",          1000).toUInt();
     co.hbFirstTime =         s.value("hbFirstTime",         0).toUInt();
     co.hbPeriod =            s.value("hbPeriod",            0).toUInt();
+    co.syncPeriod =          s.value("syncPeriod",          0).toUInt();
+    co.syncCntOverflow =     s.value("syncCntOverflow",     0).toUInt();
+    co.hbConsTime =          s.value("hbConsTime",          0).toUInt();
 
     s.endGroup();
 }
@@ -139,3 +189,41 @@ void Settings::loadAppear(QSettings& s)
 
     s.endGroup();
 }
+
+void Settings::loadPdos(QSettings& s, const QString& name, QVector<Pdo>& pdos)
+{
+    pdos.clear();
+
+    int size = s.beginReadArray(name);
+
+    for(int i = 0; i < size; i ++){
+        Pdo pdo;
+
+        s.setArrayIndex(i);
+
+        pdo.num =         s.value("num",         i).toUInt();
+        pdo.cobid =       s.value("cobid",       0).toUInt();
+        pdo.transType =   s.value("transType",   254).toUInt();
+        pdo.inhibitTime = s.value("inhibitTime", 0).toUInt();
+        pdo.eventTimer =  s.value("eventTimer",  0).toUInt();
+
+        int mapSize = s.beginReadArray("mapping");
+        for(int j = 0; j < mapSize; j ++){
+            PdoMapping m;
+
+            s.setArrayIndex(j);
+
+            m.nodeId =   static_cast<CO::NodeId>(s.value("nodeId", 0).toUInt());
+            m.index =    static_cast<CO::Index>(s.value("index", 0).toUInt());
+            m.subIndex = static_cast<CO::SubIndex>(s.value("subIndex", 0).toUInt());
+            m.dataSize = s.value("dataSize", 0).toUInt();
+
+            pdo.mapping.append(m);
+        }
+        s.endArray();
+
+        pdos.append(pdo);
+    }
+
+    s.endArray();
+}
@@ -5,6 +5,7 @@
 #include <QString>
 #include <QColor>
 #include <QSerialPort>
+#include <QVector>
 #include "cotypes.h"
 #include "covaluetypes.h"
 
@@ -31,6 +32,10 @@ public:
         bool chinaAdapter;
         uint canBitrate;
         uint processInterval;
+        bool listenOnly;
+        // polling budget, % of the bus & serial link, 0 - unlimited.
+        uint busLoadTarget;
+        uint serialLoadTarget;
     } conn;
 
     struct CANopen {
@@ -39,17 +44,43 @@ public:
         uint cobidCliToSrv;
         uint cobidSrvToCli;
         bool useSdoBlockTransfer;
+        // cache of the static objects uploads.
+        bool useSdoCache;
         uint cliTimeout;
         uint srvTimeout;
         uint sdoTimeout;
         uint hbFirstTime;
         uint hbPeriod;
+        uint syncPeriod;
+        uint syncCntOverflow;
+        uint hbConsTime;
     } co;
 
     struct Appearance {
         QColor windowColor;
     } appear;
 
+    struct PdoMapping {
+        CO::NodeId nodeId;
+        CO::Index index;
+        CO::SubIndex subIndex;
+        uint dataSize;
+    };
+
+    struct Pdo {
+        uint num;
+        uint cobid;
+        uint transType;
+        uint inhibitTime;
+        uint eventTimer;
+        QVector<PdoMapping> mapping;
+    };
+
+    // TPDO setpoints.
+    QVector<Pdo> tpdo;
+    // RPDO live values.
+    QVector<Pdo> rpdo;
+
     struct SDOValuePlot {
         uint samplesCount;
         QString plotName;
@@ -86,11 +117,13 @@ private:
     void savePort(QSettings& s) const;
     void saveCo(QSettings& s) const;
     void saveAppear(QSettings& s) const;
+    void savePdos(QSettings& s, const QString& name, const QVector<Pdo>& pdos) const;
 
     void loadGeneral(QSettings& s);
     void loadPort(QSettings& s);
     void loadCo(QSettings& s);
     void loadAppear(QSettings& s);
+    void loadPdos(QSettings& s, const QString& name, QVector<Pdo>& pdos);
 };
 
 #endif // SETTINGS_H
@@ -3,6 +3,23 @@
 #include <QColorDialog>
 #include <QColor>
 #include <QSerialPortInfo>
+#include <QHeaderView>
+#include <QTableWidgetItem>
+#include <algorithm>
+
+
+enum TpdoColumn {
+    TPDO_COL_NUM = 0,
+    TPDO_COL_COBID,
+    TPDO_COL_TRANS_TYPE,
+    TPDO_COL_INHIBIT_TIME,
+    TPDO_COL_EVENT_TIMER,
+    TPDO_COL_NODE_ID,
+    TPDO_COL_INDEX,
+    TPDO_COL_SUBINDEX,
+    TPDO_COL_DATA_SIZE,
+    TPDO_COLS_COUNT
+};
 
 
 
@@ -19,6 +36,12 @@ SettingsDlg::SettingsDlg(QWidget *parent) :
     populatePortParitys();
     populatePortStopBits();
     populateCanBitrates();
+
+    ui->twTpdo->setColumnCount(TPDO_COLS_COUNT);
+    ui->twTpdo->setHorizontalHeaderLabels({tr("TPDO"), tr("COB-ID"), tr("Тип передачи"), tr("Запрет, 100 мкс"),
+                                           tr("Таймер, мс"), tr("Узел"), tr("Индекс"), tr("Подындекс"), tr("Размер")});
+    ui->twTpdo->verticalHeader()->hide();
+    ui->twTpdo->horizontalHeader()->setStretchLastSection(true);
 }
 
 SettingsDlg::~SettingsDlg()
@@ -118,6 +141,26 @@ void SettingsDlg::setProcessInterval(uint newProcessInterval)
     ui->sbProcessInterval->setValue(newProcessInterval);
 }
 
+uint SettingsDlg::busLoadTarget() const
+{
+    return ui->sbBusLoadTarget->value();
+}
+
+void SettingsDlg::setBusLoadTarget(uint newBusLoadTarget)
+{
+    ui->sbBusLoadTarget->setValue(newBusLoadTarget);
+}
+
+uint SettingsDlg::serialLoadTarget() const
+{
+    return ui->sbSerialLoadTarget->value();
+}
+
+void SettingsDlg::setSerialLoadTarget(uint newSerialLoadTarget)
+{
+    ui->sbSerialLoadTarget->setValue(newSerialLoadTarget);
+}
+
 CO::NodeId SettingsDlg::nodeId() const
 {
     return ui->sbDevNodeId->value();
@@ -168,6 +211,16 @@ void SettingsDlg::setUseSdoBlockTransfer(bool newUseSdoBlockTransfer)
     ui->cbSdoBlockTransfer->setChecked(newUseSdoBlockTransfer);
 }
 
+bool SettingsDlg::useSdoCache() const
+{
+    return ui->cbSdoCache->isChecked();
+}
+
+void SettingsDlg::setUseSdoCache(bool newUseSdoCache)
+{
+    ui->cbSdoCache->setChecked(newUseSdoCache);
+}
+
 uint SettingsDlg::clientTimeout() const
 {
     return ui->sbCliTimeout->value();
@@ -218,6 +271,36 @@ void SettingsDlg::setHbPeriod(uint newHbPeriod)
     ui->sbHBTime->setValue(newHbPeriod);
 }
 
+uint SettingsDlg::syncPeriod() const
+{
+    return ui->sbSyncPeriod->value();
+}
+
+void SettingsDlg::setSyncPeriod(uint newSyncPeriod)
+{
+    ui->sbSyncPeriod->setValue(newSyncPeriod);
+}
+
+uint SettingsDlg::syncCntOverflow() const
+{
+    return ui->sbSyncCntOverflow->value();
+}
+
+void SettingsDlg::setSyncCntOverflow(uint newSyncCntOverflow)
+{
+    ui->sbSyncCntOverflow->setValue(newSyncCntOverflow);
+}
+
+uint SettingsDlg::hbConsTime() const
+{
+    return ui->sbHBConsTime->value();
+}
+
+void SettingsDlg::setHbConsTime(uint newHbConsTime)
+{
+    ui->sbHBConsTime->setValue(newHbConsTime);
+}
+
 QColor SettingsDlg::windowColor() const
 {
     const QPalette& pal = ui->frWindowBackColor->palette();
@@ -231,6 +314,55 @@ void SettingsDlg::setWindowColor(const QColor& newWindowColor)
     ui->frWindowBackColor->setPalette(pal);
 }
 
+QVector<Settings::Pdo> SettingsDlg::tpdos() const
+{
+    QVector<Settings::Pdo> pdos;
+
+    for(int row = 0; row < ui->twTpdo->rowCount(); row ++){
+        bool ok = true;
+        bool cellOk = false;
+
+        Settings::Pdo pdo;
+        pdo.num = tpdoCell(row, TPDO_COL_NUM, &cellOk) - 1; ok = ok && cellOk;
+        pdo.cobid = tpdoCell(row, TPDO_COL_COBID, &cellOk); ok = ok && cellOk;
+        pdo.transType = tpdoCell(row, TPDO_COL_TRANS_TYPE, &cellOk); ok = ok && cellOk;
+        pdo.inhibitTime = tpdoCell(row, TPDO_COL_INHIBIT_TIME, &cellOk); ok = ok && cellOk;
+        pdo.eventTimer = tpdoCell(row, TPDO_COL_EVENT_TIMER, &cellOk); ok = ok && cellOk;
+
+        Settings::PdoMapping m;
+        m.nodeId = static_cast<CO::NodeId>(tpdoCell(row, TPDO_COL_NODE_ID, &cellOk)); ok = ok && cellOk;
+        m.index = static_cast<CO::Index>(tpdoCell(row, TPDO_COL_INDEX, &cellOk)); ok = ok && cellOk;
+        m.subIndex = static_cast<CO::SubIndex>(tpdoCell(row, TPDO_COL_SUBINDEX, &cellOk)); ok = ok && cellOk;
+        m.dataSize = tpdoCell(row, TPDO_COL_DATA_SIZE, &cellOk); ok = ok && cellOk;
+
+        // TPDO numbers are shown from 1, the data fits the frame.
+        if(!ok || pdo.num > 0xff || m.dataSize == 0 || m.dataSize > 8) continue;
+
+        auto it = std::find_if(pdos.begin(), pdos.end(), [&pdo](const Settings::Pdo& p){ return p.num == pdo.num; });
+        if(it == pdos.end()){
+            pdos.append(pdo);
+            it = pdos.end() - 1;
+        }
+
+        it->mapping.append(m);
+    }
+
+    return pdos;
+}
+
+void SettingsDlg::setTpdos(const QVector<Settings::Pdo>& newTpdos)
+{
+    ui->twTpdo->setRowCount(0);
+
+    for(const auto& pdo: newTpdos){
+        for(const auto& m: pdo.mapping){
+            int row = ui->twTpdo->rowCount();
+            ui->twTpdo->insertRow(row);
+            setTpdoRow(row, pdo, m);
+        }
+    }
+}
+
 void SettingsDlg::on_tbWindowBackColorSel_clicked(bool checked)
 {
     Q_UNUSED(checked)
@@ -238,6 +370,40 @@ void SettingsDlg::on_tbWindowBackColorSel_clicked(bool checked)
     peekColor(ui->frWindowBackColor);
 }
 
+void SettingsDlg::on_tbTpdoAdd_clicked(bool checked)
+{
+    Q_UNUSED(checked)
+
+    // the RPDO1 of the device by default.
+    Settings::Pdo pdo;
+    pdo.num = 0;
+    pdo.cobid = 0x200 + nodeId();
+    pdo.transType = 254;
+    pdo.inhibitTime = 0;
+    pdo.eventTimer = 0;
+
+    Settings::PdoMapping m;
+    m.nodeId = nodeId();
+    m.index = 0x2000;
+    m.subIndex = 0;
+    m.dataSize = 2;
+
+    int row = ui->twTpdo->rowCount();
+    ui->twTpdo->insertRow(row);
+    setTpdoRow(row, pdo, m);
+    ui->twTpdo->setCurrentCell(row, TPDO_COL_INDEX);
+}
+
+void SettingsDlg::on_tbTpdoDel_clicked(bool checked)
+{
+    Q_UNUSED(checked)
+
+    int row = ui->twTpdo->currentRow();
+    if(row < 0) return;
+
+    ui->twTpdo->removeRow(row);
+}
+
 void SettingsDlg::peekColor(QWidget* colHolder)
 {
     QPalette pal = colHolder->palette();
@@ -300,3 +466,34 @@ void SettingsDlg::populateCanBitrates()
         ui->cbCanBitrate->addItem(tr("%1 кбит/с").arg(bitrate), bitrate);
     }
 }
+
+void SettingsDlg::setTpdoRow(int row, const Settings::Pdo& pdo, const Settings::PdoMapping& mapping)
+{
+    const QString cells[TPDO_COLS_COUNT] = {
+        QString::number(pdo.num + 1),
+        QString("0x%1").arg(pdo.cobid, 3, 16, QChar('0')),
+        QString::number(pdo.transType),
+        QString::number(pdo.inhibitTime),
+        QString::number(pdo.eventTimer),
+        QString::number(mapping.nodeId),
+        QString("0x%1").arg(mapping.index, 4, 16, QChar('0')),
+        QString::number(mapping.subIndex),
+        QString::number(mapping.dataSize)
+    };
+
+    for(int col = 0; col < TPDO_COLS_COUNT; col ++){
+        ui->twTpdo->setItem(row, col, new QTableWidgetItem(cells[col]));
+    }
+}
+
+uint SettingsDlg::tpdoCell(int row, int col, bool* ok) const
+{
+    QTableWidgetItem* item = ui->twTpdo->item(row, col);
+    if(item == nullptr){
+        *ok = false;
+        return 0;
+    }
+
+    // decimal or 0x hex.
+    return item->text().trimmed().toUInt(ok, 0);
+}
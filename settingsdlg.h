@@ -4,6 +4,7 @@
 #include <QDialog>
 #include <QSerialPort>
 #include "cotypes.h"
+#include "settings.h"
 
 
 namespace Ui {
@@ -42,6 +43,12 @@ public:
     uint processInterval() const;
     void setProcessInterval(uint newProcessInterval);
 
+    uint busLoadTarget() const;
+    void setBusLoadTarget(uint newBusLoadTarget);
+
+    uint serialLoadTarget() const;
+    void setSerialLoadTarget(uint newSerialLoadTarget);
+
     CO::NodeId nodeId() const;
     void setNodeId(CO::NodeId newNodeId);
 
@@ -57,6 +64,9 @@ public:
     bool useSdoBlockTransfer() const;
     void setUseSdoBlockTransfer(bool newUseSdoBlockTransfer);
 
+    bool useSdoCache() const;
+    void setUseSdoCache(bool newUseSdoCache);
+
     uint clientTimeout() const;
     void setClientTimeout(uint newClientTimeout);
 
@@ -72,11 +82,27 @@ public:
     uint hbPeriod() const;
     void setHbPeriod(uint newHbPeriod);
 
+    uint syncPeriod() const;
+    void setSyncPeriod(uint newSyncPeriod);
+
+    uint syncCntOverflow() const;
+    void setSyncCntOverflow(uint newSyncCntOverflow);
+
+    uint hbConsTime() const;
+    void setHbConsTime(uint newHbConsTime);
+
     QColor windowColor() const;
     void setWindowColor(const QColor& newWindowColor);
 
+    // a row per mapped object, the TPDO parameters
+    // are taken from the first row of the TPDO.
+    QVector<Settings::Pdo> tpdos() const;
+    void setTpdos(const QVector<Settings::Pdo>& newTpdos);
+
 private slots:
     void on_tbWindowBackColorSel_clicked(bool checked = false);
+    void on_tbTpdoAdd_clicked(bool checked = false);
+    void on_tbTpdoDel_clicked(bool checked = false);
 
 private:
     Ui::SettingsDlg *ui;
@@ -88,6 +114,9 @@ private:
     void populatePortParitys();
     void populatePortStopBits();
     void populateCanBitrates();
+
+    void setTpdoRow(int row, const Settings::Pdo& pdo, const Settings::PdoMapping& mapping);
+    uint tpdoCell(int row, int col, bool* ok) const;
 };
 
 #endif // SETTINGSDLG_H
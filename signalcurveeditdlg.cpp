@@ -1,6 +1,7 @@
 #include "signalcurveeditdlg.h"
 #include "ui_signalcurveeditdlg.h"
 #include "covaluetypes.h"
+#include "bitfieldeditdlg.h"
 #include <QColorDialog>
 #include <QList>
 #include <QPair>
@@ -77,7 +78,45 @@ COValue::Type SignalCurveEditDlg::type() const
 
 void SignalCurveEditDlg::setType(COValue::Type newType)
 {
-    ui->cbType->setCurrentIndex(ui->cbType->findData(static_cast<int>(newType)));
+    int index = ui->cbType->findData(static_cast<int>(newType));
+
+    // bit fields are not listed.
+    if(index == -1 && COValue::isBitField(newType)){
+        ui->cbType->addItem(COValue::typeName(newType), static_cast<int>(newType));
+        index = ui->cbType->count() - 1;
+    }
+
+    ui->cbType->setCurrentIndex(index);
+}
+
+int SignalCurveEditDlg::pollPeriod() const
+{
+    return ui->sbPollPeriod->value();
+}
+
+void SignalCurveEditDlg::setPollPeriod(int newPollPeriod)
+{
+    ui->sbPollPeriod->setValue(newPollPeriod);
+}
+
+int SignalCurveEditDlg::samples() const
+{
+    return ui->sbSamples->value();
+}
+
+void SignalCurveEditDlg::setSamples(int newSamples)
+{
+    ui->sbSamples->setValue(newSamples);
+}
+
+qreal SignalCurveEditDlg::samplePeriod() const
+{
+    return ui->sbSamplePeriod->value() / 1000000;
+}
+
+void SignalCurveEditDlg::setSamplePeriod(qreal newSamplePeriod)
+{
+    ui->sbSamplePeriod->setValue(newSamplePeriod * 1000000);
 }
 
 QColor SignalCurveEditDlg::penColor() const
@@ -142,6 +181,18 @@ void SignalCurveEditDlg::setBrushStyle(Qt::BrushStyle newBrushStyle)
     ui->cbBrushStyle->setCurrentIndex(ui->cbBrushStyle->findData(static_cast<int>(newBrushStyle)));
 }
 
+void SignalCurveEditDlg::on_tbBitFieldSel_clicked(bool checked)
+{
+    Q_UNUSED(checked);
+
+    BitFieldEditDlg dlg(this);
+    dlg.setType(type());
+
+    if(dlg.exec() == QDialog::Accepted){
+        setType(dlg.type());
+    }
+}
+
 void SignalCurveEditDlg::on_tbPenColorSel_clicked(bool checked)
 {
     Q_UNUSED(checked);
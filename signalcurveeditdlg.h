@@ -37,6 +37,17 @@ public:
     COValue::Type type() const;
     void setType(COValue::Type newType);
 
+    // ms, 0 - update interval.
+    int pollPeriod() const;
+    void setPollPeriod(int newPollPeriod);
+
+    int samples() const;
+    void setSamples(int newSamples);
+
+    // s.
+    qreal samplePeriod() const;
+    void setSamplePeriod(qreal newSamplePeriod);
+
     QColor penColor() const;
     void setPenColor(const QColor& newPenColor);
 
@@ -53,6 +64,7 @@ public:
     void setBrushStyle(Qt::BrushStyle newBrushStyle);
 
 private slots:
+    void on_tbBitFieldSel_clicked(bool checked = false);
     void on_tbPenColorSel_clicked(bool checked = false);
     void on_tbBrushColorSel_clicked(bool checked = false);
 
@@ -14,6 +14,11 @@ struct SignalCurveProp
     CO::Index index;
     CO::SubIndex subIndex;
     COValue::Type type;
+    // waveform samples count (0 - single value) and sample period, s.
+    int samples;
+    qreal samplePeriod;
+    // poll period, ms (0 - update interval).
+    int pollPeriod;
     QColor penColor;
     Qt::PenStyle penStyle;
     qreal penWidth;
@@ -7,11 +7,19 @@
 #include <QwtScaleEngine>
 #include <QwtScaleWidget>
 #include <QwtPlotLegendItem>
+#include <QwtPlotDirectPainter>
+#include <QwtInterval>
 #include <QFontMetrics>
+#include <QResizeEvent>
+#include <QRegion>
+#include <algorithm>
 #include "sequentialbuffer.h"
 #include "signalseriesdata.h"
 #include <QDebug>
 
+// scale margin for the appended samples, part of the data range.
+#define SIGNAL_PLOT_SCALE_MARGIN 0.25
+
 static const Qt::GlobalColor m_colors[] = {
            Qt::yellow,
            Qt::green,
@@ -44,6 +52,10 @@ SignalPlot::SignalPlot(const QString& newName, QWidget* parent)
 
     m_legendItem = nullptr;
 
+    m_incremental = false;
+    m_compactStorage = false;
+    m_directPainter = new QwtPlotDirectPainter();
+
     setSizePolicy( QSizePolicy::Ignored, QSizePolicy::Ignored );
 
     setAutoDelete(true);
@@ -88,7 +100,7 @@ SignalPlot::SignalPlot(const QString& newName, QWidget* parent)
 
 SignalPlot::~SignalPlot()
 {
-
+    delete m_directPainter;
 }
 
 QString SignalPlot::name() const
@@ -172,6 +184,7 @@ int SignalPlot::addSignal(const QString& newName, const QColor& newColor, const
         curveBuffer->setSize(m_size);
         curveBuffer->setSamplingPeriod(1.0);
         curveBuffer->setAddressingMode(SequentialBuffer::CIRCULAR);
+        curveBuffer->setStorageMode(m_compactStorage ? SequentialBuffer::COMPACT : SequentialBuffer::POINTS);
     }else{
         if(m_size == 0) m_size = curveBuffer->size();
     }
@@ -200,7 +213,10 @@ int SignalPlot::addSignal(const QString& newName, const QColor& newColor, const
     newCurve->setPen(curvePen);
     newCurve->setBrush(curveBrush);
     newCurve->setRenderHint(QwtPlotItem::RenderAntialiased);
-    newCurve->setSamples(new SignalSeriesData(curveBuffer));
+    auto curveData = new SignalSeriesData(curveBuffer);
+    curveData->setResolution(canvas()->width());
+
+    newCurve->setSamples(curveData);
     newCurve->attach(this);
 
     return curvesCount;
@@ -413,6 +429,45 @@ void SignalPlot::setLegendItemEnabled(bool newEnabled)
     }
 }
 
+bool SignalPlot::incremental() const
+{
+    return m_incremental;
+}
+
+void SignalPlot::setIncremental(bool newIncremental)
+{
+    if(m_incremental == newIncremental) return;
+
+    m_incremental = newIncremental;
+
+    if(!m_incremental){
+        setAxisAutoScale(QwtAxis::XBottom, true);
+        setAxisAutoScale(QwtAxis::YLeft, true);
+    }
+}
+
+bool SignalPlot::compactStorage() const
+{
+    return m_compactStorage;
+}
+
+void SignalPlot::setCompactStorage(bool newCompactStorage)
+{
+    m_compactStorage = newCompactStorage;
+
+    auto items = itemList(QwtPlotItem::Rtti_PlotCurve);
+
+    for(auto& item: items){
+        auto curv = static_cast<QwtPlotCurve*>(item);
+        auto trendData = static_cast<SignalSeriesData*>(curv->data());
+        SequentialBuffer* buffer = trendData->buffer();
+        if(buffer == nullptr) continue;
+
+        buffer->setStorageMode(m_compactStorage ? SequentialBuffer::COMPACT : SequentialBuffer::POINTS);
+        trendData->resetLod();
+    }
+}
+
 void SignalPlot::putSample(int n, const qreal& newY, const qreal& newDx)
 {
     QwtPlotCurve* curv = getCurve(n);
@@ -426,6 +481,17 @@ void SignalPlot::putSample(int n, const qreal& newY, const qreal& newDx)
     trendData->putSample(newY, newDx);
 }
 
+void SignalPlot::putSamples(int n, const qreal* newY, size_t count, const qreal& newDx)
+{
+    QwtPlotCurve* curv = getCurve(n);
+
+    if(curv == nullptr) return;
+
+    auto trendData = static_cast<SignalSeriesData*>(curv->data());
+
+    trendData->putSamples(newY, count, newDx);
+}
+
 QList<Qt::GlobalColor> SignalPlot::getDefaultColors()
 {
     QList<Qt::GlobalColor> colors;
@@ -492,3 +558,167 @@ void SignalPlot::updateLegendItem()
     m_legendItem->setBackgroundBrush(bgCol);
     m_legendItem->setBorderPen(bgCol);
 }
+
+void SignalPlot::updateResolution()
+{
+    int columns = canvas()->width();
+
+    auto items = itemList(QwtPlotItem::Rtti_PlotCurve);
+
+    for(auto& item: items){
+        auto curv = static_cast<QwtPlotCurve*>(item);
+        auto trendData = static_cast<SignalSeriesData*>(curv->data());
+
+        trendData->setResolution(columns);
+    }
+}
+
+void SignalPlot::resizeEvent(QResizeEvent* event)
+{
+    QwtPlot::resizeEvent(event);
+
+    updateResolution();
+}
+
+void SignalPlot::updatePlot()
+{
+    if(!m_incremental){
+        replot();
+        return;
+    }
+
+    auto items = itemList(QwtPlotItem::Rtti_PlotCurve);
+
+    bool full = false;
+    bool hasData = false;
+    // first samples of the full wrapped buffers.
+    bool dropping = false;
+    qreal droppingLeft = 0.0;
+    // painted samples left the buffers before the first samples.
+    bool dropped = false;
+    qreal droppedLeft = 0.0;
+    qreal left = 0.0;
+    qreal right = 0.0;
+    qreal bottom = 0.0;
+    qreal top = 0.0;
+
+    for(auto& item: items){
+        auto curv = static_cast<QwtPlotCurve*>(item);
+        auto trendData = static_cast<SignalSeriesData*>(curv->data());
+
+        if(!trendData->newSamples(nullptr)) full = true;
+
+        const SequentialBuffer* buffer = trendData->buffer();
+        if(buffer == nullptr || buffer->avail() == 0) continue;
+
+        QRectF rect = buffer->boundingRect().normalized();
+
+        if(buffer->addressingMode() == SequentialBuffer::CIRCULAR && buffer->avail() >= buffer->size()){
+            droppingLeft = dropping ? std::max(droppingLeft, rect.left()) : rect.left();
+            dropping = true;
+        }
+
+        if(trendData->paintedDropped()){
+            droppedLeft = dropped ? std::max(droppedLeft, rect.left()) : rect.left();
+            dropped = true;
+        }
+
+        if(!hasData){
+            left = rect.left();
+            right = rect.right();
+            bottom = rect.top();
+            top = rect.bottom();
+            hasData = true;
+        }else{
+            left = std::min(left, rect.left());
+            right = std::max(right, rect.right());
+            bottom = std::min(bottom, rect.top());
+            top = std::max(top, rect.bottom());
+        }
+    }
+
+    QRectF dataRect;
+    if(hasData) dataRect.setCoords(left, bottom, right, top);
+
+    // the data is out of the scale.
+    if(!full && hasData){
+        QwtInterval xInterval = axisInterval(QwtAxis::XBottom).normalized();
+        QwtInterval yInterval = axisInterval(QwtAxis::YLeft).normalized();
+
+        // the oldest samples may be left of the scale.
+        full = !(xInterval.contains(right) &&
+                 (dropping || xInterval.contains(left)) &&
+                 yInterval.contains(bottom) && yInterval.contains(top));
+
+        // the dropped samples still painted on the canvas.
+        if(dropped && droppedLeft > xInterval.minValue()) full = true;
+    }
+
+    if(full){
+        if(hasData) updateScale(dataRect, dropping, droppingLeft);
+        replot();
+        return;
+    }
+
+    // the appended segments don't overlap the legend.
+    QRect canvasRect = canvas()->contentsRect();
+    QRegion clipRegion(canvasRect);
+    if(m_legendItem != nullptr){
+        clipRegion -= m_legendItem->geometry(QRectF(canvasRect));
+    }
+    m_directPainter->setClipRegion(clipRegion);
+
+    for(auto& item: items){
+        auto curv = static_cast<QwtPlotCurve*>(item);
+        auto trendData = static_cast<SignalSeriesData*>(curv->data());
+
+        size_t count = 0;
+        trendData->newSamples(&count);
+        if(count == 0) continue;
+
+        size_t avail = trendData->buffer()->avail();
+
+        // from the last painted sample.
+        size_t from = avail - count;
+        if(from > 0) from --;
+
+        // new samples are drawn by the buffer indices.
+        trendData->resetLod();
+        m_directPainter->drawSeries(curv, static_cast<int>(from), static_cast<int>(avail - 1));
+        trendData->markPainted();
+    }
+}
+
+void SignalPlot::replot()
+{
+    QwtPlot::replot();
+
+    // the whole data is painted.
+    auto items = itemList(QwtPlotItem::Rtti_PlotCurve);
+
+    for(auto& item: items){
+        auto curv = static_cast<QwtPlotCurve*>(item);
+        auto trendData = static_cast<SignalSeriesData*>(curv->data());
+
+        trendData->markPainted();
+    }
+}
+
+void SignalPlot::updateScale(const QRectF& dataRect, bool dropping, qreal droppingLeft)
+{
+    qreal width = dataRect.width();
+    if(width <= 0) width = (m_period > 0) ? m_period : 1.0;
+
+    qreal height = dataRect.height();
+    if(height <= 0) height = std::max(qAbs(dataRect.top()), static_cast<qreal>(1.0));
+
+    qreal margin = width * SIGNAL_PLOT_SCALE_MARGIN;
+
+    // the wrapped buffers drop the samples as far as the appended ones go.
+    qreal left = dataRect.left();
+    if(dropping) left = std::min(std::max(left, droppingLeft + margin), dataRect.right());
+
+    setAxisScale(QwtAxis::XBottom, left, dataRect.right() + margin);
+    setAxisScale(QwtAxis::YLeft, dataRect.top() - height * SIGNAL_PLOT_SCALE_MARGIN,
+                                 dataRect.bottom() + height * SIGNAL_PLOT_SCALE_MARGIN);
+}
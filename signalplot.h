@@ -11,6 +11,8 @@
 
 class QwtPlotCurve;
 class QwtPlotLegendItem;
+class QwtPlotDirectPainter;
+class QResizeEvent;
 class SequentialBuffer;
 
 
@@ -65,6 +67,8 @@ public:
     QRectF boundingRect() const;
 
     void putSample(int n, const qreal& newY, const qreal& newDx = -1);
+    // puts the samples array with the newDx step.
+    void putSamples(int n, const qreal* newY, size_t count, const qreal& newDx = -1);
 
     static QList<Qt::GlobalColor> getDefaultColors();
 
@@ -74,8 +78,22 @@ public:
     bool legendItemEnabled() const;
     void setLegendItemEnabled(bool newEnabled);
 
+    // the appended samples are painted over the canvas while they fit the scale
+    // and the samples dropped by the wrapped buffers are left of the scale,
+    // otherwise the scale is moved and the plot is replotted.
+    bool incremental() const;
+    void setIncremental(bool newIncremental);
+
+    // Y of the new signals buffers are stored in float,
+    // the buffers are cleared on change.
+    bool compactStorage() const;
+    void setCompactStorage(bool newCompactStorage);
+
 public slots:
     void clear();
+    // replots or paints the appended samples only.
+    void updatePlot();
+    void replot() override;
 
 protected:
     size_t m_size;
@@ -84,11 +102,22 @@ protected:
 
     QwtPlotLegendItem* m_legendItem;
 
+    bool m_incremental;
+    bool m_compactStorage;
+    QwtPlotDirectPainter* m_directPainter;
+
     int findCurve(const QwtPlotCurve* findCurv) const;
     QwtPlotCurve* getCurve(int n);
     const QwtPlotCurve* getCurve(int n) const;
 
     void updateLegendItem();
+    // draws at most two samples per canvas pixel column.
+    void updateResolution();
+    // scale of the data with the margins for the appended samples,
+    // the samples dropped until the next scale change stay left of the scale.
+    void updateScale(const QRectF& dataRect, bool dropping, qreal droppingLeft);
+
+    void resizeEvent(QResizeEvent* event) override;
 };
 
 #endif // SIGNALPLOT_H
@@ -1,5 +1,6 @@
 #include "signalseriesdata.h"
 #include "sequentialbuffer.h"
+#include <algorithm>
 
 
 
@@ -7,6 +8,9 @@ SignalSeriesData::SignalSeriesData(SequentialBuffer* newBuffer)
     :QwtSeriesData<QPointF>()
 {
     m_buffer = newBuffer;
+    m_resolution = 0;
+    m_lodActive = false;
+    m_painted = 0;
 }
 
 SignalSeriesData::~SignalSeriesData()
@@ -27,11 +31,13 @@ const SequentialBuffer* SignalSeriesData::buffer() const
 void SignalSeriesData::setBuffer(SequentialBuffer* newBuffer)
 {
     m_buffer = newBuffer;
+    m_lodActive = false;
 }
 
 size_t SignalSeriesData::size() const
 {
     if(m_buffer == nullptr) return 0;
+    if(m_lodActive) return static_cast<size_t>(m_lod.size());
     return m_buffer->avail();
 }
 
@@ -46,11 +52,16 @@ void SignalSeriesData::setBufferSize(size_t newSize)
     if(m_buffer == nullptr) return;
 
     m_buffer->setSize(newSize);
+    m_lodActive = false;
 }
 
 QPointF SignalSeriesData::sample(size_t i) const
 {
     if(m_buffer == nullptr) return QPointF();
+    if(m_lodActive){
+        if(i >= static_cast<size_t>(m_lod.size())) return QPointF();
+        return m_lod[static_cast<int>(i)];
+    }
     return m_buffer->get(i);
 }
 
@@ -60,10 +71,64 @@ QRectF SignalSeriesData::boundingRect() const
     return m_buffer->boundingRect();
 }
 
+void SignalSeriesData::setRectOfInterest(const QRectF& rect)
+{
+    updateLod(rect);
+}
+
+int SignalSeriesData::resolution() const
+{
+    return m_resolution;
+}
+
+void SignalSeriesData::setResolution(int newResolution)
+{
+    m_resolution = std::max(newResolution, 0);
+}
+
+void SignalSeriesData::resetLod()
+{
+    m_lodActive = false;
+    m_lod.clear();
+}
+
+bool SignalSeriesData::newSamples(size_t* count) const
+{
+    if(m_buffer == nullptr) return false;
+
+    quint64 written = m_buffer->written();
+    if(written < m_painted) return false;
+
+    if(count) *count = static_cast<size_t>(std::min(written - m_painted, static_cast<quint64>(m_buffer->avail())));
+
+    return true;
+}
+
+bool SignalSeriesData::paintedDropped() const
+{
+    if(m_buffer == nullptr) return false;
+
+    quint64 written = m_buffer->written();
+    if(m_painted == 0 || written < m_painted) return false;
+
+    quint64 size = static_cast<quint64>(m_buffer->size());
+    quint64 paintedFirst = (m_painted > size) ? m_painted - size : 0;
+
+    return written > size && written - size > paintedFirst;
+}
+
+void SignalSeriesData::markPainted()
+{
+    if(m_buffer == nullptr) return;
+
+    m_painted = m_buffer->written();
+}
+
 void SignalSeriesData::clear()
 {
     if(m_buffer == nullptr) return;
     m_buffer->clear();
+    m_lodActive = false;
 }
 
 void SignalSeriesData::putSample(const qreal& newY, const qreal& newDx)
@@ -73,3 +138,78 @@ void SignalSeriesData::putSample(const qreal& newY, const qreal& newDx)
     m_buffer->put(newY, newDx);
 }
 
+void SignalSeriesData::putSamples(const qreal* newY, size_t count, const qreal& newDx)
+{
+    if(m_buffer == nullptr) return;
+
+    m_buffer->put(newY, count, newDx);
+}
+
+
+void SignalSeriesData::updateLod(const QRectF& newRect)
+{
+    m_lodActive = false;
+    m_lod.clear();
+
+    if(m_buffer == nullptr || m_resolution == 0) return;
+    // samples are ordered by x in the circular mode only.
+    if(m_buffer->addressingMode() != SequentialBuffer::CIRCULAR) return;
+
+    QRectF rect = newRect.normalized();
+    if(rect.width() <= 0) return;
+
+    size_t count = m_buffer->avail();
+    size_t columns = static_cast<size_t>(m_resolution);
+
+    if(count <= columns * 2) return;
+
+    // visible samples with the neighbours outside.
+    size_t from = lowerBound(0, count, rect.left());
+    if(from > 0) from --;
+    size_t to = lowerBound(from, count, rect.right());
+    if(to < count) to ++;
+
+    if(to - from <= columns * 2){
+        m_lod.reserve(static_cast<int>(to - from));
+        for(size_t i = from; i < to; i ++) m_lod.append(m_buffer->get(i));
+        m_lodActive = true;
+        return;
+    }
+
+    m_lod.reserve(static_cast<int>(columns * 2 + 4));
+
+    qreal columnWidth = rect.width() / columns;
+    size_t i = from;
+
+    // the last column takes the samples right of the area.
+    for(size_t c = 1; c <= columns + 1 && i < to; c ++){
+        size_t end = (c <= columns) ? lowerBound(i, to, rect.left() + columnWidth * c) : to;
+        if(end == i) continue;
+
+        size_t minI, maxI;
+        if(!m_buffer->extremums(i, end, &minI, &maxI)) break;
+
+        // in the order of x.
+        size_t first = std::min(minI, maxI);
+        size_t last = std::max(minI, maxI);
+
+        m_lod.append(m_buffer->get(first));
+        if(last != first) m_lod.append(m_buffer->get(last));
+
+        i = end;
+    }
+
+    m_lodActive = true;
+}
+
+size_t SignalSeriesData::lowerBound(size_t from, size_t to, const qreal& x) const
+{
+    // first sample with the x not less than given.
+    while(from < to){
+        size_t mid = from + (to - from) / 2;
+        if(m_buffer->get(mid).x() < x) from = mid + 1;
+        else to = mid;
+    }
+
+    return from;
+}
@@ -5,6 +5,7 @@
 #include <QwtSeriesData>
 #include <QPointF>
 #include <QVector>
+#include <QRectF>
 
 class SequentialBuffer;
 
@@ -26,12 +27,40 @@ public:
     QPointF sample(size_t i) const override;
     QRectF boundingRect() const override;
 
+    // visible area, the plot sets it before drawing.
+    void setRectOfInterest(const QRectF& rect) override;
+
+    // pixel columns of the canvas, 0 - all samples are drawn.
+    int resolution() const;
+    void setResolution(int newResolution);
+    // the buffer samples are returned until the next setRectOfInterest().
+    void resetLod();
+
+    // samples put after the last markPainted(),
+    // false if the buffer was cleared.
+    bool newSamples(size_t* count) const;
+    // the wrapped buffer dropped the painted samples.
+    bool paintedDropped() const;
+    void markPainted();
+
     void clear();
 
     void putSample(const qreal& newY, const qreal& newDx = -1);
+    void putSamples(const qreal* newY, size_t count, const qreal& newDx = -1);
 
 private:
     SequentialBuffer* m_buffer;
+
+    // min & max of the samples per pixel column
+    // in the visible area.
+    int m_resolution;
+    bool m_lodActive;
+    QVector<QPointF> m_lod;
+
+    quint64 m_painted;
+
+    void updateLod(const QRectF& newRect);
+    size_t lowerBound(size_t from, size_t to, const qreal& x) const;
 };
 
 #endif // SIGNALSERIESDATA_H
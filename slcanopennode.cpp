@@ -3,10 +3,17 @@
 #include "slcan_port_qt.h"
 #include <QTimer>
 #include <QDebug>
+#include <algorithm>
+#include <string.h>
 
 
 #define SDO_COMM_READ_ERROR_ON_SIZE_MISMATCH 0
 
+// Local OD objects mapped to PDOs: index + pdo * 8 + slot.
+#define TPDO_MAPPED_OD_INDEX 0x2000
+#define RPDO_MAPPED_OD_INDEX 0x2100
+#define PDO_MAX_SIZE 8
+
 
 
 SLCanOpenNode::SLCanOpenNode(QObject *parent)
@@ -17,6 +24,7 @@ SLCanOpenNode::SLCanOpenNode(QObject *parent)
     slcan_master_set_no_answers(&m_scm, true);
     m_co = nullptr;
 
+    m_bitrate = 125;
     m_firstHBTime = 100;
     m_SDOserverTimeout = 500;
     m_SDOclientTimeout = 500;
@@ -28,6 +36,21 @@ SLCanOpenNode::SLCanOpenNode(QObject *parent)
     m_heartbeatTime = 0;
     m_defaultTimeout = 1000;
 
+    m_syncPeriod = 0;
+    m_syncCounterOverflow = 0;
+    m_syncCount = 0;
+    m_syncMeasuredPeriod = 0;
+    m_syncRpdoReceived = false;
+
+    resetNodeStates();
+
+    m_listenOnly = false;
+
+    m_sdoCache.setDefaultPolicies();
+
+    resetTpdos();
+    resetRpdos();
+
     m_coProcessTimer = new QTimer(this);
     m_coProcessTimer->setSingleShot(false);
     m_coProcessTimer->setInterval(0);
@@ -120,6 +143,9 @@ bool SLCanOpenNode::openPort(const QString& name, QSerialPort::BaudRate baud, QS
         return false;
     }
 
+    m_busStats.setSerialConf(static_cast<quint32>(baud), parity != QSerialPort::NoParity,
+                             (stopBits == QSerialPort::TwoStop) ? 2 : 1);
+
     connect(port, &QSerialPort::readyRead, this, &SLCanOpenNode::slcanSerialReadyRead);
     connect(port, &QSerialPort::bytesWritten, this, &SLCanOpenNode::slcanSerialBytesWritten);
 
@@ -145,12 +171,16 @@ bool SLCanOpenNode::createCO(uint newBitrate)
 
     if(m_co != nullptr) return false;
 
+    // apply current settings & PDO configuration.
+    createOd();
+
     m_co = CO_new(m_od.config(), nullptr);
     if(m_co == nullptr) return false;
 
     CO_ReturnError_t co_err = CO_ERROR_NO;
 
     uint16_t bitRate = newBitrate;
+    m_bitrate = newBitrate;
 
     co_err = CO_CANinit(m_co, &m_scm, bitRate);
     if(co_err != CO_ERROR_NO){
@@ -159,6 +189,16 @@ bool SLCanOpenNode::createCO(uint newBitrate)
         return false;
     }
 
+    CO_CANsetRxTap(m_co->CANmodule, this, &SLCanOpenNode::canRxTap);
+    CO_CANsetTxTap(m_co->CANmodule, this, &SLCanOpenNode::canTxTap);
+    CO_CANsetListenOnly(m_co->CANmodule, m_listenOnly);
+
+    m_busStats.setBitrate(m_bitrate);
+    m_busStats.setAdapterAnswers(!slcan_master_no_answers(&m_scm));
+    m_busStats.reset();
+
+    m_sdoObserver.reset();
+
     uint32_t errInfo;
 
     co_err = CO_CANopenInit(m_co, nullptr, nullptr, m_od.od(),
@@ -184,6 +224,12 @@ bool SLCanOpenNode::createCO(uint newBitrate)
 
     m_coProcessTp = meas_clock::now();
 
+    m_syncCount = 0;
+    m_syncMeasuredPeriod = 0;
+    m_syncRpdoReceived = false;
+
+    resetNodeStates();
+
     CO_CANsetNormalMode(m_co->CANmodule);
 
     if(port != nullptr){
@@ -211,9 +257,20 @@ void SLCanOpenNode::destroyCO()
 
     cancelAllSDOComms();
 
+    resetNodeStates();
+
     emit disconnected();
 }
 
+bool SLCanOpenNode::restartCO()
+{
+    if(!isConnected()) return false;
+
+    destroyCO();
+
+    return createCO(m_bitrate);
+}
+
 bool SLCanOpenNode::isConnected() const
 {
     if(m_co == nullptr) return false;
@@ -331,6 +388,91 @@ void SLCanOpenNode::setAdapterNoAnswers(bool newNoAnswers)
     slcan_master_set_no_answers(&m_scm, newNoAnswers);
 }
 
+uint32_t SLCanOpenNode::syncPeriod() const
+{
+    return m_syncPeriod;
+}
+
+void SLCanOpenNode::setSyncPeriod(uint32_t newSyncPeriod)
+{
+    m_syncPeriod = newSyncPeriod;
+}
+
+uint8_t SLCanOpenNode::syncCounterOverflow() const
+{
+    return m_syncCounterOverflow;
+}
+
+bool SLCanOpenNode::setSyncCounterOverflow(uint8_t newSyncCounterOverflow)
+{
+    if(newSyncCounterOverflow == 1 || newSyncCounterOverflow > 240) return false;
+
+    m_syncCounterOverflow = newSyncCounterOverflow;
+
+    return true;
+}
+
+quint32 SLCanOpenNode::syncCount() const
+{
+    return m_syncCount;
+}
+
+bool SLCanOpenNode::listenOnly() const
+{
+    return m_listenOnly;
+}
+
+void SLCanOpenNode::setListenOnly(bool newListenOnly)
+{
+    if(m_listenOnly == newListenOnly) return;
+
+    m_listenOnly = newListenOnly;
+
+    if(m_co == nullptr) return;
+
+    CO_CANsetListenOnly(m_co->CANmodule, m_listenOnly);
+
+    m_sdoObserver.reset();
+
+    if(m_listenOnly){
+        cancelAllSDOComms();
+    }
+}
+
+bool SLCanOpenNode::addHbConsumer(NodeId devId, uint16_t hbTime)
+{
+    if(devId == 0 || devId >= NODES_COUNT) return false;
+    if(hbTime == 0) return false;
+    if(m_hbConsumers.size() >= HB_CONSUMERS_COUNT) return false;
+
+    for(const auto& hbCons: m_hbConsumers){
+        if(hbCons.nodeId == devId) return false;
+    }
+
+    m_hbConsumers.append({devId, hbTime});
+
+    return true;
+}
+
+void SLCanOpenNode::resetHbConsumers()
+{
+    m_hbConsumers.clear();
+}
+
+SLCanOpenNode::NodeState SLCanOpenNode::nodeState(NodeId devId) const
+{
+    if(devId >= NODES_COUNT) return NODE_UNKNOWN;
+
+    return m_nodeStates[devId];
+}
+
+bool SLCanOpenNode::nodeAvailable(NodeId devId) const
+{
+    NodeState state = nodeState(devId);
+
+    return state != NODE_MISSING && state != NODE_STOPPED;
+}
+
 bool SLCanOpenNode::updateOd()
 {
     if(isConnected()) return false;
@@ -341,6 +483,175 @@ bool SLCanOpenNode::updateOd()
     return true;
 }
 
+bool SLCanOpenNode::sdoCacheEnabled() const
+{
+    return m_sdoCache.enabled();
+}
+
+void SLCanOpenNode::setSdoCacheEnabled(bool newEnabled)
+{
+    m_sdoCache.setEnabled(newEnabled);
+}
+
+SDOCache* SLCanOpenNode::sdoCache()
+{
+    return &m_sdoCache;
+}
+
+const SDOCache* SLCanOpenNode::sdoCache() const
+{
+    return &m_sdoCache;
+}
+
+CanTraceBuffer* SLCanOpenNode::canTrace()
+{
+    return &m_canTrace;
+}
+
+const CanTraceBuffer* SLCanOpenNode::canTrace() const
+{
+    return &m_canTrace;
+}
+
+const CanBusStats* SLCanOpenNode::busStats() const
+{
+    return &m_busStats;
+}
+
+void SLCanOpenNode::canRxTap(void* object, const CO_CANrxMsg_t* message)
+{
+    if(object == nullptr) return;
+
+    SLCanOpenNode* slcon = static_cast<SLCanOpenNode*>(object);
+
+    slcon->m_canTrace.put(message->ident & 0x7ff, (message->ident & 0x8000) != 0, false,
+                          message->DLC, message->data);
+    slcon->m_busStats.put(message->ident & 0x7ff, (message->ident & 0x8000) != 0, false,
+                          message->DLC, message->data);
+
+    slcon->processRxFrame(message);
+}
+
+void SLCanOpenNode::canTxTap(void* object, const CO_CANtx_t* message)
+{
+    if(object == nullptr) return;
+
+    SLCanOpenNode* slcon = static_cast<SLCanOpenNode*>(object);
+
+    slcon->m_canTrace.put(message->ident & 0x7ff, (message->ident & 0x8000) != 0, true,
+                          message->DLC, message->data);
+    slcon->m_busStats.put(message->ident & 0x7ff, (message->ident & 0x8000) != 0, true,
+                          message->DLC, message->data);
+}
+
+void SLCanOpenNode::processRxFrame(const CO_CANrxMsg_t* message)
+{
+    // RTR.
+    if(message->ident & 0x8000) return;
+
+    uint16_t cobid = message->ident & 0x7ff;
+
+    // SDO of other masters.
+    if(m_listenOnly && ((cobid & 0x780) == CO_CAN_ID_SDO_SRV || (cobid & 0x780) == CO_CAN_ID_SDO_CLI)){
+        processObservedSdo(message);
+        return;
+    }
+
+    // NMT error control.
+    if((cobid & 0x780) == CO_CAN_ID_HEARTBEAT){
+        NodeId nodeId = cobid & 0x7f;
+
+        if(nodeId == 0 || message->DLC != 1) return;
+
+        switch(message->data[0] & 0x7f){
+        // Bootup.
+        case CO_NMT_INITIALIZING:
+            m_sdoCache.invalidateNode(nodeId);
+
+            setNodeState(nodeId, NODE_INITIALIZING);
+
+            emit nodeBootup(nodeId);
+            break;
+        case CO_NMT_PRE_OPERATIONAL:
+            setNodeState(nodeId, NODE_PRE_OPERATIONAL);
+            break;
+        case CO_NMT_OPERATIONAL:
+            setNodeState(nodeId, NODE_OPERATIONAL);
+            break;
+        case CO_NMT_STOPPED:
+            setNodeState(nodeId, NODE_STOPPED);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void SLCanOpenNode::processObservedSdo(const CO_CANrxMsg_t* message)
+{
+    m_sdoObserver.put(message->ident & 0x7ff, message->DLC, message->data);
+}
+
+void SLCanOpenNode::processObservedValues()
+{
+    if(!m_sdoObserver.hasValues()) return;
+
+    // taken, slots may reconnect.
+    auto values = m_sdoObserver.takeValues();
+
+    for(const auto& val: values){
+        emit valueObserved(val.nodeId, val.index, val.subIndex, val.data);
+    }
+}
+
+void SLCanOpenNode::processHbConsumer()
+{
+#if ((CO_CONFIG_HB_CONS)&CO_CONFIG_HB_CONS_ENABLE) != 0
+    if(m_co == nullptr || m_co->HBcons == nullptr) return;
+
+    // active states are set by the received heartbeats.
+    for(const auto& hbCons: m_hbConsumers){
+        int8_t idx = CO_HBconsumer_getIdxByNodeId(m_co->HBcons, hbCons.nodeId);
+        if(idx < 0) continue;
+
+        if(CO_HBconsumer_getState(m_co->HBcons, idx) == CO_HBconsumer_TIMEOUT){
+            setNodeState(hbCons.nodeId, NODE_MISSING);
+        }
+    }
+#endif
+}
+
+void SLCanOpenNode::resetNodeStates()
+{
+    for(int i = 0; i < NODES_COUNT; i ++){
+        m_nodeStates[i] = NODE_UNKNOWN;
+    }
+
+    // monitored nodes are missing until the first heartbeat.
+    if(m_co == nullptr) return;
+
+#if ((CO_CONFIG_HB_CONS)&CO_CONFIG_HB_CONS_ENABLE) != 0
+    for(const auto& hbCons: m_hbConsumers){
+        m_nodeStates[hbCons.nodeId] = NODE_MISSING;
+    }
+#endif
+}
+
+void SLCanOpenNode::setNodeState(NodeId devId, NodeState state)
+{
+    if(devId >= NODES_COUNT) return;
+    if(m_nodeStates[devId] == state) return;
+
+    m_nodeStates[devId] = state;
+
+    // do not wait timeouts of the dead node.
+    if(!nodeAvailable(devId)){
+        cancelNodeSDOComms(devId);
+    }
+
+    emit nodeStateChanged(devId, state);
+}
+
 void SLCanOpenNode::slcanSerialReadyRead()
 {
     pollSlcanProcessCO();
@@ -368,6 +679,7 @@ void SLCanOpenNode::pollSlcanProcessCO()
 
     slcan_master_poll(&m_scm);
     CO_CANinterrupt(m_co->CANmodule);
+    m_busStats.update();
 
     meas_clock::time_point cur_tp = meas_clock::now();
     std::chrono::microseconds dt_dur = std::chrono::duration_cast<std::chrono::microseconds>(cur_tp - m_coProcessTp);
@@ -378,6 +690,8 @@ void SLCanOpenNode::pollSlcanProcessCO()
 
     CO_NMT_reset_cmd_t reset_cmd = CO_process(m_co, false, dt, nullptr);
 
+    processHbConsumer();
+
     if(reset_cmd == CO_RESET_NOT){
         //qDebug() << "CO_NMT_NO_COMMAND";
     }else if(reset_cmd == CO_RESET_COMM){
@@ -396,6 +710,7 @@ void SLCanOpenNode::pollSlcanProcessCO()
 
 #if ((CO_CONFIG_SYNC)&CO_CONFIG_SYNC_ENABLE) != 0
     syncWas = CO_process_SYNC(m_co, dt, nullptr);
+    if(syncWas) processSync();
 #endif
 
 #if ((CO_CONFIG_PDO)&CO_CONFIG_RPDO_ENABLE) != 0
@@ -407,10 +722,18 @@ void SLCanOpenNode::pollSlcanProcessCO()
 #endif
 
     processSDOClient(dt);
+
+#if ((CO_CONFIG_PDO)&CO_CONFIG_RPDO_ENABLE) != 0
+    processReceivedRpdos();
+#endif
+
+    processObservedValues();
 }
 
 void SLCanOpenNode::processSDOClient(uint32_t dt)
 {
+    processCachedComms();
+
 #if (((CO_CONFIG_SDO_CLI)&CO_CONFIG_SDO_CLI_ENABLE) != 0)
     if(m_co == nullptr || m_co->SDOclient == nullptr) return;
 
@@ -423,6 +746,28 @@ void SLCanOpenNode::processSDOClient(uint32_t dt)
 #endif
 }
 
+void SLCanOpenNode::processCachedComms()
+{
+    while(!m_cachedSdoComms.isEmpty()){
+        auto sdoc = m_cachedSdoComms.dequeue();
+        sdoc->finish(SDOComm::ERROR_NONE);
+    }
+}
+
+void SLCanOpenNode::updateSDOCache(SDOComm* sdoc)
+{
+    if(!m_sdoCache.enabled()) return;
+
+    if(sdoc->type() == SDOComm::DOWNLOAD){
+        m_sdoCache.invalidate(sdoc->nodeId(), sdoc->index(), sdoc->subIndex());
+    }else if(sdoc->type() == SDOComm::UPLOAD){
+        if(sdoc->error() == SDOComm::ERROR_NONE && !sdoc->cancelled()){
+            m_sdoCache.put(sdoc->nodeId(), sdoc->index(), sdoc->subIndex(),
+                           sdoc->data(), sdoc->transferedDataSize());
+        }
+    }
+}
+
 bool SLCanOpenNode::processFrontComm(uint32_t dt)
 {
     if(m_sdoComms.isEmpty()) return false;
@@ -505,6 +850,7 @@ bool SLCanOpenNode::processFrontComm(uint32_t dt)
         __attribute__ ((fallthrough));
         case SDOComm::IDLE:
             m_sdoComms.dequeue();
+            updateSDOCache(sdoc);
             sdoc->finish();
             return true;
         }
@@ -608,6 +954,7 @@ bool SLCanOpenNode::processFrontComm(uint32_t dt)
         __attribute__ ((fallthrough));
         case SDOComm::IDLE:
             m_sdoComms.dequeue();
+            updateSDOCache(sdoc);
             sdoc->finish();
             return true;
         }
@@ -735,6 +1082,7 @@ SDOComm* SLCanOpenNode::write(NodeId devId, Index dataIndex, SubIndex dataSubInd
 bool SLCanOpenNode::read(SDOComm* sdocom)
 {
     if(!isConnected()) return false;
+    if(m_listenOnly) return false;
 
     if(sdocom == nullptr) return false;
     if(sdocom->dataSize() == 0) return false;
@@ -746,6 +1094,18 @@ bool SLCanOpenNode::read(SDOComm* sdocom)
     sdocom->setCancel(false);
     sdocom->setType(SDOComm::UPLOAD);
     sdocom->setState(SDOComm::QUEUED);
+
+    if(m_sdoCache.enabled()){
+        size_t readSize = 0;
+        if(m_sdoCache.get(sdocom->nodeId(), sdocom->index(), sdocom->subIndex(),
+                          sdocom->data(), sdocom->transferSize(), &readSize)){
+            sdocom->setDataTransfered(readSize);
+            sdocom->setDataBuffered(readSize);
+            m_cachedSdoComms.enqueue(sdocom);
+            return true;
+        }
+    }
+
     m_sdoComms.enqueue(sdocom);
 
     return true;
@@ -754,6 +1114,7 @@ bool SLCanOpenNode::read(SDOComm* sdocom)
 bool SLCanOpenNode::write(SDOComm* sdocom)
 {
     if(!isConnected()) return false;
+    if(m_listenOnly) return false;
 
     if(sdocom == nullptr) return false;
     if(sdocom->dataSize() == 0) return false;
@@ -765,15 +1126,160 @@ bool SLCanOpenNode::write(SDOComm* sdocom)
     sdocom->setCancel(false);
     sdocom->setType(SDOComm::DOWNLOAD);
     sdocom->setState(SDOComm::QUEUED);
+
+    m_sdoCache.invalidate(sdocom->nodeId(), sdocom->index(), sdocom->subIndex());
+
     m_sdoComms.enqueue(sdocom);
 
     return true;
 }
 
+bool SLCanOpenNode::setTpdo(int tpdoNum, uint32_t cobid, uint8_t transType, uint16_t inhibitTime, uint16_t eventTimer)
+{
+    if(tpdoNum < 0 || tpdoNum >= TPDOS_COUNT) return false;
+
+    return setPdo(m_tpdos[tpdoNum], cobid, transType, inhibitTime, eventTimer);
+}
+
+bool SLCanOpenNode::addTpdoMapping(int tpdoNum, NodeId devId, Index dataIndex, SubIndex dataSubIndex, size_t dataSize)
+{
+    return addPdoMapping(m_tpdos, TPDOS_COUNT, tpdoNum, TPDO_MAPPED_OD_INDEX,
+                         makeFullIndex(devId, dataIndex, dataSubIndex), dataSize);
+}
+
+void SLCanOpenNode::resetTpdos()
+{
+    resetPdos(m_tpdos, TPDOS_COUNT);
+}
+
+bool SLCanOpenNode::hasTpdoMapping(NodeId devId, Index dataIndex, SubIndex dataSubIndex) const
+{
+    return m_tpdoObjects.contains(makeFullIndex(devId, dataIndex, dataSubIndex));
+}
+
+bool SLCanOpenNode::writeTpdo(NodeId devId, Index dataIndex, SubIndex dataSubIndex, const void* data, size_t dataSize)
+{
+    if(!isConnected()) return false;
+    if(m_listenOnly) return false;
+
+    if(data == nullptr || dataSize == 0) return false;
+
+    FullIndex key = makeFullIndex(devId, dataIndex, dataSubIndex);
+
+    auto it = m_tpdoObjects.find(key);
+    if(it == m_tpdoObjects.end()) return false;
+
+    int tpdoNum = it.value();
+    const PdoConfig& tpdo = m_tpdos[tpdoNum];
+
+    auto objIt = std::find_if(tpdo.objects.begin(), tpdo.objects.end(), [key](const PdoMappedObject& obj){
+        return obj.key == key;
+    });
+    if(objIt == tpdo.objects.end()) return false;
+    if(objIt->dataSize != dataSize) return false;
+
+    auto e = m_od.entryByIndex(objIt->odIndex);
+    if(!e.isValid()) return false;
+
+    if(!e.write(data, dataSize)) return false;
+
+#if ((CO_CONFIG_PDO)&CO_CONFIG_TPDO_ENABLE) != 0
+    // cyclic sync TPDOs send the current value on every n-th SYNC.
+    if(tpdo.transType == 0 || tpdo.transType >= 254){
+        CO_TPDOsendRequest(&m_co->TPDO[tpdoNum]);
+    }
+#endif
+
+    return true;
+}
+
+bool SLCanOpenNode::setRpdo(int rpdoNum, uint32_t cobid, uint8_t transType)
+{
+    if(rpdoNum < 0 || rpdoNum >= RPDOS_COUNT) return false;
+
+    return setPdo(m_rpdos[rpdoNum], cobid, transType, 0, 0);
+}
+
+bool SLCanOpenNode::addRpdoMapping(int rpdoNum, NodeId devId, Index dataIndex, SubIndex dataSubIndex, size_t dataSize)
+{
+    return addPdoMapping(m_rpdos, RPDOS_COUNT, rpdoNum, RPDO_MAPPED_OD_INDEX,
+                         makeFullIndex(devId, dataIndex, dataSubIndex), dataSize);
+}
+
+void SLCanOpenNode::resetRpdos()
+{
+    resetPdos(m_rpdos, RPDOS_COUNT);
+}
+
+bool SLCanOpenNode::hasRpdoMapping(NodeId devId, Index dataIndex, SubIndex dataSubIndex) const
+{
+    return m_rpdoObjects.contains(makeFullIndex(devId, dataIndex, dataSubIndex));
+}
+
+bool SLCanOpenNode::setPdo(PdoConfig& pdo, uint32_t cobid, uint8_t transType, uint16_t inhibitTime, uint16_t eventTimer)
+{
+    if(cobid == 0 || cobid > 0x7ff) return false;
+    if(transType > 240 && transType < 254) return false;
+
+    pdo.enabled = true;
+    pdo.cobid = cobid;
+    pdo.transType = transType;
+    pdo.inhibitTime = inhibitTime;
+    pdo.eventTimer = eventTimer;
+
+    return true;
+}
+
+bool SLCanOpenNode::addPdoMapping(PdoConfig* pdos, int count, int pdoNum, Index odIndexBase, FullIndex key, size_t dataSize)
+{
+    if(pdoNum < 0 || pdoNum >= count) return false;
+    if(dataSize == 0) return false;
+
+    PdoConfig& pdo = pdos[pdoNum];
+
+    if(pdo.objects.size() >= PDO_MAX_OBJECTS) return false;
+
+    size_t pdoSize = 0;
+
+    for(int i = 0; i < count; i ++){
+        for(const auto& obj: pdos[i].objects){
+            if(obj.key == key) return false;
+            if(i == pdoNum) pdoSize += obj.dataSize;
+        }
+    }
+
+    if(pdoSize + dataSize > PDO_MAX_SIZE) return false;
+
+    PdoMappedObject obj;
+    obj.key = key;
+    obj.odIndex = odIndexBase + pdoNum * PDO_MAX_OBJECTS + pdo.objects.size();
+    obj.dataSize = dataSize;
+
+    pdo.objects.append(obj);
+
+    return true;
+}
+
+void SLCanOpenNode::resetPdos(PdoConfig* pdos, int count)
+{
+    for(int i = 0; i < count; i ++){
+        PdoConfig& pdo = pdos[i];
+
+        pdo.enabled = false;
+        pdo.cobid = 0;
+        pdo.transType = 254;
+        pdo.inhibitTime = 0;
+        pdo.eventTimer = 0;
+        pdo.objects.clear();
+    }
+}
+
 bool SLCanOpenNode::cancel(SDOComm* sdoc)
 {
     if(sdoc == nullptr) return true;
 
+    if(m_cachedSdoComms.removeOne(sdoc)) return true;
+
     auto it = std::find(m_sdoComms.begin(), m_sdoComms.end(), sdoc);
 
     if(it == m_sdoComms.end()) return true;
@@ -790,12 +1296,47 @@ bool SLCanOpenNode::cancel(SDOComm* sdoc)
 
 void SLCanOpenNode::cancelAllSDOComms()
 {
+    while(!m_cachedSdoComms.isEmpty()){
+        auto sdoc = m_cachedSdoComms.dequeue();
+        sdoc->finish(SDOComm::ERROR_CANCEL);
+    }
+
     while(!m_sdoComms.isEmpty()){
         auto sdoc = m_sdoComms.dequeue();
         sdoc->finish(SDOComm::ERROR_CANCEL);
     }
 }
 
+void SLCanOpenNode::cancelNodeSDOComms(NodeId devId)
+{
+    QQueue<SDOComm*> cancelled;
+
+    for(auto it = m_sdoComms.begin(); it != m_sdoComms.end();){
+        SDOComm* sdoc = *it;
+
+        if(sdoc->nodeId() != devId){
+            ++ it;
+            continue;
+        }
+
+        // the front comm is in progress.
+        if(it == m_sdoComms.begin()){
+            sdoc->cancel();
+            ++ it;
+            continue;
+        }
+
+        it = m_sdoComms.erase(it);
+        cancelled.enqueue(sdoc);
+    }
+
+    // slots may queue new comms.
+    while(!cancelled.isEmpty()){
+        auto sdoc = cancelled.dequeue();
+        sdoc->finish(SDOComm::ERROR_CANCEL);
+    }
+}
+
 void SLCanOpenNode::createOd()
 {
     m_od.clear();
@@ -808,8 +1349,21 @@ void SLCanOpenNode::createOd()
 #endif
 
 #if ((CO_CONFIG_SYNC)&CO_CONFIG_SYNC_ENABLE) != 0
-    m_od.add_H1005_CobidSync();
-    m_od.add_H1006_CommCyclPeriod();
+    auto e_1005 = m_od.add_H1005_CobidSync();
+    if(e_1005.isValid()){
+        uint32_t cobid = CO_CAN_ID_SYNC;
+#if ((CO_CONFIG_SYNC)&CO_CONFIG_SYNC_PRODUCER) != 0
+        // SYNC producer.
+        if(m_syncPeriod != 0) cobid |= 0x40000000;
+#endif
+        e_1005.write(cobid);
+    }
+
+    auto e_1006 = m_od.add_H1006_CommCyclPeriod();
+    if(e_1006.isValid()){
+        e_1006.write(m_syncPeriod);
+    }
+
     m_od.add_H1007_SyncWindowLen();
 #endif
 
@@ -830,7 +1384,14 @@ void SLCanOpenNode::createOd()
 #endif
 
 #if ((CO_CONFIG_HB_CONS)&CO_CONFIG_HB_CONS_ENABLE) != 0
-    m_od.add_H1016_ConsumerHbTime();
+    auto e_1016 = m_od.add_H1016_ConsumerHbTime();
+    if(e_1016.isValid()){
+        for(int i = 0; i < m_hbConsumers.size(); i ++){
+            const HbConsumer& hbCons = m_hbConsumers[i];
+            uint32_t hbConsTime = (static_cast<uint32_t>(hbCons.nodeId) << 16) | hbCons.hbTime;
+            e_1016.write<uint32_t>(hbConsTime, i + 1);
+        }
+    }
 #endif
 
     auto e_1017 = m_od.add_H1017_ProducerHbTime();
@@ -839,7 +1400,10 @@ void SLCanOpenNode::createOd()
     }
 
 #if ((CO_CONFIG_SYNC)&CO_CONFIG_SYNC_ENABLE) != 0
-    m_od.add_H1019_SyncCntOverflow();
+    auto e_1019 = m_od.add_H1019_SyncCntOverflow();
+    if(e_1019.isValid()){
+        e_1019.write(m_syncCounterOverflow);
+    }
 #endif
 
 #if (CO_CONFIG_SDO_SRV) != 0
@@ -855,14 +1419,233 @@ void SLCanOpenNode::createOd()
 #endif
 
 #if ((CO_CONFIG_PDO)&CO_CONFIG_RPDO_ENABLE) != 0
-    m_od.add_H1400_Rxpdo1Param();
-    m_od.add_H1600_Rxpdo1Mapping();
+    createRpdosOd();
 #endif
 
 #if ((CO_CONFIG_PDO)&CO_CONFIG_TPDO_ENABLE) != 0
-    m_od.add_H1800_Txpdo1Param();
-    m_od.add_H1A00_Txpdo1Mapping();
+    createTpdosOd();
 #endif
 
     m_od.make();
 }
+
+void SLCanOpenNode::createTpdosOd()
+{
+    using AddEntryFn = COObjectDict::Entry (COObjectDict::*)();
+
+    static const AddEntryFn addParam[TPDOS_COUNT] = {
+        &COObjectDict::add_H1800_Txpdo1Param,
+        &COObjectDict::add_H1801_Txpdo1Param,
+        &COObjectDict::add_H1802_Txpdo1Param,
+        &COObjectDict::add_H1803_Txpdo1Param
+    };
+
+    static const AddEntryFn addMapping[TPDOS_COUNT] = {
+        &COObjectDict::add_H1A00_Txpdo1Mapping,
+        &COObjectDict::add_H1A01_Txpdo1Mapping,
+        &COObjectDict::add_H1A02_Txpdo1Mapping,
+        &COObjectDict::add_H1A03_Txpdo1Mapping
+    };
+
+    m_tpdoObjects.clear();
+
+    // CANopenNode takes TPDO entries in a row,
+    // add all of them up to the last used one.
+    int count = 1;
+    for(int i = 0; i < TPDOS_COUNT; i ++){
+        if(m_tpdos[i].enabled && !m_tpdos[i].objects.isEmpty()) count = i + 1;
+    }
+
+    for(int i = 0; i < count; i ++){
+        const PdoConfig& tpdo = m_tpdos[i];
+        bool used = tpdo.enabled && !tpdo.objects.isEmpty();
+
+        // entries are invalidated by the next add.
+        auto e_param = (m_od.*addParam[i])();
+        if(used && e_param.isValid()){
+            e_param.write<uint32_t>(0x40000000 | tpdo.cobid, 1);
+            e_param.write<uint8_t>(tpdo.transType, 2);
+            e_param.write<uint16_t>(tpdo.inhibitTime, 3);
+            e_param.write<uint16_t>(tpdo.eventTimer, 4);
+        }
+
+        auto e_mapping = (m_od.*addMapping[i])();
+        if(used && e_mapping.isValid()){
+            for(int j = 0; j < tpdo.objects.size(); j ++){
+                const PdoMappedObject& obj = tpdo.objects[j];
+                uint32_t map = (static_cast<uint32_t>(obj.odIndex) << 16) | (obj.dataSize * 8);
+                e_mapping.write<uint32_t>(map, j + 1);
+            }
+            e_mapping.write<uint8_t>(tpdo.objects.size(), 0);
+        }
+
+        if(!used) continue;
+
+        for(const auto& obj: tpdo.objects){
+            auto e_obj = m_od.addVarEntry(obj.odIndex, obj.dataSize, ODA_SDO_RW | ODA_TPDO);
+            if(e_obj.isValid()){
+                m_tpdoObjects.insert(obj.key, i);
+            }
+        }
+    }
+}
+
+void SLCanOpenNode::createRpdosOd()
+{
+    using AddEntryFn = COObjectDict::Entry (COObjectDict::*)();
+
+    static const AddEntryFn addParam[RPDOS_COUNT] = {
+        &COObjectDict::add_H1400_Rxpdo1Param,
+        &COObjectDict::add_H1401_Rxpdo1Param,
+        &COObjectDict::add_H1402_Rxpdo1Param,
+        &COObjectDict::add_H1403_Rxpdo1Param
+    };
+
+    static const AddEntryFn addMapping[RPDOS_COUNT] = {
+        &COObjectDict::add_H1600_Rxpdo1Mapping,
+        &COObjectDict::add_H1601_Rxpdo1Mapping,
+        &COObjectDict::add_H1602_Rxpdo1Mapping,
+        &COObjectDict::add_H1603_Rxpdo1Mapping
+    };
+
+    m_rpdoObjects.clear();
+    m_rpdoReceivedObjects.clear();
+
+    // CANopenNode takes RPDO entries in a row,
+    // add all of them up to the last used one.
+    int count = 1;
+    for(int i = 0; i < RPDOS_COUNT; i ++){
+        if(m_rpdos[i].enabled && !m_rpdos[i].objects.isEmpty()) count = i + 1;
+    }
+
+    for(int i = 0; i < count; i ++){
+        const PdoConfig& rpdo = m_rpdos[i];
+        bool used = rpdo.enabled && !rpdo.objects.isEmpty();
+
+        // entries are invalidated by the next add.
+        auto e_param = (m_od.*addParam[i])();
+        if(used && e_param.isValid()){
+            e_param.write<uint32_t>(rpdo.cobid, 1);
+            e_param.write<uint8_t>(rpdo.transType, 2);
+        }
+
+        auto e_mapping = (m_od.*addMapping[i])();
+        if(used && e_mapping.isValid()){
+            for(int j = 0; j < rpdo.objects.size(); j ++){
+                const PdoMappedObject& obj = rpdo.objects[j];
+                uint32_t map = (static_cast<uint32_t>(obj.odIndex) << 16) | (obj.dataSize * 8);
+                e_mapping.write<uint32_t>(map, j + 1);
+            }
+            e_mapping.write<uint8_t>(rpdo.objects.size(), 0);
+        }
+
+        if(!used) continue;
+
+        for(int j = 0; j < rpdo.objects.size(); j ++){
+            const PdoMappedObject& obj = rpdo.objects[j];
+            RpdoObjectExt& objExt = m_rpdoExts[i * PDO_MAX_OBJECTS + j];
+
+            memset(&objExt.ext, 0x0, sizeof(OD_extension_t));
+            objExt.ext.object = &objExt;
+            objExt.ext.read = OD_readOriginal;
+            objExt.ext.write = &SLCanOpenNode::rpdoObjectWrite;
+            objExt.slcon = this;
+            objExt.key = obj.key;
+            objExt.odIndex = obj.odIndex;
+            objExt.sync = rpdo.transType <= 240;
+            objExt.syncNum = 0;
+            objExt.received = false;
+
+            auto e_obj = m_od.addVarEntry(obj.odIndex, obj.dataSize, ODA_SDO_RW | ODA_RPDO);
+            if(e_obj.isValid()){
+                e_obj.setExtension(&objExt.ext);
+                m_rpdoObjects.insert(obj.key, i);
+            }
+        }
+    }
+}
+
+ODR_t SLCanOpenNode::rpdoObjectWrite(OD_stream_t* stream, const void* buf, OD_size_t count, OD_size_t* countWritten)
+{
+    ODR_t res = OD_writeOriginal(stream, buf, count, countWritten);
+    if(res != ODR_OK) return res;
+
+    RpdoObjectExt* objExt = static_cast<RpdoObjectExt*>(stream->object);
+    if(objExt == nullptr || objExt->slcon == nullptr) return res;
+
+    SLCanOpenNode* slcon = objExt->slcon;
+
+    // synchronous RPDO data is processed on the SYNC
+    // following the one the data was sampled at.
+    if(objExt->sync){
+        objExt->syncNum = slcon->m_syncCount - 1;
+        slcon->m_syncRpdoReceived = true;
+    }else{
+        objExt->syncNum = slcon->m_syncCount;
+    }
+
+    // signals are emitted after the RPDO processing.
+    if(!objExt->received){
+        objExt->received = true;
+        objExt->slcon->m_rpdoReceivedObjects.append(objExt);
+    }
+
+    return res;
+}
+
+void SLCanOpenNode::processReceivedRpdos()
+{
+    bool syncSampled = m_syncRpdoReceived;
+    m_syncRpdoReceived = false;
+
+    if(m_rpdoReceivedObjects.isEmpty()) return;
+
+    // copy, slots may reconnect.
+    auto objects = m_rpdoReceivedObjects;
+    m_rpdoReceivedObjects.clear();
+
+    for(auto objExt: objects){
+        objExt->received = false;
+
+        auto e = m_od.entryByIndex(objExt->odIndex);
+        if(!e.isValid()) continue;
+
+        OD_size_t size = e.dataLength();
+        QByteArray data(static_cast<int>(size), 0);
+        if(!e.read(data.data(), size)) continue;
+
+        emit rpdoReceived(static_cast<NodeId>(objExt->key >> 24),
+                          static_cast<Index>(objExt->key >> 8),
+                          static_cast<SubIndex>(objExt->key), data, objExt->syncNum);
+    }
+
+    if(syncSampled){
+        quint32 period = (m_syncPeriod != 0) ? m_syncPeriod : m_syncMeasuredPeriod;
+
+        emit syncSampled(m_syncCount - 1, period);
+    }
+}
+
+void SLCanOpenNode::processSync()
+{
+    meas_clock::time_point tp = meas_clock::now();
+
+    // period of the external SYNC producer.
+    if(m_syncCount != 0){
+        m_syncMeasuredPeriod = std::chrono::duration_cast<std::chrono::microseconds>(tp - m_syncTp).count();
+    }
+
+    m_syncTp = tp;
+    m_syncCount ++;
+}
+
+SLCanOpenNode::FullIndex SLCanOpenNode::makeFullIndex(NodeId devId, Index dataIndex, SubIndex dataSubIndex) const
+{
+    FullIndex fi = 0;
+
+    fi |= (quint32)devId << 24;
+    fi |= (quint32)dataIndex << 8;
+    fi |= (quint32)dataSubIndex;
+
+    return fi;
+}
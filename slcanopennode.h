@@ -4,11 +4,17 @@
 #include <QObject>
 #include <QSerialPort>
 #include <QQueue>
+#include <QHash>
+#include <QVector>
 #include <chrono>
 #include "slcan/slcan_master.h"
 #include "CANopen.h"
 #include "coobjectdict.h"
 #include "sdocomm.h"
+#include "sdocache.h"
+#include "sdoobserver.h"
+#include "cantracebuffer.h"
+#include "canbusstats.h"
 
 
 class QTimer;
@@ -24,6 +30,16 @@ public:
     using Index = quint16;;
     using SubIndex = quint8;
 
+    // NMT state of the remote node.
+    enum NodeState {
+        NODE_UNKNOWN = 0, // not monitored, no heartbeat received.
+        NODE_MISSING, // monitored, heartbeat timed out or not received.
+        NODE_INITIALIZING,
+        NODE_PRE_OPERATIONAL,
+        NODE_OPERATIONAL,
+        NODE_STOPPED
+    };
+
     explicit SLCanOpenNode(QObject *parent = nullptr);
     ~SLCanOpenNode();
 
@@ -33,6 +49,8 @@ public:
 
     bool createCO(uint newBitrate = 125);
     void destroyCO();
+    // re-create CO with the current OD & PDO configuration.
+    bool restartCO();
 
     bool isConnected() const;
 
@@ -70,8 +88,55 @@ public:
     bool adapterNoAnswers() const;
     void setAdapterNoAnswers(bool newNoAnswers);
 
+    /*
+     * Listen only (bus monitor).
+     * Nothing is sent, SDO reads & writes fail.
+     * Expedited SDO transfers of other masters are decoded
+     * and valueObserved() is emitted, RPDOs and heartbeats are received.
+     */
+    bool listenOnly() const;
+    void setListenOnly(bool newListenOnly);
+
+    // SYNC producer period in us, 0 - SYNC is not produced.
+    uint32_t syncPeriod() const;
+    void setSyncPeriod(uint32_t newSyncPeriod);
+
+    // SYNC counter overflow: 0 - no counter, 2..240.
+    uint8_t syncCounterOverflow() const;
+    bool setSyncCounterOverflow(uint8_t newSyncCounterOverflow);
+
+    // SYNC objects produced or received since the connection.
+    quint32 syncCount() const;
+
+    /*
+     * Heartbeat consumer.
+     * Monitored nodes are applied on the next connection.
+     */
+    static const int HB_CONSUMERS_COUNT = 8;
+
+    bool addHbConsumer(NodeId devId, uint16_t hbTime);
+    void resetHbConsumers();
+
+    // States of the nodes by the received heartbeats & HB consumer.
+    NodeState nodeState(NodeId devId) const;
+    // node is not missing or stopped.
+    bool nodeAvailable(NodeId devId) const;
+
     bool updateOd();
 
+    // SDO upload responses cache.
+    bool sdoCacheEnabled() const;
+    void setSdoCacheEnabled(bool newEnabled);
+    SDOCache* sdoCache();
+    const SDOCache* sdoCache() const;
+
+    // Raw CAN frames trace, disabled by default.
+    CanTraceBuffer* canTrace();
+    const CanTraceBuffer* canTrace() const;
+
+    // CAN traffic statistics, bus load & serial link utilization.
+    const CanBusStats* busStats() const;
+
     /*
      * read & write:
      * timeout == -1 -> max timeout (65535).
@@ -88,6 +153,43 @@ public:
     bool read(SDOComm* sdocom);
     bool write(SDOComm* sdocom);
 
+    /*
+     * TPDO setpoints.
+     * Mapped objects are identified by the remote object (node, index, subindex)
+     * that the remote RPDO writes. Local OD objects are allocated for them.
+     * Configuration is applied by updateOd() (disconnected only).
+     * transType: 0 - acyclic sync, 1..240 - cyclic sync, 254, 255 - event driven.
+     */
+    static const int TPDOS_COUNT = 4;
+
+    bool setTpdo(int tpdoNum, uint32_t cobid, uint8_t transType = 254,
+                 uint16_t inhibitTime = 0, uint16_t eventTimer = 0);
+    bool addTpdoMapping(int tpdoNum, NodeId devId, Index dataIndex, SubIndex dataSubIndex, size_t dataSize);
+    void resetTpdos();
+
+    bool hasTpdoMapping(NodeId devId, Index dataIndex, SubIndex dataSubIndex) const;
+    // copy data to the mapped object and request TPDO transmission.
+    bool writeTpdo(NodeId devId, Index dataIndex, SubIndex dataSubIndex,
+                   const void* data, size_t dataSize);
+
+    /*
+     * RPDO live values.
+     * Mapped objects are identified by the remote object (node, index, subindex)
+     * that the remote TPDO transmits, rpdoReceived() is emitted on reception.
+     * syncNum is the SYNC the value was sampled at for synchronous RPDOs,
+     * the last SYNC for event driven ones. syncSampled() is emitted
+     * after all values of the synchronous RPDOs of the SYNC.
+     * Configuration is applied on the next connection.
+     * transType: 0..240 - sync, 254, 255 - event driven.
+     */
+    static const int RPDOS_COUNT = 4;
+
+    bool setRpdo(int rpdoNum, uint32_t cobid, uint8_t transType = 254);
+    bool addRpdoMapping(int rpdoNum, NodeId devId, Index dataIndex, SubIndex dataSubIndex, size_t dataSize);
+    void resetRpdos();
+
+    bool hasRpdoMapping(NodeId devId, Index dataIndex, SubIndex dataSubIndex) const;
+
     // return true if sdoc removed(not in) from queue and can be deleted or reused.
     // when return true - not finish sdo comm.
     bool cancel(SDOComm* sdoc);
@@ -95,6 +197,12 @@ public:
 signals:
     void connected();
     void disconnected();
+    void nodeBootup(NodeId nodeId);
+    void nodeStateChanged(NodeId nodeId, SLCanOpenNode::NodeState state);
+    void rpdoReceived(NodeId devId, Index dataIndex, SubIndex dataSubIndex, const QByteArray& data, quint32 syncNum);
+    void valueObserved(NodeId devId, Index dataIndex, SubIndex dataSubIndex, const QByteArray& data);
+    // periodUs - SYNC period, configured or measured.
+    void syncSampled(quint32 syncNum, quint32 periodUs);
 
 private slots:
     void slcanSerialReadyRead();
@@ -112,6 +220,9 @@ private:
     using meas_clock = std::chrono::steady_clock;
     meas_clock::time_point m_coProcessTp;
 
+    typedef quint32 FullIndex;
+
+    uint m_bitrate;
     quint16 m_firstHBTime;
     quint16 m_SDOserverTimeout;
     quint16 m_SDOclientTimeout;
@@ -122,13 +233,103 @@ private:
     uint16_t m_heartbeatTime;
     int m_defaultTimeout;
 
+    uint32_t m_syncPeriod;
+    uint8_t m_syncCounterOverflow;
+    quint32 m_syncCount;
+    quint32 m_syncMeasuredPeriod;
+    meas_clock::time_point m_syncTp;
+    // synchronous RPDOs sampled at the previous SYNC are received.
+    bool m_syncRpdoReceived;
+
+    struct HbConsumer {
+        NodeId nodeId;
+        uint16_t hbTime;
+    };
+
+    QVector<HbConsumer> m_hbConsumers;
+
+    static const int NODES_COUNT = 128;
+    NodeState m_nodeStates[NODES_COUNT];
+
+    bool m_listenOnly;
+
+    // SDO transfers of other masters,
+    // values are emitted after the processing.
+    SDOObserver m_sdoObserver;
+
+    static const int PDO_MAX_OBJECTS = 8;
+
+    struct PdoMappedObject {
+        FullIndex key;
+        Index odIndex;
+        size_t dataSize;
+    };
+
+    struct PdoConfig {
+        bool enabled;
+        uint32_t cobid;
+        uint8_t transType;
+        uint16_t inhibitTime;
+        uint16_t eventTimer;
+        QVector<PdoMappedObject> objects;
+    };
+
+    PdoConfig m_tpdos[TPDOS_COUNT];
+    // key -> tpdo number.
+    QHash<FullIndex, int> m_tpdoObjects;
+
+    // OD extension of the RPDO mapped object.
+    struct RpdoObjectExt {
+        OD_extension_t ext;
+        SLCanOpenNode* slcon;
+        FullIndex key;
+        Index odIndex;
+        bool sync;
+        quint32 syncNum;
+        bool received;
+    };
+
+    PdoConfig m_rpdos[RPDOS_COUNT];
+    RpdoObjectExt m_rpdoExts[RPDOS_COUNT * PDO_MAX_OBJECTS];
+    // key -> rpdo number.
+    QHash<FullIndex, int> m_rpdoObjects;
+    QVector<RpdoObjectExt*> m_rpdoReceivedObjects;
+
     QQueue<SDOComm*> m_sdoComms;
+    // comms served from the cache, finished on the next poll.
+    QQueue<SDOComm*> m_cachedSdoComms;
+
+    SDOCache m_sdoCache;
+
+    CanTraceBuffer m_canTrace;
+    CanBusStats m_busStats;
+
+    static void canRxTap(void* object, const CO_CANrxMsg_t* message);
+    static void canTxTap(void* object, const CO_CANtx_t* message);
+    void processRxFrame(const CO_CANrxMsg_t* message);
+    void processHbConsumer();
+    void processObservedSdo(const CO_CANrxMsg_t* message);
+    void processObservedValues();
+    void resetNodeStates();
+    void setNodeState(NodeId devId, NodeState state);
 
     void processSDOClient(uint32_t dt);
+    void processCachedComms();
+    void updateSDOCache(SDOComm* sdoc);
     bool processFrontComm(uint32_t dt);
     SDOComm::Error sdoCommError(CO_SDO_abortCode_t code) const;
     void cancelAllSDOComms();
+    void cancelNodeSDOComms(NodeId devId);
     void createOd();
+    bool setPdo(PdoConfig& pdo, uint32_t cobid, uint8_t transType, uint16_t inhibitTime, uint16_t eventTimer);
+    bool addPdoMapping(PdoConfig* pdos, int count, int pdoNum, Index odIndexBase, FullIndex key, size_t dataSize);
+    void resetPdos(PdoConfig* pdos, int count);
+    void createTpdosOd();
+    void createRpdosOd();
+    static ODR_t rpdoObjectWrite(OD_stream_t* stream, const void* buf, OD_size_t count, OD_size_t* countWritten);
+    void processReceivedRpdos();
+    void processSync();
+    FullIndex makeFullIndex(NodeId devId, Index dataIndex, SubIndex dataSubIndex) const;
 };
 
 #endif // SLCANOPENNODE_H
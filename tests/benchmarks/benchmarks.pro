@@ -0,0 +1,7 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    covaluesholder \
+    covaluestable \
+    covaluetypes \
+    sequentialbuffer
@@ -0,0 +1,70 @@
+QT       += testlib serialport
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = tst_covaluesholder
+
+INCLUDEPATH += ../../.. \
+               ../../../CANopenNode/ \
+               ../../../slcan/
+
+SOURCES += \
+    ../../../CANopenNode/301/CO_Emergency.c \
+    ../../../CANopenNode/301/CO_HBconsumer.c \
+    ../../../CANopenNode/301/CO_NMT_Heartbeat.c \
+    ../../../CANopenNode/301/CO_Node_Guarding.c \
+    ../../../CANopenNode/301/CO_ODinterface.c \
+    ../../../CANopenNode/301/CO_PDO.c \
+    ../../../CANopenNode/301/CO_SDOclient.c \
+    ../../../CANopenNode/301/CO_SDOserver.c \
+    ../../../CANopenNode/301/CO_SYNC.c \
+    ../../../CANopenNode/301/CO_TIME.c \
+    ../../../CANopenNode/301/CO_fifo.c \
+    ../../../CANopenNode/301/crc16-ccitt.c \
+    ../../../CANopenNode/CANopen.c \
+    ../../../CO_driver_slcan_master.c \
+    ../../../canbusstats.cpp \
+    ../../../cantracebuffer.cpp \
+    ../../../coobjectdict.cpp \
+    ../../../covaluesholder.cpp \
+    ../../../covaluessnapshot.cpp \
+    ../../../covaluetypes.cpp \
+    ../../../pollbudget.cpp \
+    ../../../sdocache.cpp \
+    ../../../sdocomm.cpp \
+    ../../../sdoobserver.cpp \
+    ../../../sdovalue.cpp \
+    ../../../sdowritecoalescer.cpp \
+    ../../../slcan/slcan.c \
+    ../../../slcan/slcan_can_ext_fifo.c \
+    ../../../slcan/slcan_can_fifo.c \
+    ../../../slcan/slcan_can_msg.c \
+    ../../../slcan/slcan_cmd.c \
+    ../../../slcan/slcan_cmd_buf.c \
+    ../../../slcan/slcan_io_fifo.c \
+    ../../../slcan/slcan_master.c \
+    ../../../slcan/slcan_resp_out_fifo.c \
+    ../../../slcan/slcan_slave.c \
+    ../../../slcan_port_qt.cpp \
+    ../../../slcanopennode.cpp \
+    tst_covaluesholder.cpp
+
+HEADERS += \
+    ../../../canbusstats.h \
+    ../../../cantracebuffer.h \
+    ../../../coobjectdict.h \
+    ../../../covaluesholder.h \
+    ../../../covaluessnapshot.h \
+    ../../../covaluestable.h \
+    ../../../covaluetypes.h \
+    ../../../pollbudget.h \
+    ../../../sdocache.h \
+    ../../../sdocomm.h \
+    ../../../sdocomm_data.h \
+    ../../../sdoobserver.h \
+    ../../../sdovalue.h \
+    ../../../sdowritecoalescer.h \
+    ../../../slcan_port_qt.h \
+    ../../../slcanopennode.h
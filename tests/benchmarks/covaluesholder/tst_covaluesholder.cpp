@@ -0,0 +1,96 @@
+#include <QtTest>
+#include "covaluesholder.h"
+#include "slcanopennode.h"
+
+
+// values of the holder: 40 nodes, 64 objects of 4 subindices each (10240 values).
+static const int NODES_COUNT = 40;
+static const int OBJECTS_COUNT = 64;
+static const int SUBINDICES_COUNT = 4;
+
+
+class BenchCoValuesHolder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    // the link is not connected, the cycle walks the values and starts no reads.
+    void updateCycle();
+    void getSDOValue();
+    // the second holder of the value.
+    void addDelSdoValue();
+
+private:
+    SLCanOpenNode* m_slcon;
+    CoValuesHolder* m_holder;
+    QVector<CoValuesHolder::HoldedSDOValuePtr> m_values;
+};
+
+void BenchCoValuesHolder::initTestCase()
+{
+    m_slcon = new SLCanOpenNode();
+    m_holder = new CoValuesHolder(m_slcon);
+
+    for(int node = 1; node <= NODES_COUNT; node ++){
+        for(int obj = 0; obj < OBJECTS_COUNT; obj ++){
+            for(int sub = 0; sub < SUBINDICES_COUNT; sub ++){
+                auto sdoval = m_holder->addSdoValue(static_cast<CO::NodeId>(node), static_cast<CO::Index>(0x2000 + obj),
+                                                    static_cast<CO::SubIndex>(sub), 4);
+                QVERIFY(sdoval != nullptr);
+                m_values.append(sdoval);
+            }
+        }
+    }
+
+    QCOMPARE(m_holder->sdoValues().size(), NODES_COUNT * OBJECTS_COUNT * SUBINDICES_COUNT);
+}
+
+void BenchCoValuesHolder::cleanupTestCase()
+{
+    for(auto sdoval: qAsConst(m_values)){
+        m_holder->delSdoValue(sdoval);
+    }
+    m_values.clear();
+
+    delete m_holder;
+    delete m_slcon;
+}
+
+void BenchCoValuesHolder::updateCycle()
+{
+    QBENCHMARK {
+        m_holder->update();
+    }
+
+    QCOMPARE(m_holder->sdoValues().size(), m_values.size());
+}
+
+void BenchCoValuesHolder::getSDOValue()
+{
+    int found = 0;
+
+    QBENCHMARK {
+        for(auto sdoval: qAsConst(m_values)){
+            if(m_holder->getSDOValue(sdoval->nodeId(), sdoval->index(), sdoval->subIndex()) == sdoval) found ++;
+        }
+    }
+
+    QVERIFY(found >= m_values.size());
+}
+
+void BenchCoValuesHolder::addDelSdoValue()
+{
+    QBENCHMARK {
+        for(auto sdoval: qAsConst(m_values)){
+            m_holder->delSdoValue(m_holder->addSdoValue(sdoval->nodeId(), sdoval->index(), sdoval->subIndex(), 4));
+        }
+    }
+
+    QCOMPARE(m_holder->sdoValues().size(), m_values.size());
+}
+
+QTEST_GUILESS_MAIN(BenchCoValuesHolder)
+
+#include "tst_covaluesholder.moc"
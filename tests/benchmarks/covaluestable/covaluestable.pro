@@ -0,0 +1,15 @@
+QT       += testlib
+QT       -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = tst_covaluestable
+
+INCLUDEPATH += ../../..
+
+SOURCES += \
+    tst_covaluestable.cpp
+
+HEADERS += \
+    ../../../covaluestable.h
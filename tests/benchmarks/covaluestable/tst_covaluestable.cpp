@@ -0,0 +1,118 @@
+#include <QtTest>
+#include <QMap>
+#include <QPair>
+#include "covaluestable.h"
+
+
+// values of the holder: 40 nodes, 64 objects of 4 subindices each (10240 keys).
+static const int NODES_COUNT = 40;
+static const int OBJECTS_COUNT = 64;
+static const int SUBINDICES_COUNT = 4;
+
+typedef QPair<void*, size_t> Value;
+
+
+class BenchCoValuesTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    // the previous storage of the holder.
+    void findMap();
+    void findTable();
+    void iterateMap();
+    void iterateTable();
+    // bytes per entry, the table arrays vs the map nodes.
+    void memoryPerEntry();
+
+private:
+    QVector<quint32> m_keys;
+    QMap<quint32, Value> m_map;
+    CoValuesTable<Value> m_table;
+};
+
+void BenchCoValuesTable::initTestCase()
+{
+    for(quint32 node = 1; node <= NODES_COUNT; node ++){
+        for(quint32 obj = 0; obj < OBJECTS_COUNT; obj ++){
+            for(quint32 sub = 0; sub < SUBINDICES_COUNT; sub ++){
+                quint32 key = (node << 24) | ((0x2000 + obj) << 8) | sub;
+                m_keys.append(key);
+                m_map.insert(key, Value(nullptr, key));
+                m_table.insert(key, Value(nullptr, key));
+            }
+        }
+    }
+}
+
+void BenchCoValuesTable::findMap()
+{
+    size_t sum = 0;
+
+    QBENCHMARK {
+        for(auto key: qAsConst(m_keys)){
+            sum += m_map.constFind(key).value().second;
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void BenchCoValuesTable::findTable()
+{
+    size_t sum = 0;
+
+    QBENCHMARK {
+        for(auto key: qAsConst(m_keys)){
+            sum += m_table.value(m_table.find(key)).second;
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void BenchCoValuesTable::iterateMap()
+{
+    size_t sum = 0;
+
+    QBENCHMARK {
+        for(auto it = m_map.constBegin(); it != m_map.constEnd(); ++ it){
+            sum += it.value().second;
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void BenchCoValuesTable::iterateTable()
+{
+    size_t sum = 0;
+
+    QBENCHMARK {
+        for(int i = m_table.begin(); i != m_table.end(); i = m_table.next(i)){
+            sum += m_table.value(i).second;
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+void BenchCoValuesTable::memoryPerEntry()
+{
+    QCOMPARE(m_table.size(), m_keys.size());
+
+    qreal tableBytes = static_cast<qreal>(m_table.capacity()) *
+                       (sizeof(CoValuesTable<Value>::Key) + sizeof(Value)) / m_table.size();
+    // node of the map without the allocator overhead.
+    qreal mapBytes = sizeof(QMapNode<quint32, Value>);
+
+    qInfo("%d entries, capacity %d: table %.1f bytes per entry, map node %.1f bytes",
+          m_table.size(), m_table.capacity(), tableBytes, mapBytes);
+
+    QVERIFY(tableBytes < mapBytes);
+}
+
+QTEST_APPLESS_MAIN(BenchCoValuesTable)
+
+#include "tst_covaluestable.moc"
@@ -0,0 +1,117 @@
+#include <QtTest>
+#include <QVector>
+#include "covaluetypes.h"
+
+
+// samples of the waveform.
+static const int VALUES_COUNT = 4096;
+
+
+class BenchCOValueTypes : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    // the previous per value conversion.
+    void fromI16Scalar();
+    void fromI16Bulk();
+    void fromIQ24Scalar();
+    void fromIQ24Bulk();
+    void toI16Scalar();
+    void toI16Bulk();
+
+private:
+    QVector<qint16> m_i16;
+    QVector<qint32> m_iq24;
+    QVector<double> m_samples;
+    QVector<double> m_values;
+
+    void fromScalar(const void* data, COValue::Type type);
+    void fromBulk(const void* data, COValue::Type type);
+};
+
+void BenchCOValueTypes::initTestCase()
+{
+    m_i16.resize(VALUES_COUNT);
+    m_iq24.resize(VALUES_COUNT);
+    m_samples.resize(VALUES_COUNT);
+    m_values.resize(VALUES_COUNT);
+
+    for(int i = 0; i < VALUES_COUNT; i ++){
+        m_i16[i] = static_cast<qint16>(i * 7 - VALUES_COUNT);
+        m_iq24[i] = static_cast<qint32>(i * 4099 - VALUES_COUNT * 2048);
+        m_samples[i] = i * 0.5 - VALUES_COUNT;
+    }
+}
+
+void BenchCOValueTypes::fromI16Scalar()
+{
+    fromScalar(m_i16.constData(), COValue::I16);
+}
+
+void BenchCOValueTypes::fromI16Bulk()
+{
+    fromBulk(m_i16.constData(), COValue::I16);
+}
+
+void BenchCOValueTypes::fromIQ24Scalar()
+{
+    fromScalar(m_iq24.constData(), COValue::IQ24);
+}
+
+void BenchCOValueTypes::fromIQ24Bulk()
+{
+    fromBulk(m_iq24.constData(), COValue::IQ24);
+}
+
+void BenchCOValueTypes::toI16Scalar()
+{
+    QVector<qint16> data(VALUES_COUNT);
+    auto typeSize = COValue::typeSize(COValue::I16);
+
+    QBENCHMARK {
+        for(int i = 0; i < VALUES_COUNT; i ++){
+            COValue::valueTo<double>(reinterpret_cast<char*>(data.data()) + i * typeSize, COValue::I16, m_samples[i]);
+        }
+    }
+
+    QVERIFY(data[1] != data[0]);
+}
+
+void BenchCOValueTypes::toI16Bulk()
+{
+    QVector<qint16> data(VALUES_COUNT);
+
+    QBENCHMARK {
+        COValue::valuesTo(data.data(), COValue::I16, m_samples.constData(), VALUES_COUNT);
+    }
+
+    QVERIFY(data[1] != data[0]);
+}
+
+void BenchCOValueTypes::fromScalar(const void* data, COValue::Type type)
+{
+    auto typeSize = COValue::typeSize(type);
+
+    QBENCHMARK {
+        for(int i = 0; i < VALUES_COUNT; i ++){
+            m_values[i] = COValue::valueFrom<double>(static_cast<const char*>(data) + i * typeSize, type);
+        }
+    }
+
+    QVERIFY(m_values[1] != m_values[0]);
+}
+
+void BenchCOValueTypes::fromBulk(const void* data, COValue::Type type)
+{
+    QBENCHMARK {
+        COValue::valuesFrom(data, type, m_values.data(), VALUES_COUNT);
+    }
+
+    QVERIFY(m_values[1] != m_values[0]);
+}
+
+QTEST_APPLESS_MAIN(BenchCOValueTypes)
+
+#include "tst_covaluetypes.moc"
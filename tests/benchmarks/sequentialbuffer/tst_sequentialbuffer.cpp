@@ -0,0 +1,135 @@
+#include <QtTest>
+#include <QVector>
+#include <QPointF>
+#include <cmath>
+#include "sequentialbuffer.h"
+
+
+// samples of the full buffer.
+static const int BUFFER_SIZE = 1048576;
+// samples put per iteration.
+static const int PUT_COUNT = 64;
+
+
+class BenchSequentialBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    // the previous bounds update, all samples are rescanned on put.
+    void putRescan();
+    void putPoints();
+    void putCompact();
+    void getPoints();
+    void getCompact();
+
+private:
+    QVector<qreal> m_y;
+
+    void put(SequentialBuffer::StorageMode mode);
+    void get(SequentialBuffer::StorageMode mode);
+    void fill(SequentialBuffer& buf, SequentialBuffer::StorageMode mode);
+};
+
+void BenchSequentialBuffer::initTestCase()
+{
+    m_y.resize(BUFFER_SIZE);
+
+    for(int i = 0; i < BUFFER_SIZE; i ++){
+        m_y[i] = std::sin(i * 0.001) + (i * 7919 % 101) * 0.001;
+    }
+}
+
+void BenchSequentialBuffer::putRescan()
+{
+    QVector<QPointF> samples(BUFFER_SIZE);
+    for(int i = 0; i < BUFFER_SIZE; i ++) samples[i] = QPointF(i, m_y[i]);
+
+    int index = 0;
+    qreal bottom = 0.0;
+    qreal top = 0.0;
+
+    QBENCHMARK {
+        for(int k = 0; k < PUT_COUNT; k ++){
+            samples[index] = QPointF(index, m_y[(index * 31) % BUFFER_SIZE]);
+            if(++ index == BUFFER_SIZE) index = 0;
+
+            bottom = samples[0].y();
+            top = bottom;
+            for(int i = 1; i < BUFFER_SIZE; i ++){
+                qreal y = samples[i].y();
+                top = std::max(top, y);
+                bottom = std::min(bottom, y);
+            }
+        }
+    }
+
+    QVERIFY(top > bottom);
+}
+
+void BenchSequentialBuffer::putPoints()
+{
+    put(SequentialBuffer::POINTS);
+}
+
+void BenchSequentialBuffer::putCompact()
+{
+    put(SequentialBuffer::COMPACT);
+}
+
+void BenchSequentialBuffer::getPoints()
+{
+    get(SequentialBuffer::POINTS);
+}
+
+void BenchSequentialBuffer::getCompact()
+{
+    get(SequentialBuffer::COMPACT);
+}
+
+void BenchSequentialBuffer::put(SequentialBuffer::StorageMode mode)
+{
+    SequentialBuffer buf;
+    fill(buf, mode);
+
+    int index = 0;
+
+    QBENCHMARK {
+        for(int k = 0; k < PUT_COUNT; k ++){
+            buf.put(m_y[(index * 31) % BUFFER_SIZE]);
+            if(++ index == BUFFER_SIZE) index = 0;
+        }
+    }
+
+    QVERIFY(buf.boundingRect().height() > 0);
+}
+
+void BenchSequentialBuffer::get(SequentialBuffer::StorageMode mode)
+{
+    SequentialBuffer buf;
+    fill(buf, mode);
+
+    qreal sum = 0.0;
+
+    QBENCHMARK {
+        for(int i = 0; i < BUFFER_SIZE; i ++){
+            QPointF p = buf.get(static_cast<size_t>(i));
+            sum += p.x() + p.y();
+        }
+    }
+
+    QVERIFY(sum != 0.0);
+}
+
+void BenchSequentialBuffer::fill(SequentialBuffer& buf, SequentialBuffer::StorageMode mode)
+{
+    buf.setStorageMode(mode);
+    buf.setSize(BUFFER_SIZE);
+    buf.setSamplingPeriod(0.001);
+    buf.put(m_y.constData(), BUFFER_SIZE);
+}
+
+QTEST_APPLESS_MAIN(BenchSequentialBuffer)
+
+#include "tst_sequentialbuffer.moc"
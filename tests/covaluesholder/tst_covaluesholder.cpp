@@ -0,0 +1,195 @@
+#include <QtTest>
+#include "covaluesholder.h"
+#include "slcanopennode.h"
+
+
+// record 0x2000:01 of the node 5, 8 bytes.
+static const CO::NodeId NODE_ID = 5;
+static const CO::Index RECORD_INDEX = 0x2000;
+static const CO::SubIndex RECORD_SUBINDEX = 1;
+static const size_t RECORD_SIZE = 8;
+
+
+class TestCoValuesHolder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void compoundDemand();
+    void compoundDemandOfHeldFields();
+    void compoundFanOut();
+    void compoundRejectsBadFields();
+
+private:
+    QVector<CoValuesHolder::CompoundField> recordFields() const;
+};
+
+QVector<CoValuesHolder::CompoundField> TestCoValuesHolder::recordFields() const
+{
+    return {
+        {0x2001, 0, 0, COValue::U16},
+        {0x2002, 0, 2, COValue::I32},
+        {0x2003, 0, 6, COValue::U8},
+    };
+}
+
+void TestCoValuesHolder::compoundDemand()
+{
+    SLCanOpenNode slcon;
+    CoValuesHolder holder(&slcon);
+
+    QVERIFY(holder.addCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX, RECORD_SIZE, recordFields()));
+
+    auto record = holder.getSDOValue(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX);
+    QVERIFY(record != nullptr);
+
+    // the compound is demanded by the fields only.
+    QCOMPARE(holder.valueDemand(record), 0u);
+
+    auto a = holder.addSdoValue(NODE_ID, 0x2001, 0, 2);
+    auto b = holder.addSdoValue(NODE_ID, 0x2002, 0, 4);
+    QCOMPARE(holder.valueDemand(a), 1u);
+    QCOMPARE(holder.valueDemand(b), 1u);
+    QCOMPARE(holder.valueDemand(record), 2u);
+
+    // hidden consumer.
+    holder.releaseValueDemand(a);
+    QCOMPARE(holder.valueDemand(a), 0u);
+    QCOMPARE(holder.valueDemand(record), 1u);
+
+    holder.addValueDemand(a);
+    QCOMPARE(holder.valueDemand(record), 2u);
+
+    // the second holder of the field.
+    auto b2 = holder.addSdoValue(NODE_ID, 0x2002, 0, 4);
+    QCOMPARE(b2, b);
+    QCOMPARE(holder.valueDemand(record), 3u);
+
+    holder.delSdoValue(b2);
+    holder.delSdoValue(b);
+    QCOMPARE(holder.valueDemand(record), 1u);
+
+    // values out of the compound do not demand it.
+    auto other = holder.addSdoValue(NODE_ID, 0x2004, 0, 4);
+    QCOMPARE(holder.valueDemand(other), 1u);
+    QCOMPARE(holder.valueDemand(record), 1u);
+
+    holder.delSdoValue(a);
+    QCOMPARE(holder.valueDemand(record), 0u);
+
+    holder.delSdoValue(other);
+
+    QCOMPARE(holder.compoundReads().size(), 1);
+
+    holder.delCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX);
+    QVERIFY(holder.compoundReads().isEmpty());
+    QVERIFY(holder.getSDOValue(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX) == nullptr);
+}
+
+void TestCoValuesHolder::compoundDemandOfHeldFields()
+{
+    SLCanOpenNode slcon;
+    CoValuesHolder holder(&slcon);
+
+    auto a = holder.addSdoValue(NODE_ID, 0x2001, 0, 2);
+    auto c = holder.addSdoValue(NODE_ID, 0x2003, 0, 1);
+    holder.releaseValueDemand(c);
+
+    QVERIFY(holder.addCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX, RECORD_SIZE, recordFields()));
+
+    auto record = holder.getSDOValue(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX);
+
+    // only the demanded fields are counted.
+    QCOMPARE(holder.valueDemand(record), 1u);
+
+    holder.addValueDemand(c);
+    QCOMPARE(holder.valueDemand(record), 2u);
+
+    // the fields are left polled separately.
+    holder.delCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX);
+    QCOMPARE(holder.valueDemand(a), 1u);
+    QCOMPARE(holder.valueDemand(c), 1u);
+
+    holder.delSdoValue(a);
+    holder.delSdoValue(c);
+}
+
+void TestCoValuesHolder::compoundFanOut()
+{
+    SLCanOpenNode slcon;
+    CoValuesHolder holder(&slcon);
+
+    QVERIFY(holder.addCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX, RECORD_SIZE, recordFields()));
+
+    auto a = holder.addSdoValue(NODE_ID, 0x2001, 0, 2);
+    auto b = holder.addSdoValue(NODE_ID, 0x2002, 0, 4);
+    auto c = holder.addSdoValue(NODE_ID, 0x2003, 0, 1);
+    auto other = holder.addSdoValue(NODE_ID, 0x2004, 0, 4);
+
+    QVector<CoValuesHolder::UpdatedValues> batches;
+    connect(&holder, &CoValuesHolder::valuesUpdated, this, [&batches](const CoValuesHolder::UpdatedValues& values){
+        batches.append(values);
+    });
+
+    // little endian record: 0x1234, -2, 0x7f, padding.
+    const quint8 data[RECORD_SIZE] = {0x34, 0x12, 0xfe, 0xff, 0xff, 0xff, 0x7f, 0x00};
+
+    auto record = holder.getSDOValue(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX);
+    QVERIFY(const_cast<SDOValue*>(record)->updateData(data, sizeof(data)));
+
+    QCOMPARE(COValue::valueFrom<int>(a->data(), COValue::U16), 0x1234);
+    QCOMPARE(COValue::valueFrom<int>(b->data(), COValue::I32), -2);
+    QCOMPARE(COValue::valueFrom<int>(c->data(), COValue::U8), 0x7f);
+
+    // the record and the fields are published in one batch.
+    QTRY_COMPARE(batches.size(), 1);
+
+    const auto& values = batches.first();
+    QCOMPARE(values.size(), 4);
+    QVERIFY(values.contains(record));
+    QVERIFY(values.contains(a));
+    QVERIFY(values.contains(b));
+    QVERIFY(values.contains(c));
+    QVERIFY(!values.contains(other));
+
+    holder.delSdoValue(a);
+    holder.delSdoValue(b);
+    holder.delSdoValue(c);
+    holder.delSdoValue(other);
+    holder.delCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX);
+}
+
+void TestCoValuesHolder::compoundRejectsBadFields()
+{
+    SLCanOpenNode slcon;
+    CoValuesHolder holder(&slcon);
+
+    // field out of the record.
+    QVERIFY(!holder.addCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX, RECORD_SIZE,
+                                    {{0x2001, 0, 6, COValue::U32}}));
+    // the record itself.
+    QVERIFY(!holder.addCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX, RECORD_SIZE,
+                                    {{RECORD_INDEX, RECORD_SUBINDEX, 0, COValue::U8}}));
+    QVERIFY(!holder.addCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX, RECORD_SIZE, {}));
+    QVERIFY(holder.compoundReads().isEmpty());
+
+    QVERIFY(holder.addCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX, RECORD_SIZE, recordFields()));
+
+    // the field belongs to the other compound.
+    QVERIFY(!holder.addCompoundRead(NODE_ID, RECORD_INDEX, 2, RECORD_SIZE,
+                                    {{0x2001, 0, 0, COValue::U16}}));
+
+    auto reads = holder.compoundReads();
+    QCOMPARE(reads.size(), 1);
+    QCOMPARE(reads[0].nodeId, NODE_ID);
+    QCOMPARE(reads[0].index, RECORD_INDEX);
+    QCOMPARE(reads[0].subIndex, RECORD_SUBINDEX);
+    QCOMPARE(reads[0].dataSize, RECORD_SIZE);
+    QCOMPARE(reads[0].fields.size(), recordFields().size());
+
+    holder.delCompoundRead(NODE_ID, RECORD_INDEX, RECORD_SUBINDEX);
+}
+
+QTEST_GUILESS_MAIN(TestCoValuesHolder)
+
+#include "tst_covaluesholder.moc"
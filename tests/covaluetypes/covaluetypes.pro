@@ -0,0 +1,16 @@
+QT       += testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_covaluetypes
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../covaluetypes.cpp \
+    tst_covaluetypes.cpp
+
+HEADERS += \
+    ../../covaluetypes.h
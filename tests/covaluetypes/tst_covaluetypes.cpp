@@ -0,0 +1,180 @@
+#include <QtTest>
+#include <QVector>
+#include <QByteArray>
+#include <cmath>
+#include <string.h>
+#include "covaluetypes.h"
+
+
+// counts cover the vector kernels and the scalar tail.
+static const size_t COUNT_MAX = 9;
+// the arrays are converted at the unaligned offset too.
+static const int OFFSETS_COUNT = 2;
+// bytes after the array are not written.
+static const int GUARD_SIZE = 16;
+
+
+class TestCOValueTypes : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void valuesFromMatchesScalar();
+    void valuesToMatchesScalar();
+    void notConvertibleTypes();
+
+private:
+    QVector<COValue::Type> types() const;
+    // range of the values converted without the overflow.
+    void valuesRange(COValue::Type type, double* lo, double* hi) const;
+};
+
+void TestCOValueTypes::initTestCase()
+{
+#if defined(__AVX2__) && defined(Q_CC_GNU)
+    if(!__builtin_cpu_supports("avx2")) QSKIP("AVX2 is not supported by the CPU");
+#endif
+}
+
+QVector<COValue::Type> TestCOValueTypes::types() const
+{
+    QVector<COValue::Type> res;
+
+    for(int n = 0; n < COValue::TYPES_COUNT; n ++){
+        auto type = static_cast<COValue::Type>(n);
+        if(COValue::typeSize(type) != 0) res.append(type);
+    }
+
+    res.append(COValue::bitField(1, 3, 4));
+    res.append(COValue::bitField(2, 5, 7));
+    res.append(COValue::bitField(4, 0, 32));
+    res.append(COValue::bitField(4, 31, 1));
+
+    return res;
+}
+
+void TestCOValueTypes::valuesRange(COValue::Type type, double* lo, double* hi) const
+{
+    if(COValue::isBitField(type)){
+        *lo = 0.0;
+        *hi = std::ldexp(1.0, COValue::bitFieldWidth(type)) - 1.0;
+        return;
+    }
+
+    switch(type){
+    case COValue::I8: *lo = -128.0; *hi = 127.0; break;
+    case COValue::U8: *lo = 0.0; *hi = 255.0; break;
+    case COValue::I16: *lo = -32768.0; *hi = 32767.0; break;
+    case COValue::U16: *lo = 0.0; *hi = 65535.0; break;
+    case COValue::I32: *lo = -2147483648.0; *hi = 2147483647.0; break;
+    case COValue::U32: *lo = 0.0; *hi = 4294967295.0; break;
+    case COValue::IQ24: *lo = -128.0; *hi = 127.0; break;
+    case COValue::IQ15: *lo = -65536.0; *hi = 65535.0; break;
+    case COValue::IQ7: *lo = -16777216.0; *hi = 16777215.0; break;
+    case COValue::I64: *lo = -std::ldexp(1.0, 53); *hi = std::ldexp(1.0, 53); break;
+    case COValue::U64: *lo = 0.0; *hi = std::ldexp(1.0, 53); break;
+    default: *lo = -1.0e6; *hi = 1.0e6; break;
+    }
+}
+
+void TestCOValueTypes::valuesFromMatchesScalar()
+{
+    for(auto type: types()){
+        size_t size = COValue::typeSize(type);
+
+        for(int offset = 0; offset < OFFSETS_COUNT; offset ++){
+            for(size_t count = 0; count <= COUNT_MAX; count ++){
+                // pseudo random raw values, NaNs of the floating point types included.
+                QByteArray data(static_cast<int>(offset + count * size), 0);
+                quint32 seed = static_cast<quint32>(type) * 2654435761U + static_cast<quint32>(count);
+                for(int i = 0; i < data.size(); i ++){
+                    seed = seed * 1664525U + 1013904223U;
+                    data[i] = static_cast<char>(seed >> 24);
+                }
+                const char* src = data.constData() + offset;
+
+                QVector<double> values(static_cast<int>(count) + GUARD_SIZE, -1.0);
+
+                QVERIFY(COValue::valuesFrom(src, type, values.data(), count));
+
+                for(size_t i = 0; i < count; i ++){
+                    double expected = COValue::valueFrom<double>(src + i * size, type);
+                    double actual = values[static_cast<int>(i)];
+
+                    if(std::isnan(expected)){
+                        QVERIFY2(std::isnan(actual), qPrintable(QString("type 0x%1, count %2, value %3")
+                                                                .arg(type, 0, 16).arg(count).arg(i)));
+                    }else{
+                        QVERIFY2(actual == expected, qPrintable(QString("type 0x%1, count %2, value %3: %4 != %5")
+                                                                .arg(type, 0, 16).arg(count).arg(i).arg(actual).arg(expected)));
+                    }
+                }
+
+                for(int i = static_cast<int>(count); i < values.size(); i ++){
+                    QCOMPARE(values[i], -1.0);
+                }
+            }
+        }
+    }
+}
+
+void TestCOValueTypes::valuesToMatchesScalar()
+{
+    for(auto type: types()){
+        size_t size = COValue::typeSize(type);
+
+        double lo = 0.0;
+        double hi = 0.0;
+        valuesRange(type, &lo, &hi);
+
+        for(int offset = 0; offset < OFFSETS_COUNT; offset ++){
+            for(size_t count = 0; count <= COUNT_MAX; count ++){
+                QVector<double> values(static_cast<int>(count));
+                for(size_t i = 0; i < count; i ++){
+                    // fractional values are truncated.
+                    double frac = std::fmod((i + 1) * 0.6180339887 + count * 0.1, 1.0);
+                    values[static_cast<int>(i)] = lo + (hi - lo) * frac;
+                }
+
+                // the other bits of the bit fields are kept.
+                QByteArray expected(static_cast<int>(offset + count * size) + GUARD_SIZE, '\xa5');
+                QByteArray actual(expected);
+
+                QVERIFY(COValue::valuesTo(actual.data() + offset, type, values.constData(), count));
+
+                for(size_t i = 0; i < count; i ++){
+                    QVERIFY(COValue::valueTo<double>(expected.data() + offset + i * size, type, values[static_cast<int>(i)]));
+                }
+
+                QVERIFY2(actual == expected, qPrintable(QString("type 0x%1, count %2, offset %3: %4 != %5")
+                                                        .arg(type, 0, 16).arg(count).arg(offset)
+                                                        .arg(QString(actual.toHex())).arg(QString(expected.toHex()))));
+            }
+        }
+    }
+}
+
+void TestCOValueTypes::notConvertibleTypes()
+{
+    quint8 data[8] = {0};
+    double values[1] = {0.0};
+
+    QVERIFY(!COValue::valuesFrom(data, COValue::STR, values, 1));
+    QVERIFY(!COValue::valuesFrom(data, COValue::MEM, values, 1));
+    QVERIFY(!COValue::valuesTo(data, COValue::STR, values, 1));
+    QVERIFY(!COValue::valuesTo(data, COValue::MEM, values, 1));
+
+    // the field does not fit the byte.
+    auto bad = static_cast<COValue::Type>(COValue::BITFIELD | (7 << 5) | 4);
+    QVERIFY(!COValue::isValid(bad));
+    QVERIFY(!COValue::valuesFrom(data, bad, values, 1));
+    QVERIFY(!COValue::valuesTo(data, bad, values, 1));
+
+    // nothing to convert.
+    QVERIFY(COValue::valuesFrom(data, COValue::STR, values, 0));
+}
+
+QTEST_APPLESS_MAIN(TestCOValueTypes)
+
+#include "tst_covaluetypes.moc"
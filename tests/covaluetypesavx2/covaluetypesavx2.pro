@@ -0,0 +1,23 @@
+QT       += testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_covaluetypesavx2
+
+# the AVX2 kernels of the conversions, skipped on the CPUs without AVX2.
+msvc {
+    QMAKE_CXXFLAGS += /arch:AVX2
+} else {
+    QMAKE_CXXFLAGS += -mavx2
+}
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../covaluetypes.cpp \
+    ../covaluetypes/tst_covaluetypes.cpp
+
+HEADERS += \
+    ../../covaluetypes.h
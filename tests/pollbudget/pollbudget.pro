@@ -0,0 +1,18 @@
+QT       += testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_pollbudget
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../canbusstats.cpp \
+    ../../pollbudget.cpp \
+    tst_pollbudget.cpp
+
+HEADERS += \
+    ../../canbusstats.h \
+    ../../pollbudget.h
@@ -0,0 +1,109 @@
+#include <QtTest>
+#include "pollbudget.h"
+
+
+// 125 kbit/s bus, 10 ms update interval.
+static const qreal BUS_BITS_PER_SEC = 125000;
+static const qreal INTERVAL = 0.01;
+static const qreal INTERVAL_BITS = BUS_BITS_PER_SEC * INTERVAL;
+static const qreal TARGET = 0.8;
+
+
+class TestPollBudget : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void smallReadFits();
+    void capDoesNotDependOnElapsed();
+    void largeReadStartsOnFullCredit();
+    void fastAndLargeValues();
+};
+
+void TestPollBudget::smallReadFits()
+{
+    PollBudget budget;
+    qreal cost = PollBudget::sdoUploadCost(4, false).busBits;
+
+    QVERIFY(!budget.fits(cost));
+
+    budget.refill(TARGET, 0.0, INTERVAL_BITS, INTERVAL_BITS);
+    QVERIFY(budget.fits(cost));
+
+    budget.spend(cost);
+    QCOMPARE(budget.credit(), TARGET * INTERVAL_BITS - cost);
+}
+
+void TestPollBudget::capDoesNotDependOnElapsed()
+{
+    PollBudget budget;
+
+    // short tick.
+    budget.refill(TARGET, 0.0, INTERVAL_BITS / 10, INTERVAL_BITS);
+    QCOMPARE(budget.maxCredit(), TARGET * INTERVAL_BITS * 2);
+
+    // long tick.
+    budget.refill(TARGET, 0.0, INTERVAL_BITS * 2, INTERVAL_BITS);
+    QCOMPARE(budget.maxCredit(), TARGET * INTERVAL_BITS * 2);
+    QCOMPARE(budget.credit(), budget.maxCredit());
+}
+
+void TestPollBudget::largeReadStartsOnFullCredit()
+{
+    PollBudget budget;
+    qreal cost = PollBudget::sdoUploadCost(1024, false).busBits;
+
+    budget.refill(TARGET, 0.0, INTERVAL_BITS, INTERVAL_BITS);
+    QVERIFY(cost > budget.maxCredit());
+    QVERIFY(!budget.fits(cost));
+
+    budget.refill(TARGET, 0.0, INTERVAL_BITS, INTERVAL_BITS);
+    QVERIFY(budget.fits(cost));
+
+    // the debt is repaid before the next read.
+    budget.spend(cost);
+    QVERIFY(budget.credit() < 0.0);
+    budget.refill(TARGET, 0.0, INTERVAL_BITS, INTERVAL_BITS);
+    QVERIFY(!budget.fits(PollBudget::sdoUploadCost(4, false).busBits));
+}
+
+void TestPollBudget::fastAndLargeValues()
+{
+    PollBudget budget;
+    qreal fastCost = PollBudget::sdoUploadCost(4, false).busBits;
+    qreal largeCost = PollBudget::sdoUploadCost(1024, false).busBits;
+
+    const int ticks = 1000;
+    int fastReads = 0;
+    int largeReads = 0;
+    qreal spent = 0.0;
+
+    for(int tick = 0; tick < ticks; tick ++){
+        budget.refill(TARGET, 0.0, INTERVAL_BITS, INTERVAL_BITS);
+
+        // 20 ms value.
+        if(tick % 2 == 0 && budget.fits(fastCost)){
+            budget.spend(fastCost);
+            spent += fastCost;
+            fastReads ++;
+        }
+
+        // 1 KB value polled as fast as possible.
+        if(budget.fits(largeCost)){
+            budget.spend(largeCost);
+            spent += largeCost;
+            largeReads ++;
+        }
+    }
+
+    QVERIFY(fastReads > 0);
+    QVERIFY(largeReads > 0);
+
+    // the target is held with the one large read of the debt.
+    QVERIFY(spent <= TARGET * INTERVAL_BITS * (ticks + 2) + largeCost);
+    QVERIFY(spent >= TARGET * INTERVAL_BITS * ticks - largeCost);
+}
+
+QTEST_APPLESS_MAIN(TestPollBudget)
+
+#include "tst_pollbudget.moc"
@@ -0,0 +1,16 @@
+QT       += testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_sdoobserver
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../sdoobserver.cpp \
+    tst_sdoobserver.cpp
+
+HEADERS += \
+    ../../sdoobserver.h
@@ -0,0 +1,98 @@
+#include <QtTest>
+#include "sdoobserver.h"
+
+
+// frames of the other master and the node 5.
+static const quint16 REQUEST_ID = 0x605;
+static const quint16 RESPONSE_ID = 0x585;
+
+
+class TestSDOObserver : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void expeditedUpload();
+    void expeditedDownload();
+    void downloadAbort();
+    void responseWithoutRequest();
+    void swappedDirections();
+};
+
+void TestSDOObserver::expeditedUpload()
+{
+    SDOObserver obs;
+
+    // upload 0x1000:00 (device type), 4 bytes.
+    const quint8 req[8] = {0x40, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const quint8 resp[8] = {0x43, 0x00, 0x10, 0x00, 0x92, 0x01, 0x02, 0x00};
+
+    QVERIFY(!obs.put(REQUEST_ID, 8, req));
+    QVERIFY(obs.put(RESPONSE_ID, 8, resp));
+
+    auto values = obs.takeValues();
+    QCOMPARE(values.size(), 1);
+    QCOMPARE(values[0].nodeId, static_cast<CO::NodeId>(5));
+    QCOMPARE(values[0].index, static_cast<CO::Index>(0x1000));
+    QCOMPARE(values[0].subIndex, static_cast<CO::SubIndex>(0));
+    QCOMPARE(values[0].data, QByteArray("\x92\x01\x02\x00", 4));
+
+    QVERIFY(!obs.hasValues());
+}
+
+void TestSDOObserver::expeditedDownload()
+{
+    SDOObserver obs;
+
+    // download 0x6040:00 (control word) = 0x000f, 2 bytes.
+    const quint8 req[8] = {0x2b, 0x40, 0x60, 0x00, 0x0f, 0x00, 0x00, 0x00};
+    const quint8 resp[8] = {0x60, 0x40, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    QVERIFY(!obs.put(REQUEST_ID, 8, req));
+    QVERIFY(!obs.hasValues());
+    QVERIFY(obs.put(RESPONSE_ID, 8, resp));
+
+    auto values = obs.takeValues();
+    QCOMPARE(values.size(), 1);
+    QCOMPARE(values[0].index, static_cast<CO::Index>(0x6040));
+    QCOMPARE(values[0].data, QByteArray("\x0f\x00", 2));
+}
+
+void TestSDOObserver::downloadAbort()
+{
+    SDOObserver obs;
+
+    const quint8 req[8] = {0x2b, 0x40, 0x60, 0x00, 0x0f, 0x00, 0x00, 0x00};
+    const quint8 abort[8] = {0x80, 0x40, 0x60, 0x00, 0x00, 0x00, 0x02, 0x06};
+    const quint8 resp[8] = {0x60, 0x40, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    obs.put(REQUEST_ID, 8, req);
+    QVERIFY(!obs.put(RESPONSE_ID, 8, abort));
+    QVERIFY(!obs.put(RESPONSE_ID, 8, resp));
+    QVERIFY(!obs.hasValues());
+}
+
+void TestSDOObserver::responseWithoutRequest()
+{
+    SDOObserver obs;
+
+    const quint8 resp[8] = {0x60, 0x40, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    QVERIFY(!obs.put(RESPONSE_ID, 8, resp));
+    QVERIFY(!obs.hasValues());
+}
+
+void TestSDOObserver::swappedDirections()
+{
+    SDOObserver obs;
+
+    // upload response data sent to the server is not a value.
+    const quint8 resp[8] = {0x43, 0x00, 0x10, 0x00, 0x92, 0x01, 0x02, 0x00};
+
+    QVERIFY(!obs.put(REQUEST_ID, 8, resp));
+    QVERIFY(!obs.hasValues());
+}
+
+QTEST_APPLESS_MAIN(TestSDOObserver)
+
+#include "tst_sdoobserver.moc"
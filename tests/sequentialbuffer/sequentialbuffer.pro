@@ -0,0 +1,16 @@
+QT       += testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_sequentialbuffer
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    ../../sequentialbuffer.cpp \
+    tst_sequentialbuffer.cpp
+
+HEADERS += \
+    ../../sequentialbuffer.h
@@ -0,0 +1,212 @@
+#include <QtTest>
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <algorithm>
+#include <cmath>
+#include "sequentialbuffer.h"
+
+
+// the vertical bounds are scaled up by the buffer.
+static const qreal TOP_SCALE = 0.1;
+static const qreal PERIOD = 0.01;
+// buffer sizes, not multiples of the extremums blocks too.
+static const int SIZES[] = {17, 1000, 4096};
+// samples put, the buffer wraps around several times.
+static const int WRAPS = 3;
+// samples put at once.
+static const int CHUNK_SIZE = 37;
+// ranges of extremums() checked per put.
+static const int RANGES_COUNT = 8;
+
+
+class TestSequentialBuffer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void circularBounds();
+    void linearBounds();
+    void circularBulkBounds();
+    void linearBulkBounds();
+    void compactMatchesPoints();
+
+private:
+    // ties and monotonic runs for the extremums queues.
+    qreal sample(int k) const;
+    qreal sampleDx(int k) const;
+    void checkBounds(SequentialBuffer::AddressingMode addrMode, bool bulk);
+    // bounds & extremums vs the rescan of all the samples.
+    bool boundsMatchRescan(const SequentialBuffer& buf, quint32* seed, QString* error) const;
+};
+
+qreal TestSequentialBuffer::sample(int k) const
+{
+    // float values are stored by the compact buffer exactly,
+    // the saw tooth trend moves the extremums out of the window.
+    float trend = static_cast<float>((k / 64) % 32) * 8.0f;
+
+    switch((k / 97) % 3){
+    case 0: return trend + static_cast<float>((k * 7919 % 211) - 100) * 0.5f;
+    case 1: return trend + static_cast<float>(k % 97) * 0.25f;
+    default: return trend + static_cast<float>(97 - k % 97) * 0.25f;
+    }
+}
+
+qreal TestSequentialBuffer::sampleDx(int k) const
+{
+    // rare gaps of the sampling.
+    return (k % 251 == 0) ? PERIOD * 3 : PERIOD;
+}
+
+bool TestSequentialBuffer::boundsMatchRescan(const SequentialBuffer& buf, quint32* seed, QString* error) const
+{
+    size_t count = buf.avail();
+
+    qreal bottom = buf.get(0).y();
+    qreal top = bottom;
+    for(size_t i = 1; i < count; i ++){
+        qreal y = buf.get(i).y();
+        bottom = std::min(bottom, y);
+        top = std::max(top, y);
+    }
+    top = top + (top - bottom) * TOP_SCALE;
+
+    const QRectF& br = buf.boundingRect();
+
+    if(br.top() != bottom || br.bottom() != top){
+        *error = QString("bounds %1..%2, rescan %3..%4").arg(br.top()).arg(br.bottom()).arg(bottom).arg(top);
+        return false;
+    }
+
+    for(int r = 0; r < RANGES_COUNT; r ++){
+        *seed = *seed * 1664525U + 1013904223U;
+        size_t from = (*seed >> 8) % count;
+        *seed = *seed * 1664525U + 1013904223U;
+        size_t to = from + 1 + (*seed >> 8) % (count - from);
+
+        qreal minY = buf.get(from).y();
+        qreal maxY = minY;
+        for(size_t i = from + 1; i < to; i ++){
+            qreal y = buf.get(i).y();
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+
+        size_t minI = 0;
+        size_t maxI = 0;
+        if(!buf.extremums(from, to, &minI, &maxI) ||
+           minI < from || minI >= to || maxI < from || maxI >= to ||
+           buf.get(minI).y() != minY || buf.get(maxI).y() != maxY){
+            *error = QString("extremums [%1, %2): %3 %4, rescan %5 %6")
+                    .arg(from).arg(to).arg(minI).arg(maxI).arg(minY).arg(maxY);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TestSequentialBuffer::checkBounds(SequentialBuffer::AddressingMode addrMode, bool bulk)
+{
+    for(auto storage: {SequentialBuffer::POINTS, SequentialBuffer::COMPACT}){
+        for(int size: SIZES){
+            SequentialBuffer buf;
+            buf.setStorageMode(storage);
+            buf.setAddressingMode(addrMode);
+            buf.setSize(static_cast<size_t>(size));
+            buf.setSamplingPeriod(PERIOD);
+
+            quint32 seed = static_cast<quint32>(size);
+            QString error;
+
+            QVector<qreal> chunk;
+            int total = size * WRAPS + size / 2;
+            int k = 0;
+
+            while(k < total){
+                if(bulk){
+                    int n = std::min(CHUNK_SIZE, total - k);
+                    chunk.resize(n);
+                    for(int i = 0; i < n; i ++) chunk[i] = sample(k + i);
+                    buf.put(chunk.constData(), static_cast<size_t>(n), PERIOD);
+                    k += n;
+                }else{
+                    buf.put(sample(k), sampleDx(k));
+                    k ++;
+                }
+
+                // the bounds are maintained after the wrap around.
+                if(k <= size) continue;
+
+                QVERIFY2(boundsMatchRescan(buf, &seed, &error),
+                         qPrintable(QString("storage %1, size %2, put %3: %4").arg(storage).arg(size).arg(k).arg(error)));
+            }
+        }
+    }
+}
+
+void TestSequentialBuffer::circularBounds()
+{
+    checkBounds(SequentialBuffer::CIRCULAR, false);
+}
+
+void TestSequentialBuffer::linearBounds()
+{
+    checkBounds(SequentialBuffer::LINEAR, false);
+}
+
+void TestSequentialBuffer::circularBulkBounds()
+{
+    checkBounds(SequentialBuffer::CIRCULAR, true);
+}
+
+void TestSequentialBuffer::linearBulkBounds()
+{
+    checkBounds(SequentialBuffer::LINEAR, true);
+}
+
+void TestSequentialBuffer::compactMatchesPoints()
+{
+    for(auto addrMode: {SequentialBuffer::CIRCULAR, SequentialBuffer::LINEAR}){
+        for(int size: SIZES){
+            SequentialBuffer points;
+            SequentialBuffer compact;
+
+            for(auto buf: {&points, &compact}){
+                buf->setAddressingMode(addrMode);
+                buf->setSize(static_cast<size_t>(size));
+                buf->setSamplingPeriod(PERIOD);
+            }
+            compact.setStorageMode(SequentialBuffer::COMPACT);
+
+            int total = size * WRAPS + size / 2;
+
+            for(int k = 0; k < total; k ++){
+                points.put(sample(k), sampleDx(k));
+                compact.put(sample(k), sampleDx(k));
+
+                const QRectF& pbr = points.boundingRect();
+                const QRectF& cbr = compact.boundingRect();
+
+                QCOMPARE(compact.avail(), points.avail());
+                QCOMPARE(cbr.top(), pbr.top());
+                QCOMPARE(cbr.bottom(), pbr.bottom());
+
+                // X of the compact samples is restored from the period & time anchors.
+                qreal tolerance = PERIOD * 1e-6;
+                QVERIFY(std::abs(cbr.left() - pbr.left()) <= tolerance);
+                QVERIFY(std::abs(cbr.right() - pbr.right()) <= tolerance);
+            }
+
+            for(size_t i = 0; i < points.avail(); i ++){
+                QCOMPARE(compact.get(i).y(), points.get(i).y());
+                QVERIFY(std::abs(compact.get(i).x() - points.get(i).x()) <= PERIOD * 1e-6);
+            }
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestSequentialBuffer)
+
+#include "tst_sequentialbuffer.moc"
@@ -0,0 +1,12 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    benchmarks \
+    covaluesholder \
+    covaluetypes \
+    pollbudget \
+    sdoobserver \
+    sequentialbuffer
+
+# the conversions test built with the AVX2 kernels.
+contains(QT_ARCH, x86_64)|contains(QT_ARCH, i386): SUBDIRS += covaluetypesavx2
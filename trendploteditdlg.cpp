@@ -92,6 +92,9 @@ void TrendPlotEditDlg::on_pbAdd_clicked(bool checked)
         p.index = d->index();
         p.subIndex = d->subIndex();
         p.type = d->type();
+        p.samples = d->samples();
+        p.samplePeriod = d->samplePeriod();
+        p.pollPeriod = d->pollPeriod();
         p.penColor = d->penColor();
         p.penStyle = d->penStyle();
         p.penWidth = d->penWidth();
@@ -119,6 +122,9 @@ void TrendPlotEditDlg::on_pbEdit_clicked(bool checked)
     d->setIndex(p.index);
     d->setSubIndex(p.subIndex);
     d->setType(p.type);
+    d->setSamples(p.samples);
+    d->setSamplePeriod(p.samplePeriod);
+    d->setPollPeriod(p.pollPeriod);
     d->setPenColor(p.penColor);
     d->setPenStyle(p.penStyle);
     d->setPenWidth(p.penWidth);
@@ -132,6 +138,9 @@ void TrendPlotEditDlg::on_pbEdit_clicked(bool checked)
         p.index = d->index();
         p.subIndex = d->subIndex();
         p.type = d->type();
+        p.samples = d->samples();
+        p.samplePeriod = d->samplePeriod();
+        p.pollPeriod = d->pollPeriod();
         p.penColor = d->penColor();
         p.penStyle = d->penStyle();
         p.penWidth = d->penWidth();
@@ -183,6 +192,16 @@ void TrendPlotEditDlg::setLegendEnabled(bool newLegendEnabled)
     ui->cbLegendEnabled->setChecked(newLegendEnabled);
 }
 
+bool TrendPlotEditDlg::compactStorage() const
+{
+    return ui->cbCompactStorage->isChecked();
+}
+
+void TrendPlotEditDlg::setCompactStorage(bool newCompactStorage)
+{
+    ui->cbCompactStorage->setChecked(newCompactStorage);
+}
+
 SignalCurveEditDlg* TrendPlotEditDlg::signalCurveEditDialog() const
 {
     return m_signalCurveEditDlg;
@@ -60,6 +60,9 @@ public:
     bool legendEnabled() const;
     void setLegendEnabled(bool newLegendEnabled);
 
+    bool compactStorage() const;
+    void setCompactStorage(bool newCompactStorage);
+
 private slots:
     void on_slTransp_valueChanged(int value);
     void on_tbColorSel_clicked(bool checked = false);